@@ -0,0 +1,40 @@
+#include "Bounds.h"
+#include <algorithm>
+
+namespace Charis {
+
+    void BoundingBox::Add(const glm::vec3& point)
+    {
+        Min = glm::min(Min, point);
+        Max = glm::max(Max, point);
+    }
+
+    void BoundingBox::Add(const BoundingBox& box)
+    {
+        Min = glm::min(Min, box.Min);
+        Max = glm::max(Max, box.Max);
+    }
+
+    BoundingBox BoundingBox::Transformed(const glm::mat4& transform) const
+    {
+        if (IsEmpty())
+            return {};
+
+        // The extents along each world axis are the extents along the box axes weighted by the absolute rotation and scale
+        const auto center = glm::vec3(transform * glm::vec4(Center(), 1.0f));
+        const auto linear = glm::mat3(transform);
+        const auto absolute = glm::mat3(glm::abs(linear[0]), glm::abs(linear[1]), glm::abs(linear[2]));
+        const auto extents = absolute * Extents();
+        return { center - extents, center + extents };
+    }
+
+    BoundingSphere BoundingSphere::Transformed(const glm::mat4& transform) const
+    {
+        if (Radius < 0.0f)
+            return {};
+
+        const auto scale = std::max({ glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])) });
+        return { glm::vec3(transform * glm::vec4(Center, 1.0f)), Radius * scale };
+    }
+
+}
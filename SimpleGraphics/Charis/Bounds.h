@@ -0,0 +1,36 @@
+#pragma once
+#include <limits>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	/// <summary>An axis aligned bounding box. An empty box has Min larger than Max.</summary>
+	struct BoundingBox {
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+		glm::vec3 Center() const { return 0.5f * (Min + Max); }
+		/// <summary>Half the size of the box along each axis.</summary>
+		glm::vec3 Extents() const { return 0.5f * (Max - Min); }
+		bool IsEmpty() const { return Min.x > Max.x || Min.y > Max.y || Min.z > Max.z; }
+
+		/// <summary>Grows the box to contain a point.</summary>
+		void Add(const glm::vec3& point);
+		/// <summary>Grows the box to contain another box.</summary>
+		void Add(const BoundingBox& box);
+		/// <summary>Returns the axis aligned box around this box after a transform, which is larger than the box itself if the transform rotates.</summary>
+		BoundingBox Transformed(const glm::mat4& transform) const;
+	};
+
+	/// <summary>A bounding sphere. A negative radius means the sphere is empty.</summary>
+	struct BoundingSphere {
+		glm::vec3 Center{};
+		float Radius = -1.0f;
+
+		/// <summary>Returns the sphere around this sphere after a transform, scaled by the largest scale of the transform.</summary>
+		BoundingSphere Transformed(const glm::mat4& transform) const;
+	};
+
+}
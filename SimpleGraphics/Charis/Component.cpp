@@ -1,103 +1,363 @@
-#include "Component.h"
-#include "Utility.h"
-#include <numeric>
-
-// Libraries
-#include <glad/glad.h>
-
-static unsigned int sum(const std::vector<unsigned int>& numbers) {
-	return std::reduce(numbers.begin(), numbers.end());
-}
-
-struct VertexInfo { unsigned int VAO; unsigned int VBO; unsigned int numberOfVertices; };
-static VertexInfo SetAttributesAndVertices(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex) 
-{
-	VertexInfo vertInfo{};
-	vertInfo.numberOfVertices = numberOfVertexAttributes;
-
-	// Create and bind vertex attribute object
-	glGenVertexArrays(1, &vertInfo.VAO);
-	glBindVertexArray(vertInfo.VAO);
-	
-	//Create and set vertex buffer object
-	glGenBuffers(1, &vertInfo.VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, vertInfo.VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertexAttributes, vertexAttributes, GL_STATIC_DRAW);
-	
-	// Set vertex attributes
-	int offset = 0;
-	int attribute = 0;
-	for (auto floatsInAttribute : floatsPerAttributePerVertex) {
-		const auto stride = sizeof(float) * sum(floatsPerAttributePerVertex);
-		glVertexAttribPointer(attribute, floatsInAttribute, GL_FLOAT, GL_FALSE, stride, (void*)(offset * sizeof(float)));
-		glEnableVertexAttribArray(attribute);
-		offset += floatsInAttribute;
-		attribute++;
-	}
-
-	return vertInfo;
-}
-
-namespace Charis {
-
-	Component::Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex)
-	{
-		Helper::RuntimeAssert(!floatsPerAttributePerVertex.empty(), "Must provide attribute float sizes.");
-		Helper::RuntimeAssert(numberOfVertexAttributes >= 3, "Must provide at least 3 vertices to model.");
-		Helper::RuntimeAssert(numberOfVertexAttributes % 3 == 0, "Number of vertices must be multiple of 3.");
-
-		// Set attributes and vertex buffers
-		auto vertInfo = SetAttributesAndVertices(vertexAttributes, numberOfVertexAttributes, floatsPerAttributePerVertex);
-		m->VAO = vertInfo.VAO;
-		m->NumberOfVertices = vertInfo.numberOfVertices;
-		m->VBO = vertInfo.VBO;
-
-		// Set up index/element buffer
-		m->UsingIBO = false;
-		m->NumberOfIndices = 0;
-		m->IBO = -1;
-	}
-	Component::Component(const std::vector<float>& vertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex) 
-		: Component(vertexAttributes.data(), vertexAttributes.size(), floatsPerAttributePerVertex)
-	{}
-
-	Component::Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const unsigned int* indices, unsigned int numberOfIndices, const std::vector<unsigned int>& floatsPerAttributePerVertex)
-	{
-		Helper::RuntimeAssert(!floatsPerAttributePerVertex.empty(), "Must provide attribute float sizes.");
-		Helper::RuntimeAssert(numberOfIndices >= 3, "Must provide at least 3 vertices to model.");
-		Helper::RuntimeAssert(numberOfIndices % 3 == 0, "Number of vertices must be multiple of 3.");
-
-		// Set attributes and vertex buffer
-		auto vertInfo = SetAttributesAndVertices(vertexAttributes, numberOfVertexAttributes, floatsPerAttributePerVertex);
-		m->VAO = vertInfo.VAO;
-		m->NumberOfVertices = vertInfo.numberOfVertices;
-		m->VBO = vertInfo.VBO;
-
-		// Set up index/element buffer
-		m->UsingIBO = true;
-		m->NumberOfIndices = numberOfIndices;
-		glGenBuffers(1, &m->IBO);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m->IBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(float) * numberOfIndices, indices, GL_STATIC_DRAW);
-
-	}
-
-	Component::Component(const std::vector<float>& vertexAttributes, const std::vector<TriangleIndices>& indexTriangles, const std::vector<unsigned int>& floatsPerAttributePerVertex)
-		: Component(vertexAttributes.data(), vertexAttributes.size(), reinterpret_cast<const unsigned int*>(indexTriangles.data()), 3 * indexTriangles.size(), floatsPerAttributePerVertex)
-	{
-		static_assert(sizeof(TriangleIndices) == 3 * sizeof(float));
-	}
-
-	Component::~Component()
-	{
-		if (m.use_count() > 1)
-			return;
-
-		glDeleteVertexArrays(1, &m->VAO);
-		glDeleteBuffers(1, &m->VBO);
-
-		if (m->UsingIBO) 
-			glDeleteBuffers(1, &m->IBO);
-	}
-
+#include "Component.h"
+#include "GeometryArena.h"
+#include "StreamBuffer.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Libraries
+#include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// Component buffers are never written again, so they get immutable storage when the driver supports it.
+static void StaticBufferData(GLenum target, GLsizeiptr size, const void* data)
+{
+	if (Charis::PrivateGL::BufferStorage != nullptr)
+		Charis::PrivateGL::BufferStorage(target, size, data, 0);
+	else
+		glBufferData(target, size, data, GL_STATIC_DRAW);
+	Charis::PrivateGlobal::Statistics::CountUpload(size);
+}
+
+struct AttributeFormat { GLenum Type; unsigned int Bytes; bool Integer; };
+static AttributeFormat FormatOf(const Charis::VertexAttribute& attribute)
+{
+	using Type = Charis::VertexAttribute::ComponentType;
+	AttributeFormat format{};
+	switch (attribute.Type) {
+	case Type::Float:         format = { GL_FLOAT, 4, false }; break;
+	case Type::HalfFloat:     format = { GL_HALF_FLOAT, 2, false }; break;
+	case Type::Byte:          format = { GL_BYTE, 1, true }; break;
+	case Type::UnsignedByte:  format = { GL_UNSIGNED_BYTE, 1, true }; break;
+	case Type::Short:         format = { GL_SHORT, 2, true }; break;
+	case Type::UnsignedShort: format = { GL_UNSIGNED_SHORT, 2, true }; break;
+	case Type::Int:           format = { GL_INT, 4, true }; break;
+	case Type::UnsignedInt:   format = { GL_UNSIGNED_INT, 4, true }; break;
+	}
+	format.Bytes *= attribute.Count;
+	return format;
+}
+
+static unsigned int VertexSize(const std::vector<Charis::VertexAttribute>& layout)
+{
+	unsigned int bytes = 0;
+	for (const auto& attribute : layout)
+		bytes += FormatOf(attribute).Bytes;
+	return bytes;
+}
+
+static std::vector<Charis::VertexAttribute> FloatLayout(const std::vector<unsigned int>& floatsPerAttributePerVertex)
+{
+	std::vector<Charis::VertexAttribute> layout;
+	for (auto floatsInAttribute : floatsPerAttributePerVertex)
+		layout.push_back({ Charis::VertexAttribute::Float, floatsInAttribute, false });
+	return layout;
+}
+
+static unsigned int FloatsPerVertex(const std::vector<unsigned int>& floatsPerAttributePerVertex)
+{
+	return std::reduce(floatsPerAttributePerVertex.begin(), floatsPerAttributePerVertex.end());
+}
+
+// Reads one component of an attribute as the vertex shader would see it.
+static float ReadComponent(const unsigned char* attribute, const Charis::VertexAttribute& description, unsigned int component)
+{
+	using Type = Charis::VertexAttribute::ComponentType;
+	const auto normalized = description.Normalized;
+	switch (description.Type) {
+	case Type::Float:         return reinterpret_cast<const float*>(attribute)[component];
+	case Type::HalfFloat:     return glm::unpackHalf1x16(reinterpret_cast<const std::uint16_t*>(attribute)[component]);
+	case Type::Byte:          { const float v = reinterpret_cast<const std::int8_t*>(attribute)[component]; return normalized ? std::max(v / 127.0f, -1.0f) : v; }
+	case Type::UnsignedByte:  { const float v = reinterpret_cast<const std::uint8_t*>(attribute)[component]; return normalized ? v / 255.0f : v; }
+	case Type::Short:         { const float v = reinterpret_cast<const std::int16_t*>(attribute)[component]; return normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+	case Type::UnsignedShort: { const float v = reinterpret_cast<const std::uint16_t*>(attribute)[component]; return normalized ? v / 65535.0f : v; }
+	case Type::Int:           { const auto v = static_cast<float>(reinterpret_cast<const std::int32_t*>(attribute)[component]); return normalized ? std::max(v / 2147483647.0f, -1.0f) : v; }
+	case Type::UnsignedInt:   { const auto v = static_cast<float>(reinterpret_cast<const std::uint32_t*>(attribute)[component]); return normalized ? v / 4294967295.0f : v; }
+	}
+	return 0.0f;
+}
+
+// Points the attributes of the bound vertex array at the bound array buffer. Integers that are not normalized stay integers in the shader.
+static void SetVertexAttributes(const std::vector<Charis::VertexAttribute>& layout)
+{
+	const auto stride = VertexSize(layout);
+	size_t offset = 0;
+	unsigned int attribute = 0;
+	for (const auto& description : layout) {
+		const auto format = FormatOf(description);
+		if (format.Integer && !description.Normalized)
+			glVertexAttribIPointer(attribute, description.Count, format.Type, stride, (void*)offset);
+		else
+			glVertexAttribPointer(attribute, description.Count, format.Type, description.Normalized ? GL_TRUE : GL_FALSE, stride, (void*)offset);
+		glEnableVertexAttribArray(attribute);
+		offset += format.Bytes;
+		attribute++;
+	}
+}
+
+struct VertexInfo { unsigned int VAO; unsigned int VBO; };
+static VertexInfo SetAttributesAndVertices(const void* vertices, unsigned int numberOfVertices, const std::vector<Charis::VertexAttribute>& layout) 
+{
+	VertexInfo vertInfo{};
+	const auto stride = VertexSize(layout);
+
+	// Create and bind vertex attribute object
+	glGenVertexArrays(1, &vertInfo.VAO);
+	Charis::PrivateGlobal::GLState::BindVertexArray(vertInfo.VAO);
+	
+	//Create and set vertex buffer object
+	glGenBuffers(1, &vertInfo.VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, vertInfo.VBO);
+	StaticBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(stride) * numberOfVertices, vertices);
+	SetVertexAttributes(layout);
+
+	return vertInfo;
+}
+
+namespace Charis {
+
+	Component::Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex)
+	{
+		Helper::RuntimeAssert(!floatsPerAttributePerVertex.empty(), "Must provide attribute float sizes.");
+		Helper::RuntimeAssert(numberOfVertexAttributes >= 3, "Must provide at least 3 vertices to model.");
+		Helper::RuntimeAssert(numberOfVertexAttributes % FloatsPerVertex(floatsPerAttributePerVertex) == 0, "Vertex attributes must be a whole number of vertices.");
+		const auto numberOfVertices = numberOfVertexAttributes / FloatsPerVertex(floatsPerAttributePerVertex);
+		Helper::RuntimeAssert(numberOfVertices >= 3 && numberOfVertices % 3 == 0, "Number of vertices must be a positive multiple of 3.");
+
+		// Set attributes and vertex buffers
+		auto vertInfo = SetAttributesAndVertices(vertexAttributes, numberOfVertices, FloatLayout(floatsPerAttributePerVertex));
+		m->VAO = vertInfo.VAO;
+		m->NumberOfAttributes = static_cast<unsigned int>(floatsPerAttributePerVertex.size());
+		m->NumberOfVertices = numberOfVertices;
+		m->VBO = vertInfo.VBO;
+		ComputeBounds(*m, vertexAttributes, numberOfVertices, sizeof(float) * FloatsPerVertex(floatsPerAttributePerVertex), { VertexAttribute::Float, floatsPerAttributePerVertex[0], false });
+
+		// Set up index/element buffer
+		m->UsingIBO = false;
+		m->NumberOfIndices = 0;
+		m->IBO = -1;
+	}
+	Component::Component(const std::vector<float>& vertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex) 
+		: Component(vertexAttributes.data(), vertexAttributes.size(), floatsPerAttributePerVertex)
+	{}
+
+	Component::Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const unsigned int* indices, unsigned int numberOfIndices, const std::vector<unsigned int>& floatsPerAttributePerVertex,
+		const std::vector<LevelOfDetail>& levelsOfDetail)
+	{
+		Helper::RuntimeAssert(!floatsPerAttributePerVertex.empty(), "Must provide attribute float sizes.");
+		Helper::RuntimeAssert(numberOfIndices >= 3, "Must provide at least 3 vertices to model.");
+		Helper::RuntimeAssert(numberOfIndices % 3 == 0, "Number of vertices must be multiple of 3.");
+		Helper::RuntimeAssert(numberOfVertexAttributes % FloatsPerVertex(floatsPerAttributePerVertex) == 0, "Vertex attributes must be a whole number of vertices.");
+
+		// Set attributes and vertex buffer
+		const auto numberOfVertices = numberOfVertexAttributes / FloatsPerVertex(floatsPerAttributePerVertex);
+		auto vertInfo = SetAttributesAndVertices(vertexAttributes, numberOfVertices, FloatLayout(floatsPerAttributePerVertex));
+		m->VAO = vertInfo.VAO;
+		m->NumberOfAttributes = static_cast<unsigned int>(floatsPerAttributePerVertex.size());
+		m->NumberOfVertices = numberOfVertices;
+		m->VBO = vertInfo.VBO;
+		ComputeBounds(*m, vertexAttributes, numberOfVertices, sizeof(float) * FloatsPerVertex(floatsPerAttributePerVertex), { VertexAttribute::Float, floatsPerAttributePerVertex[0], false });
+
+		// Set up index/element buffer
+		m->UsingIBO = true;
+		m->NumberOfIndices = numberOfIndices;
+		m->IndexSize = Indices32;
+		CreateIndexBuffer(*m, indices, numberOfIndices, levelsOfDetail);
+	}
+
+	Component::Component(const std::vector<float>& vertexAttributes, const std::vector<TriangleIndices>& indexTriangles, const std::vector<unsigned int>& floatsPerAttributePerVertex)
+		: Component(vertexAttributes.data(), vertexAttributes.size(), reinterpret_cast<const unsigned int*>(indexTriangles.data()), 3 * indexTriangles.size(), floatsPerAttributePerVertex)
+	{
+		static_assert(sizeof(TriangleIndices) == 3 * sizeof(unsigned int));
+	}
+
+	Component::Component(const void* vertices, unsigned int numberOfVertices, const std::vector<VertexAttribute>& layout, const void* indices, unsigned int numberOfIndices, IndexType indexType,
+		const std::vector<LevelOfDetail>& levelsOfDetail)
+	{
+		Helper::RuntimeAssert(!layout.empty(), "Must provide vertex layout.");
+		Helper::RuntimeAssert(std::all_of(layout.begin(), layout.end(), [](const VertexAttribute& attribute) { return attribute.Count >= 1 && attribute.Count <= 4; }), "Vertex attributes must have 1 to 4 components.");
+		Helper::RuntimeAssert(numberOfIndices >= 3, "Must provide at least 3 vertices to model.");
+		Helper::RuntimeAssert(numberOfIndices % 3 == 0, "Number of vertices must be multiple of 3.");
+		Helper::RuntimeAssert(indexType == Indices32 || numberOfVertices <= 65536, "16 bit indices can not address more than 65536 vertices.");
+
+		// Set attributes and vertex buffer
+		auto vertInfo = SetAttributesAndVertices(vertices, numberOfVertices, layout);
+		m->VAO = vertInfo.VAO;
+		m->NumberOfAttributes = static_cast<unsigned int>(layout.size());
+		m->NumberOfVertices = numberOfVertices;
+		m->VBO = vertInfo.VBO;
+		ComputeBounds(*m, vertices, numberOfVertices, VertexSize(layout), layout[0]);
+
+		// Set up index/element buffer
+		m->UsingIBO = true;
+		m->NumberOfIndices = numberOfIndices;
+		m->IndexSize = indexType;
+		CreateIndexBuffer(*m, indices, numberOfIndices, levelsOfDetail);
+	}
+
+	void Component::SetPositionDequantization(const std::array<float, 16>& columnMajorMatrix)
+	{
+		m->PositionDequantization = columnMajorMatrix;
+		const auto transform = glm::make_mat4(columnMajorMatrix.data());
+		m->Box = m->StoredBox.Transformed(transform);
+		m->Sphere = m->StoredSphere.Transformed(transform);
+	}
+
+	void Component::ComputeBounds(ModelComponentMember& member, const void* vertices, unsigned int numberOfVertices, unsigned int stride, const VertexAttribute& position)
+	{
+		// Positions with fewer than three components are in the plane z = 0
+		const auto components = std::min(position.Count, 3u);
+		const auto bytes = static_cast<const unsigned char*>(vertices);
+		const auto positionAt = [&](unsigned int vertex) {
+			auto point = glm::vec3(0.0f);
+			for (unsigned int c = 0; c < components; c++)
+				point[c] = ReadComponent(bytes + static_cast<size_t>(stride) * vertex, position, c);
+			return point;
+		};
+
+		auto box = BoundingBox{};
+		for (unsigned int i = 0; i < numberOfVertices; i++)
+			box.Add(positionAt(i));
+
+		// Centered on the box, which is not the smallest sphere but close enough for culling and needs no extra pass to find a center
+		auto sphere = BoundingSphere{ box.Center(), 0.0f };
+		for (unsigned int i = 0; i < numberOfVertices; i++)
+			sphere.Radius = std::max(sphere.Radius, glm::length(positionAt(i) - sphere.Center));
+
+		member.StoredBox = box;
+		member.StoredSphere = box.IsEmpty() ? BoundingSphere{} : sphere;
+		const auto transform = glm::make_mat4(member.PositionDequantization.data());
+		member.Box = member.StoredBox.Transformed(transform);
+		member.Sphere = member.StoredSphere.Transformed(transform);
+	}
+
+	void Component::SetVertexAttributes(const std::vector<VertexAttribute>& layout)
+	{
+		::SetVertexAttributes(layout);
+	}
+
+	unsigned int Component::VertexSize(const std::vector<VertexAttribute>& layout)
+	{
+		return ::VertexSize(layout);
+	}
+
+	void Component::CreateIndexBuffer(ModelComponentMember& member, const void* indices, unsigned int numberOfIndices, const std::vector<LevelOfDetail>& levelsOfDetail)
+	{
+		const auto indexBytes = static_cast<size_t>(member.IndexSize);
+		auto totalIndices = static_cast<size_t>(numberOfIndices);
+		float previousError = 0.0f;
+		for (const auto& level : levelsOfDetail) {
+			Helper::RuntimeAssert(level.Indices.size() >= 3 && level.Indices.size() % 3 == 0, "Level of detail must have a positive multiple of 3 indices.");
+			Helper::RuntimeAssert(level.Error >= previousError, "Levels of detail must be ordered from finest to coarsest.");
+			CHARIS_ASSERT_PARANOID(std::all_of(level.Indices.begin(), level.Indices.end(), [&](unsigned int index) { return index < member.NumberOfVertices; }), "Level of detail indices must refer to vertices of the component.");
+			member.Levels.push_back({ static_cast<unsigned int>(totalIndices), static_cast<unsigned int>(level.Indices.size()), level.Error });
+			totalIndices += level.Indices.size();
+			previousError = level.Error;
+		}
+
+		glGenBuffers(1, &member.IBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, member.IBO);
+		if (levelsOfDetail.empty()) {
+			StaticBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes * numberOfIndices, indices);
+			return;
+		}
+
+		// All levels share one buffer, so switching levels only changes the range of a draw
+		std::vector<unsigned char> bytes(indexBytes * totalIndices);
+		std::memcpy(bytes.data(), indices, indexBytes * numberOfIndices);
+		for (size_t i = 0; i < levelsOfDetail.size(); i++) {
+			const auto& level = levelsOfDetail[i];
+			auto destination = bytes.data() + indexBytes * member.Levels[i].FirstIndex;
+			if (member.IndexSize == Indices32) {
+				std::memcpy(destination, level.Indices.data(), indexBytes * level.Indices.size());
+				continue;
+			}
+			for (auto index : level.Indices) {
+				const auto narrow = static_cast<std::uint16_t>(index);
+				std::memcpy(destination, &narrow, sizeof(narrow));
+				destination += sizeof(narrow);
+			}
+		}
+		StaticBufferData(GL_ELEMENT_ARRAY_BUFFER, bytes.size(), bytes.data());
+	}
+
+	unsigned int Component::Triangles(unsigned int level) const
+	{
+		CHARIS_ASSERT(level < LevelsOfDetail(), "Component has no level of detail ", level, ".");
+		if (level > 0)
+			return m->Levels[level - 1].NumberOfIndices / 3;
+		return (m->UsingIBO ? m->NumberOfIndices : m->NumberOfVertices) / 3;
+	}
+
+	float Component::LevelError(unsigned int level) const
+	{
+		CHARIS_ASSERT(level < LevelsOfDetail(), "Component has no level of detail ", level, ".");
+		return level > 0 ? m->Levels[level - 1].Error : 0.0f;
+	}
+
+	unsigned int Component::SelectLevel(const glm::mat4& modelToWorld, unsigned int currentLevel) const
+	{
+		using Selection = PrivateGlobal::LevelOfDetailSelection;
+		if (m->Levels.empty() || !PrivateGlobal::CurrentView::Given)
+			return 0;
+
+		// Pixels covered by one unit at distance 1, or at any distance for orthographic projections, which have 0 where perspective ones have -1
+		const auto& view = PrivateGlobal::CurrentView::View;
+		const auto pixelsPerUnit = 0.5f * view.Projection[1][1] * PrivateGlobal::Window::Height;
+		const bool orthographic = view.Projection[2][3] == 0.0f;
+
+		// Errors grow with the largest scale of the transform, and shrink with the distance from the camera to the nearest point of the bounds
+		const auto scale = std::max({ glm::length(glm::vec3(modelToWorld[0])), glm::length(glm::vec3(modelToWorld[1])), glm::length(glm::vec3(modelToWorld[2])) });
+		const auto sphere = m->Sphere.Transformed(modelToWorld);
+		auto distance = 1.0f;
+		if (!orthographic) {
+			distance = glm::length(sphere.Center - view.CameraPosition) - sphere.Radius;
+			if (distance <= 0.0f)
+				return 0;
+		}
+		const auto pixels = [&](unsigned int level) { return LevelError(level) * scale * pixelsPerUnit / distance; };
+
+		auto level = std::min(currentLevel, LevelsOfDetail() - 1);
+		while (level > 0 && pixels(level) > Selection::PixelError)
+			level--;
+		while (level + 1 < LevelsOfDetail() && pixels(level + 1) <= Selection::PixelError * (1.0f - Selection::Hysteresis))
+			level++;
+		return level;
+	}
+
+	void Component::SetMeshlets(std::vector<Meshlet> meshlets)
+	{
+		Helper::RuntimeAssert(meshlets.empty() || m->UsingIBO, "Only components with indices can have meshlets.");
+		for (const auto& meshlet : meshlets) {
+			Helper::RuntimeAssert(meshlet.NumberOfIndices % 3 == 0, "Meshlets must be made of whole triangles.");
+			Helper::RuntimeAssert(meshlet.FirstIndex + meshlet.NumberOfIndices <= m->NumberOfIndices, "Meshlets must lie within the indices of the component.");
+		}
+		m->Meshlets = std::move(meshlets);
+	}
+
+	Component::ModelComponentMember::ModelComponentMember() = default;
+
+	Component::ModelComponentMember::~ModelComponentMember() = default;
+
+	void Component::ModelComponentMember::DeleteObjects()
+	{
+		if (Arena) {
+			GeometryArena::Release(*this);
+			return;
+		}
+
+		PrivateGlobal::GLState::ForgetVertexArray(VAO);
+		glDeleteVertexArrays(1, &VAO);
+		if (Stream)
+			return;
+		glDeleteBuffers(1, &VBO);
+
+		if (UsingIBO) 
+			glDeleteBuffers(1, &IBO);
+	}
+
 }
\ No newline at end of file
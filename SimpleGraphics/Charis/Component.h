@@ -1,66 +1,206 @@
-#pragma once
-#include "Texture.h"
-#include <vector>
-#include <array>
-#include <memory>
-
-namespace Charis {
-
-	/// <summary>Contains vertex indices to make up a triangle.</summary>
-	using TriangleIndices = std::array<unsigned int, 3>;
-
-	/// <summary>
-	/// A model contains vertices and the necessary information to be able to draw it to the screen.
-	/// This can for instance be a triangle or a cube.
-	/// </summary>
-	class Component
-	{
-	public:
-		/// <summary>Constructor for a model Component.</summary>
-		/// <param name="vertexAttributes">Pointer to an array that contains all vertices and vertex attributes.</param>
-		/// <param name="numberOfVertices">Number of vertex attributes in the array.</param>
-		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
-		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
-		Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex);
-		/// <summary>Constructor for a model Component.</summary>
-		/// <param name="vertexAttributes">Vector that contains all vertices and relevant vertex attributes.</param>
-		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
-		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
-		Component(const std::vector<float>& vertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex);
-		/// <summary>Constructor for a model Component.</summary>
-		/// <param name="vertexAttributes">Pointer to an array that contains all vertices and vertex attributes.</param>
-		/// <param name="numberOfVertexAttributes">Number of vertex attributes in the array.</param>
-		/// <param name="indices">Pointer to an array containing indices to vertices, where every three indices make up a triangle.</param>
-		/// <param name="numberOfIndices">Number of indices in the array.</param>
-		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
-		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
-		Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const unsigned int* indices, unsigned int numberOfIndices, const std::vector<unsigned int>& floatsPerAttributePerVertex);
-		/// <summary>Constructor for a model Component.</summary>
-		/// <param name="vertexAttributes">Vector that contains all vertices and relevant vertex attributes.</param>
-		/// <param name="indexTriangles">Vector containing vertex indices in sets of three that each form a triangle.</param>
-		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
-		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
-		Component(const std::vector<float>& vertexAttributes, const std::vector<TriangleIndices>& indexTriangles, const std::vector<unsigned int>& floatsPerAttributePerVertex);
-		
-		~Component();
-		
-		// List of textures related to this model component.
-		std::vector<Texture> Textures;
-
-		friend class Shader;
-	private:
-		struct ModelComponentMember {
-			unsigned int VAO{};
-			unsigned int NumberOfVertices{};
-			unsigned int VBO{};
-		
-			bool UsingIBO{};
-			unsigned int NumberOfIndices{};
-			unsigned int IBO{};
-		};
-		std::shared_ptr<ModelComponentMember> m = std::make_shared<ModelComponentMember>();
-
-	};
-
-}
-
+#pragma once
+#include "Resource.h"
+#include "Texture.h"
+#include "Bounds.h"
+#include "Meshlets.h"
+#include <vector>
+#include <array>
+#include <memory>
+
+namespace Charis {
+
+	struct GeometryArenaMember;
+	struct StreamBufferMember;
+
+	/// <summary>Contains vertex indices to make up a triangle.</summary>
+	using TriangleIndices = std::array<unsigned int, 3>;
+
+	/// <summary>Describes how one vertex shader input attribute is stored in the vertices of a component.</summary>
+	struct VertexAttribute {
+		enum ComponentType {
+			Float,
+			HalfFloat,
+			Byte,
+			UnsignedByte,
+			Short,
+			UnsignedShort,
+			Int,
+			UnsignedInt
+		};
+		ComponentType Type = Float;
+		// Number of components, in the range [1, 4].
+		unsigned int Count = 1;
+		// Integer components are mapped to [-1, 1] (signed) or [0, 1] (unsigned) floats if true. 
+		// Integer attributes that are not normalized are read as integers, so the shader input must be int, ivec or uvec.
+		bool Normalized = false;
+	};
+
+	/// <summary>A coarser version of a component, as triangles over the same vertices. See Model::LodSettings to generate them from model files.</summary>
+	struct LevelOfDetail {
+		// Indices to the vertices of the component, where every three indices make up a triangle.
+		std::vector<unsigned int> Indices;
+		// Largest distance between this level and the full component, in model space.
+		float Error{};
+	};
+
+	/// <summary>
+	/// A model contains vertices and the necessary information to be able to draw it to the screen.
+	/// This can for instance be a triangle or a cube.
+	/// </summary>
+	class Component
+	{
+	public:
+		/// <summary>Constructor for a model Component.</summary>
+		/// <param name="vertexAttributes">Pointer to an array that contains all vertices and vertex attributes.</param>
+		/// <param name="numberOfVertices">Number of vertex attributes in the array.</param>
+		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
+		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
+		Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex);
+		/// <summary>Constructor for a model Component.</summary>
+		/// <param name="vertexAttributes">Vector that contains all vertices and relevant vertex attributes.</param>
+		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
+		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
+		Component(const std::vector<float>& vertexAttributes, const std::vector<unsigned int>& floatsPerAttributePerVertex);
+		/// <summary>Constructor for a model Component.</summary>
+		/// <param name="vertexAttributes">Pointer to an array that contains all vertices and vertex attributes.</param>
+		/// <param name="numberOfVertexAttributes">Number of vertex attributes in the array.</param>
+		/// <param name="indices">Pointer to an array containing indices to vertices, where every three indices make up a triangle.</param>
+		/// <param name="numberOfIndices">Number of indices in the array.</param>
+		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
+		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
+		/// <param name="levelsOfDetail">Coarser versions of the component, from finest to coarsest. They are stored after the indices in the same index buffer.</param>
+		Component(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const unsigned int* indices, unsigned int numberOfIndices, const std::vector<unsigned int>& floatsPerAttributePerVertex,
+			const std::vector<LevelOfDetail>& levelsOfDetail = {});
+		/// <summary>Constructor for a model Component.</summary>
+		/// <param name="vertexAttributes">Vector that contains all vertices and relevant vertex attributes.</param>
+		/// <param name="indexTriangles">Vector containing vertex indices in sets of three that each form a triangle.</param>
+		/// <param name="floatsPerAttributePerVertex">This provides a list that for each shader attribute provides the number of floats it contains. 
+		/// For example, if the shaders first input is vec3 xyz and second input is vec3 rgb, then this argument should be { 3, 3 }.</param>
+		Component(const std::vector<float>& vertexAttributes, const std::vector<TriangleIndices>& indexTriangles, const std::vector<unsigned int>& floatsPerAttributePerVertex);
+
+		// Size of each index for components with a custom vertex layout.
+		enum IndexType {
+			Indices16 = 2,
+			Indices32 = 4
+		};
+		/// <summary>Constructor for a model Component with a custom vertex layout, for example quantized attributes.</summary>
+		/// <param name="vertices">Pointer to the tightly packed vertices, with the attributes of each vertex in the order of the layout.</param>
+		/// <param name="numberOfVertices">Number of vertices.</param>
+		/// <param name="layout">Descriptor of every shader attribute, at locations 0, 1, 2 and so on.</param>
+		/// <param name="indices">Pointer to an array containing indices to vertices, where every three indices make up a triangle.</param>
+		/// <param name="numberOfIndices">Number of indices in the array.</param>
+		/// <param name="indexType">Size of each index, 16 bit indices can address up to 65536 vertices.</param>
+		/// <param name="levelsOfDetail">Coarser versions of the component, from finest to coarsest. Their indices are converted to the index type.</param>
+		Component(const void* vertices, unsigned int numberOfVertices, const std::vector<VertexAttribute>& layout, const void* indices, unsigned int numberOfIndices, IndexType indexType,
+			const std::vector<LevelOfDetail>& levelsOfDetail = {});
+		
+		/// <summary>
+		/// Sets the transform from stored to actual vertex positions, for components with quantized positions.
+		/// Shaders that declare the uniform mat4 named ShaderPositionDequantizationName receive it before every draw of the component.
+		/// </summary>
+		/// <param name="columnMajorMatrix">Transform in the memory layout of glm::mat4. Components start out with the identity.</param>
+		void SetPositionDequantization(const std::array<float, 16>& columnMajorMatrix);
+		static constexpr const char* ShaderPositionDequantizationName = "PositionDequantization";
+
+		/// <summary>Box around the vertex positions, computed when the component is created. In model space, after the position dequantization.</summary>
+		const BoundingBox& LocalBounds() const { return m->Box; }
+		/// <summary>Sphere around the vertex positions, centered on LocalBounds.</summary>
+		const BoundingSphere& LocalSphere() const { return m->Sphere; }
+
+		/// <summary>Returns the number of levels of detail, where level 0 is the full component. Components without coarser levels have 1.</summary>
+		unsigned int LevelsOfDetail() const { return 1 + static_cast<unsigned int>(m->Levels.size()); }
+		/// <summary>Returns the number of triangles of a level of detail.</summary>
+		unsigned int Triangles(unsigned int level = 0) const;
+		/// <summary>Returns the error of a level of detail in model space, 0 for level 0.</summary>
+		float LevelError(unsigned int level) const;
+		/// <summary>
+		/// Picks the coarsest level of detail whose error covers at most the pixel error of Utility::SetLevelOfDetailSelection on screen,
+		/// as seen by the view of the last StartFrame. To keep a component that sits right at the limit from switching levels every frame,
+		/// a coarser level than the current one is only picked once its error is a margin below the limit.
+		/// Returns 0 if no view has been given to StartFrame.
+		/// </summary>
+		/// <param name="modelToWorld">Transform of the component into world space.</param>
+		/// <param name="currentLevel">Level picked for the component in the previous frame.</param>
+		unsigned int SelectLevel(const glm::mat4& modelToWorld, unsigned int currentLevel) const;
+
+		/// <summary>
+		/// Sets the meshlets of the component, made by BuildMeshlets from the same indices the component was created with, see Shader::DrawMeshlets.
+		/// Their bounds must be in model space, after the position dequantization. Meshlets only cover the full component, not its coarser levels.
+		/// </summary>
+		void SetMeshlets(std::vector<Meshlet> meshlets);
+		/// <summary>Returns the meshlets of the component, empty if it has none.</summary>
+		const std::vector<Meshlet>& Meshlets() const { return m->Meshlets; }
+		
+		// List of textures related to this model component.
+		std::vector<Texture> Textures;
+
+		friend class Shader;
+		friend class RenderQueue;
+		friend class GeometryArena;
+		friend struct GeometryArenaMember;
+		friend class DynamicComponent;
+	private:
+		// Used by GeometryArena and DynamicComponent, which fill in the member themselves.
+		Component() = default;
+
+		struct ModelComponentMember {
+			unsigned int VAO{};
+			// Vertex attributes of the vertex array, at locations 0 onwards
+			unsigned int NumberOfAttributes{};
+			unsigned int NumberOfVertices{};
+			unsigned int VBO{};
+		
+			bool UsingIBO{};
+			unsigned int NumberOfIndices{};
+			unsigned int IBO{};
+			IndexType IndexSize = Indices32;
+
+			std::array<float, 16> PositionDequantization = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+
+			// Bounds of the positions as stored, and after the position dequantization
+			BoundingBox StoredBox;
+			BoundingSphere StoredSphere;
+			BoundingBox Box;
+			BoundingSphere Sphere;
+
+			// Set if the vertices and indices live in the shared buffers of a GeometryArena instead of buffers owned by the component.
+			Resource<GeometryArenaMember> Arena;
+			// Set if the vertices and indices are streamed by a DynamicComponent, the component then only owns its vertex array.
+			Resource<StreamBufferMember> Stream;
+			// Offsets into the arena or stream buffers, counted in vertices and indices.
+			unsigned int BaseVertex{};
+			unsigned int FirstIndex{};
+
+			// Coarser levels of detail as ranges of the index buffer, level 1 first
+			struct LevelRange {
+				unsigned int FirstIndex{};
+				unsigned int NumberOfIndices{};
+				float Error{};
+			};
+			std::vector<LevelRange> Levels;
+
+			// Clusters of the full component, as ranges of its indices
+			std::vector<Meshlet> Meshlets;
+
+			// Defined where the arena and stream buffer members are complete, since they are only declared here
+			ModelComponentMember();
+			~ModelComponentMember();
+
+			// Deletes the vertex array and buffers, or gives the space back to the arena, see ResourceRegistry::Pool.
+			void DeleteObjects();
+		};
+		Resource<ModelComponentMember> m = Resource<ModelComponentMember>::Make();
+
+		// Computes the bounds from the first attribute of the vertices, which is taken to be the position.
+		static void ComputeBounds(ModelComponentMember& member, const void* vertices, unsigned int numberOfVertices, unsigned int stride, const VertexAttribute& position);
+		// Points the attributes of the bound vertex array at the bound array buffer, with the vertices tightly packed from offset 0.
+		static void SetVertexAttributes(const std::vector<VertexAttribute>& layout);
+		// Size of one vertex of the layout in bytes.
+		static unsigned int VertexSize(const std::vector<VertexAttribute>& layout);
+		// Creates the index buffer with the indices of the component followed by those of its coarser levels, in the index size of the member.
+		static void CreateIndexBuffer(ModelComponentMember& member, const void* indices, unsigned int numberOfIndices, const std::vector<LevelOfDetail>& levelsOfDetail);
+
+	};
+
+}
+
@@ -0,0 +1,229 @@
+#include "Culling.h"
+#include "Camera.h"
+#include "Component.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/SimdLanes.hpp"
+#include <limits>
+
+namespace {
+    using namespace Charis;
+#if CHARIS_SIMD_LANES > 1
+    using namespace Charis::PrivateGlobal::Simd;
+#endif
+
+    // Extents stored for empty boxes. Finite, so that a zero normal component times the extent is zero and not NaN,
+    // and negative enough that every plane test fails, in the SIMD lanes and the scalar tail alike.
+    constexpr float EmptyExtent = -std::numeric_limits<float>::max() / 4.0f;
+
+    struct Plane {
+        glm::vec3 Normal;
+        glm::vec3 AbsoluteNormal;
+        float Distance;
+    };
+
+    std::array<Plane, 6> PlanesOf(const Frustum& frustum)
+    {
+        std::array<Plane, 6> planes{};
+        for (size_t i = 0; i < planes.size(); i++) {
+            const auto& plane = frustum.Planes[i];
+            planes[i] = { glm::vec3(plane), glm::abs(glm::vec3(plane)), plane.w };
+        }
+        return planes;
+    }
+
+    // A box is outside if it is entirely on the outer side of any plane, which is when even its corner furthest along the normal is.
+    bool BoxIntersects(const std::array<Plane, 6>& planes, const glm::vec3& center, const glm::vec3& extents)
+    {
+        for (const auto& plane : planes) {
+            if (glm::dot(plane.Normal, center) + glm::dot(plane.AbsoluteNormal, extents) + plane.Distance < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+}
+
+namespace Charis {
+
+    Frustum::Frustum(const glm::mat4& viewProjection)
+    {
+        // Gribb and Hartmann: each plane is the last row of the matrix plus or minus one of the others
+        const auto row = [&](int i) { return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]); };
+        Planes = { row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1), row(3) + row(2), row(3) - row(2) };
+
+        // Normalized, so the distance to a sphere center can be compared to its radius
+        for (auto& plane : Planes)
+            plane /= glm::length(glm::vec3(plane));
+    }
+
+    Frustum::Frustum(const Camera& camera)
+        : Frustum(camera.ProjectionMatrix() * camera.ViewMatrix())
+    {}
+
+    bool Frustum::Intersects(const BoundingBox& box) const
+    {
+        return !box.IsEmpty() && BoxIntersects(PlanesOf(*this), box.Center(), box.Extents());
+    }
+
+    bool Frustum::Intersects(const BoundingSphere& sphere) const
+    {
+        if (sphere.Radius < 0.0f)
+            return false;
+        for (const auto& plane : Planes) {
+            if (glm::dot(glm::vec3(plane), sphere.Center) + plane.w < -sphere.Radius)
+                return false;
+        }
+        return true;
+    }
+
+    FrustumCuller::FrustumCuller()
+        : m(std::make_shared<FrustumCullerMember>())
+    {}
+
+    unsigned int FrustumCuller::Add(const BoundingBox& localBox, const glm::mat4& transform)
+    {
+        const auto index = Size();
+        m->LocalBoxes.push_back(localBox);
+        for (auto values : { &m->CenterX, &m->CenterY, &m->CenterZ, &m->ExtentX, &m->ExtentY, &m->ExtentZ })
+            values->push_back(0.0f);
+        SetTransform(index, transform);
+        return index;
+    }
+
+    unsigned int FrustumCuller::Add(const Component& component, const glm::mat4& transform)
+    {
+        return Add(component.LocalBounds(), transform);
+    }
+
+    void FrustumCuller::SetTransform(unsigned int index, const glm::mat4& transform)
+    {
+        CHARIS_ASSERT(index < Size(), "Culler has no box at index ", index, ".");
+
+        const auto box = m->LocalBoxes[index].Transformed(transform);
+        const auto center = box.IsEmpty() ? glm::vec3(0.0f) : box.Center();
+        const auto extents = box.IsEmpty() ? glm::vec3(EmptyExtent) : box.Extents();
+        m->CenterX[index] = center.x;
+        m->CenterY[index] = center.y;
+        m->CenterZ[index] = center.z;
+        m->ExtentX[index] = extents.x;
+        m->ExtentY[index] = extents.y;
+        m->ExtentZ[index] = extents.z;
+    }
+
+    void FrustumCuller::Clear()
+    {
+        m->LocalBoxes.clear();
+        for (auto values : { &m->CenterX, &m->CenterY, &m->CenterZ, &m->ExtentX, &m->ExtentY, &m->ExtentZ })
+            values->clear();
+        m->Visible.clear();
+        m->Last = {};
+    }
+
+    unsigned int FrustumCuller::Size() const
+    {
+        return static_cast<unsigned int>(m->LocalBoxes.size());
+    }
+
+    const std::vector<unsigned int>& FrustumCuller::Cull(const Frustum& frustum)
+    {
+        const auto planes = PlanesOf(frustum);
+        const auto count = Size();
+        auto& visible = m->Visible;
+        visible.clear();
+
+        unsigned int i = 0;
+#if CHARIS_SIMD_LANES > 1
+        struct PlaneLanes { Lanes X, Y, Z, AbsoluteX, AbsoluteY, AbsoluteZ, Distance; };
+        std::array<PlaneLanes, 6> planeLanes{};
+        for (size_t p = 0; p < planes.size(); p++) {
+            const auto& plane = planes[p];
+            planeLanes[p] = { Broadcast(plane.Normal.x), Broadcast(plane.Normal.y), Broadcast(plane.Normal.z),
+                Broadcast(plane.AbsoluteNormal.x), Broadcast(plane.AbsoluteNormal.y), Broadcast(plane.AbsoluteNormal.z), Broadcast(plane.Distance) };
+        }
+
+        for (; i + CHARIS_SIMD_LANES <= count; i += CHARIS_SIMD_LANES) {
+            const auto centerX = Load(&m->CenterX[i]);
+            const auto centerY = Load(&m->CenterY[i]);
+            const auto centerZ = Load(&m->CenterZ[i]);
+            const auto extentX = Load(&m->ExtentX[i]);
+            const auto extentY = Load(&m->ExtentY[i]);
+            const auto extentZ = Load(&m->ExtentZ[i]);
+
+            // All six planes are always tested, branching out early costs more than it saves at these widths
+            auto inside = NotNegative(Broadcast(0.0f));
+            for (const auto& plane : planeLanes) {
+                auto distance = Plus(plane.Distance, Times(plane.X, centerX));
+                distance = Plus(distance, Times(plane.Y, centerY));
+                distance = Plus(distance, Times(plane.Z, centerZ));
+                distance = Plus(distance, Times(plane.AbsoluteX, extentX));
+                distance = Plus(distance, Times(plane.AbsoluteY, extentY));
+                distance = Plus(distance, Times(plane.AbsoluteZ, extentZ));
+                inside = And(inside, NotNegative(distance));
+            }
+
+            for (auto bits = Bits(inside); bits != 0; bits &= bits - 1) {
+                unsigned int lane = 0;
+                while (((bits >> lane) & 1) == 0)
+                    lane++;
+                visible.push_back(i + lane);
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            const auto center = glm::vec3(m->CenterX[i], m->CenterY[i], m->CenterZ[i]);
+            const auto extents = glm::vec3(m->ExtentX[i], m->ExtentY[i], m->ExtentZ[i]);
+            if (BoxIntersects(planes, center, extents))
+                visible.push_back(i);
+        }
+
+        m->Last.Visible = static_cast<unsigned int>(visible.size());
+        m->Last.Culled = count - m->Last.Visible;
+        PrivateGlobal::Statistics::CountCulling(m->Last.Visible, m->Last.Culled);
+        return visible;
+    }
+
+    FrustumCuller::Counts FrustumCuller::LastCounts() const
+    {
+        return m->Last;
+    }
+
+    void CullMeshlets(const Component& component, const glm::mat4& modelToWorld, const glm::mat4& viewProjection, const glm::vec3& cameraPosition, bool cullBackFacing, std::vector<IndexRange>& visible)
+    {
+        visible.clear();
+        const auto& meshlets = component.Meshlets();
+        if (meshlets.empty()) {
+            if (component.Triangles() > 0)
+                visible.push_back({ 0, 3 * component.Triangles() });
+            return;
+        }
+
+        // Both tests run in model space, which saves transforming every sphere. The planes are normalized after the transform, so sphere radii stay in model units.
+        const auto frustum = Frustum(viewProjection * modelToWorld);
+        // Mirroring transforms flip which side of a triangle faces the camera, so those are only culled by the frustum
+        const bool testCones = cullBackFacing && glm::determinant(glm::mat3(modelToWorld)) > 0.0f;
+        const auto camera = testCones ? glm::vec3(glm::inverse(modelToWorld) * glm::vec4(cameraPosition, 1.0f)) : glm::vec3(0.0f);
+
+        unsigned int culled = 0;
+        unsigned int trianglesCulled = 0;
+        for (const auto& meshlet : meshlets) {
+            auto inside = frustum.Intersects(meshlet.Sphere);
+            if (inside && testCones && meshlet.ConeCutoff < 1.0f) {
+                // Every triangle faces away if the whole sphere is inside the cone of directions from which all normals point away
+                const auto toCenter = meshlet.Sphere.Center - camera;
+                inside = glm::dot(toCenter, meshlet.ConeAxis) < meshlet.ConeCutoff * glm::length(toCenter) + meshlet.Sphere.Radius;
+            }
+            if (!inside) {
+                culled++;
+                trianglesCulled += meshlet.NumberOfIndices / 3;
+                continue;
+            }
+            if (!visible.empty() && visible.back().FirstIndex + visible.back().NumberOfIndices == meshlet.FirstIndex)
+                visible.back().NumberOfIndices += meshlet.NumberOfIndices;
+            else
+                visible.push_back({ meshlet.FirstIndex, meshlet.NumberOfIndices });
+        }
+        PrivateGlobal::Statistics::CountMeshlets(static_cast<unsigned int>(meshlets.size()) - culled, culled, trianglesCulled);
+    }
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "Bounds.h"
+#include <array>
+#include <vector>
+#include <memory>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	class Camera;
+	class Component;
+
+	/// <summary>The six planes of a view frustum, extracted from a view projection matrix.</summary>
+	class Frustum
+	{
+	public:
+		/// <summary>Constructor for a Frustum.</summary>
+		/// <param name="viewProjection">Projection matrix times view matrix, with clip space depth in [-w, w] as made by glm::perspective.</param>
+		explicit Frustum(const glm::mat4& viewProjection);
+		/// <summary>Constructor for the Frustum of a camera, from ProjectionMatrix() * ViewMatrix().</summary>
+		explicit Frustum(const Camera& camera);
+
+		/// <summary>Checks if a box in world coordinates is at least partly inside. Boxes near the corners of the frustum may be reported inside when they are not.</summary>
+		bool Intersects(const BoundingBox& box) const;
+		/// <summary>Checks if a sphere in world coordinates is at least partly inside, with the same leniency as for boxes.</summary>
+		bool Intersects(const BoundingSphere& sphere) const;
+
+		// Left, right, bottom, top, near and far plane. xyz is the normal, pointing into the frustum, and w the distance,
+		// so a point p is on the inner side of a plane when dot(xyz, p) + w >= 0.
+		std::array<glm::vec4, 6> Planes{};
+	};
+
+	/// <summary>
+	/// Tests many bounding boxes against a frustum at once. Boxes are added once with their transform and kept in world coordinates,
+	/// packed component by component so that SSE, or AVX when compiled for it, tests 4 or 8 boxes per instruction.
+	/// Culling fills a list of the indices of the visible boxes to draw from, and adds the visible and culled counts to Utility::FrameStatistics.
+	/// </summary>
+	class FrustumCuller
+	{
+	public:
+		FrustumCuller();
+
+		/// <summary>Adds a box, in the local coordinates of the transform. Returns the index of the box, counting from 0 in the order they were added.</summary>
+		unsigned int Add(const BoundingBox& localBox, const glm::mat4& transform);
+		/// <summary>Adds the bounds of a component. Returns the index of the component, see Add.</summary>
+		unsigned int Add(const Component& component, const glm::mat4& transform);
+		/// <summary>Moves a box that was added before to a new transform.</summary>
+		void SetTransform(unsigned int index, const glm::mat4& transform);
+		/// <summary>Removes all boxes.</summary>
+		void Clear();
+		unsigned int Size() const;
+
+		/// <summary>
+		/// Tests all boxes against the frustum. Returns the indices of the boxes that are at least partly inside, in increasing order.
+		/// The list is valid until the next call to Cull.
+		/// </summary>
+		const std::vector<unsigned int>& Cull(const Frustum& frustum);
+
+		struct Counts {
+			unsigned int Visible{};
+			unsigned int Culled{};
+		};
+		/// <summary>Returns the counts of the last Cull.</summary>
+		Counts LastCounts() const;
+
+	private:
+		struct FrustumCullerMember {
+			std::vector<BoundingBox> LocalBoxes;
+			// World space boxes as centers and extents, one array per component
+			std::vector<float> CenterX, CenterY, CenterZ;
+			std::vector<float> ExtentX, ExtentY, ExtentZ;
+			std::vector<unsigned int> Visible;
+			Counts Last{};
+		};
+		std::shared_ptr<FrustumCullerMember> m;
+	};
+
+	/// <summary>A range of the index buffer of a component.</summary>
+	struct IndexRange {
+		unsigned int FirstIndex{};
+		unsigned int NumberOfIndices{};
+	};
+
+	/// <summary>
+	/// Tests the meshlets of a component against a frustum, and optionally drops meshlets whose triangles all face away from the camera.
+	/// Fills a list of the index ranges left to draw, where neighbouring visible meshlets are merged into one range, and adds the
+	/// visible and culled counts to Utility::FrameStatistics. Components without meshlets give a single range of all their indices.
+	/// </summary>
+	/// <param name="component">Component whose meshlets to cull.</param>
+	/// <param name="modelToWorld">Transform of the component into world space.</param>
+	/// <param name="viewProjection">Projection matrix times view matrix.</param>
+	/// <param name="cameraPosition">Position of the camera in world space, for the back facing test.</param>
+	/// <param name="cullBackFacing">Also drops meshlets that face away from the camera. Only use it when Utility::SetBackFaceCulling is on, so the GPU would drop those triangles anyway.</param>
+	/// <param name="visible">Ranges of the meshlets that are at least partly visible, in increasing order. Cleared first.</param>
+	void CullMeshlets(const Component& component, const glm::mat4& modelToWorld, const glm::mat4& viewProjection, const glm::vec3& cameraPosition, bool cullBackFacing, std::vector<IndexRange>& visible);
+
+}
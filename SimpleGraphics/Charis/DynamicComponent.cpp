@@ -0,0 +1,94 @@
+#include "DynamicComponent.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Libraries
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+    using namespace Charis;
+
+    std::vector<VertexAttribute> FloatLayout(const std::vector<unsigned int>& floatsPerAttributePerVertex)
+    {
+        std::vector<VertexAttribute> layout;
+        for (auto floatsInAttribute : floatsPerAttributePerVertex)
+            layout.push_back({ VertexAttribute::Float, floatsInAttribute, false });
+        return layout;
+    }
+
+    // Room for the largest frame, including the padding that aligns the vertices to whole vertices and the indices to whole indices
+    size_t StreamBytes(unsigned int vertexSize, unsigned int maxVertices, unsigned int maxIndices)
+    {
+        return static_cast<size_t>(vertexSize) * (maxVertices + 1) + sizeof(unsigned int) * (static_cast<size_t>(maxIndices) + 1);
+    }
+}
+
+namespace Charis {
+
+    DynamicComponent::DynamicComponent(const std::vector<VertexAttribute>& layout, unsigned int maxVertices, unsigned int maxIndices, StreamBuffer::Method method)
+        : m_Stream(StreamBytes(Component::VertexSize(layout), maxVertices, maxIndices), method), m_Layout(layout),
+        m_VertexSize(Component::VertexSize(layout)), m_MaxVertices(maxVertices), m_MaxIndices(maxIndices)
+    {
+        Helper::RuntimeAssert(!layout.empty(), "Must provide vertex layout.");
+        Helper::RuntimeAssert(std::all_of(layout.begin(), layout.end(), [](const VertexAttribute& attribute) { return attribute.Count >= 1 && attribute.Count <= 4; }), "Vertex attributes must have 1 to 4 components.");
+        Helper::RuntimeAssert(maxVertices > 0, "DynamicComponent must have room for at least one vertex.");
+
+        // The vertex array never changes, every frame only moves the base vertex and first index of the draws to where that frame was written
+        glGenVertexArrays(1, &m->VAO);
+        PrivateGlobal::GLState::BindVertexArray(m->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_Stream.m->Buffer);
+        SetVertexAttributes(layout);
+        if (maxIndices > 0)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Stream.m->Buffer);
+
+        m->Stream = m_Stream.m;
+        m->NumberOfAttributes = static_cast<unsigned int>(layout.size());
+        m->UsingIBO = maxIndices > 0;
+        m->IndexSize = Indices32;
+    }
+
+    DynamicComponent::DynamicComponent(const std::vector<unsigned int>& floatsPerAttributePerVertex, unsigned int maxVertices, unsigned int maxIndices, StreamBuffer::Method method)
+        : DynamicComponent(FloatLayout(floatsPerAttributePerVertex), maxVertices, maxIndices, method)
+    {}
+
+    DynamicComponent::Update DynamicComponent::BeginUpdate(unsigned int numberOfVertices, unsigned int numberOfIndices)
+    {
+        CHARIS_ASSERT(numberOfVertices <= m_MaxVertices, "DynamicComponent has room for ", m_MaxVertices, " vertices, not ", numberOfVertices, ".");
+        CHARIS_ASSERT(m_MaxIndices == 0 || (numberOfIndices <= m_MaxIndices && numberOfIndices % 3 == 0), "DynamicComponent has room for ", m_MaxIndices, " indices in whole triangles, not ", numberOfIndices, ".");
+
+        auto update = Update{};
+        update.m_Vertices = m_Stream.Allocate(static_cast<size_t>(m_VertexSize) * numberOfVertices, m_VertexSize);
+        m->BaseVertex = static_cast<unsigned int>(update.m_Vertices.m_Offset / m_VertexSize);
+        m->NumberOfVertices = numberOfVertices;
+        if (m_MaxIndices > 0) {
+            update.m_Indices = m_Stream.Allocate(sizeof(unsigned int) * numberOfIndices, sizeof(unsigned int));
+            m->FirstIndex = static_cast<unsigned int>(update.m_Indices.m_Offset / sizeof(unsigned int));
+            m->NumberOfIndices = numberOfIndices;
+        }
+        return update;
+    }
+
+    void DynamicComponent::SetVertices(const void* vertices, unsigned int numberOfVertices, const unsigned int* indices, unsigned int numberOfIndices)
+    {
+        auto update = BeginUpdate(numberOfVertices, numberOfIndices);
+        if (numberOfVertices > 0)
+            std::memcpy(update.Vertices().data(), vertices, update.Vertices().size());
+        if (m_MaxIndices > 0 && numberOfIndices > 0)
+            std::memcpy(update.Indices().data(), indices, update.Indices().size_bytes());
+        update.Finish();
+        ComputeBounds(*m, vertices, numberOfVertices, m_VertexSize, m_Layout[0]);
+    }
+
+    void DynamicComponent::SetLocalBounds(const BoundingBox& box)
+    {
+        m->StoredBox = box;
+        m->StoredSphere = box.IsEmpty() ? BoundingSphere{} : BoundingSphere{ box.Center(), glm::length(box.Extents()) };
+        const auto transform = glm::make_mat4(m->PositionDequantization.data());
+        m->Box = m->StoredBox.Transformed(transform);
+        m->Sphere = m->StoredSphere.Transformed(transform);
+    }
+
+}
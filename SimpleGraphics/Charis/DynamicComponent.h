@@ -0,0 +1,74 @@
+#pragma once
+#include "Component.h"
+#include "StreamBuffer.h"
+#include <span>
+#include <vector>
+
+namespace Charis {
+
+	/// <summary>
+	/// A component whose vertices, and optionally indices, are written anew every frame, like cloth animated on the CPU, particles or debug lines.
+	/// The data is streamed through a StreamBuffer of its own, so updating it never waits for the GPU and never creates GL objects.
+	/// It is drawn like any other component, but only shows what was written in the frame it is drawn in, so write it every frame it is drawn.
+	/// </summary>
+	class DynamicComponent : public Component
+	{
+	public:
+		/// <summary>Constructor for a DynamicComponent.</summary>
+		/// <param name="layout">Descriptor of every shader attribute, at locations 0, 1, 2 and so on, see Component.</param>
+		/// <param name="maxVertices">Number of vertices the component can have in a frame.</param>
+		/// <param name="maxIndices">Number of indices the component can have in a frame, 0 for a component that is drawn without indices.</param>
+		/// <param name="method">How the data reaches the GPU, see StreamBuffer.</param>
+		DynamicComponent(const std::vector<VertexAttribute>& layout, unsigned int maxVertices, unsigned int maxIndices = 0, StreamBuffer::Method method = StreamBuffer::PersistentMapping);
+		/// <summary>Constructor for a DynamicComponent with float attributes.</summary>
+		/// <param name="floatsPerAttributePerVertex">Number of floats of every shader attribute, see Component.</param>
+		DynamicComponent(const std::vector<unsigned int>& floatsPerAttributePerVertex, unsigned int maxVertices, unsigned int maxIndices = 0, StreamBuffer::Method method = StreamBuffer::PersistentMapping);
+
+		/// <summary>
+		/// Room for the vertices and indices of this frame, to be written in place. Only one handle owns it, so it can be moved but not copied.
+		/// Finish it, or let it go out of scope, before drawing the component.
+		/// </summary>
+		class Update
+		{
+		public:
+			// Tightly packed vertices in the layout of the component
+			std::span<unsigned char> Vertices() const { return m_Vertices.As<unsigned char>(); }
+			// Vertices as elements of a type, like a struct matching the layout or float for float layouts
+			template<class T>
+			std::span<T> VerticesAs() const { return m_Vertices.As<T>(); }
+			std::span<unsigned int> Indices() const { return m_Indices.As<unsigned int>(); }
+			void Finish() { m_Vertices.Finish(); m_Indices.Finish(); }
+
+			friend class DynamicComponent;
+		private:
+			StreamBuffer::Allocation m_Vertices;
+			StreamBuffer::Allocation m_Indices;
+		};
+
+		/// <summary>
+		/// Allocates the vertices and indices of this frame, which replace those of the previous frame. The bounds stay as they were, see SetLocalBounds.
+		/// </summary>
+		/// <param name="numberOfVertices">Number of vertices, at most the maximum of the component.</param>
+		/// <param name="numberOfIndices">Number of indices, a multiple of 3 and at most the maximum of the component. Ignored for components without indices.</param>
+		Update BeginUpdate(unsigned int numberOfVertices, unsigned int numberOfIndices = 0);
+		/// <summary>Copies in the vertices and indices of this frame, and computes the bounds from them.</summary>
+		/// <param name="vertices">Pointer to the tightly packed vertices, in the layout of the component.</param>
+		/// <param name="numberOfVertices">Number of vertices.</param>
+		/// <param name="indices">Pointer to the indices, where every three make up a triangle. Ignored for components without indices.</param>
+		/// <param name="numberOfIndices">Number of indices.</param>
+		void SetVertices(const void* vertices, unsigned int numberOfVertices, const unsigned int* indices = nullptr, unsigned int numberOfIndices = 0);
+
+		/// <summary>Sets the bounds used for culling, for updates that are written in place. The sphere is the one around the box.</summary>
+		void SetLocalBounds(const BoundingBox& box);
+		/// <summary>Returns how the data reaches the GPU, see StreamBuffer::UsedMethod.</summary>
+		StreamBuffer::Method UsedMethod() const { return m_Stream.UsedMethod(); }
+
+	private:
+		StreamBuffer m_Stream;
+		std::vector<VertexAttribute> m_Layout;
+		unsigned int m_VertexSize{};
+		unsigned int m_MaxVertices{};
+		unsigned int m_MaxIndices{};
+	};
+
+}
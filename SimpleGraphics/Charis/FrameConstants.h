@@ -0,0 +1,84 @@
+#pragma once
+#include <span>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	/// <summary>A light infinitely far away, shining in one direction.</summary>
+	struct DirectionalLight {
+		glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+		glm::vec3 Ambient{};
+		glm::vec3 Diffuse{};
+		glm::vec3 Specular{};
+	};
+
+	/// <summary>A light at a position, fading with distance by 1 / (Constant + Linear * d + Quadratic * d^2).</summary>
+	struct PointLight {
+		glm::vec3 Position{};
+		glm::vec3 Ambient{};
+		glm::vec3 Diffuse{};
+		glm::vec3 Specular{};
+		float Constant = 1.0f;
+		float Linear = 0.09f;
+		float Quadratic = 0.032f;
+	};
+
+	/// <summary>Lights of a frame, see StartFrame. At most FrameConstants::MaxPointLights point lights are used.</summary>
+	struct FrameLights {
+		DirectionalLight Directional{};
+		std::span<const PointLight> PointLights;
+	};
+
+	/// <summary>View of a frame for when there is no Camera, see StartFrame.</summary>
+	struct FrameView {
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+		glm::vec3 CameraPosition{};
+	};
+
+	/// <summary>
+	/// A std140 uniform block owned by Charis and filled once per frame by StartFrame, so camera and light uniforms are not set per shader.
+	/// Every shader that declares the block, exactly as in ShaderSource, is connected to it when it is linked.
+	/// </summary>
+	namespace FrameConstants {
+
+		constexpr unsigned int BindingPoint = 0;
+		constexpr unsigned int MaxPointLights = 16;
+		constexpr const char* BlockName = "FrameConstants";
+
+		// GLSL declaration of the block, to be pasted into shaders after the #version line.
+		// The viewport is the frame size in pixels and time is Utility::GetTime at the start of the frame.
+		constexpr const char* ShaderSource = R"(
+struct DirectionalLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+struct PointLight {
+    vec3 position;
+    float constant;
+    vec3 ambient;
+    float linear;
+    vec3 diffuse;
+    float quadratic;
+    vec3 specular;
+};
+layout (std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 cameraPos;
+    float time;
+    vec2 viewport;
+    int pointLightCount;
+    DirectionalLight dirLight;
+    PointLight pointLights[16];
+};
+)";
+
+	}
+
+}
@@ -0,0 +1,238 @@
+#include "GeometryArena.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+
+// Libraries
+#include <glad/glad.h>
+
+namespace {
+    using namespace Charis;
+    using FreeBlocks = std::map<unsigned int, unsigned int>;
+
+    // Takes the first free block that is large enough. Returns false if there is none.
+    bool Allocate(FreeBlocks& freeBlocks, unsigned int size, unsigned int& offset)
+    {
+        for (auto it = freeBlocks.begin(); it != freeBlocks.end(); it++) {
+            if (it->second < size)
+                continue;
+
+            offset = it->first;
+            const auto rest = it->second - size;
+            freeBlocks.erase(it);
+            if (rest > 0)
+                freeBlocks.insert({ offset + size, rest });
+            return true;
+        }
+        return false;
+    }
+
+    // Gives a block back, merging it with the free blocks right before and after it.
+    void Free(FreeBlocks& freeBlocks, unsigned int offset, unsigned int size)
+    {
+        if (size == 0)
+            return;
+
+        auto next = freeBlocks.lower_bound(offset);
+        if (next != freeBlocks.end() && offset + size == next->first) {
+            size += next->second;
+            next = freeBlocks.erase(next);
+        }
+        if (next != freeBlocks.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                previous->second += size;
+                return;
+            }
+        }
+        freeBlocks.insert(next, { offset, size });
+    }
+
+    unsigned int FreeSpace(const FreeBlocks& freeBlocks)
+    {
+        return std::accumulate(freeBlocks.begin(), freeBlocks.end(), 0u, [](unsigned int sum, const auto& block) { return sum + block.second; });
+    }
+
+    unsigned int CreateBuffer(size_t bytes)
+    {
+        // The copy targets are not part of any vertex array, so this never disturbs the element buffer of a bound vertex array
+        unsigned int buffer{};
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, bytes, nullptr, GL_STATIC_DRAW);
+        return buffer;
+    }
+
+    // Moves the arena into new buffers of the given capacities, packing all components at the front of them.
+    void Rebuild(GeometryArenaMember& arena, unsigned int vertexCapacity, unsigned int indexCapacity)
+    {
+        const auto vertexBytes = sizeof(float) * arena.FloatsPerVertex;
+        const auto indexBytes = sizeof(unsigned int);
+        const auto vbo = CreateBuffer(vertexBytes * vertexCapacity);
+        const auto ibo = CreateBuffer(indexBytes * indexCapacity);
+
+        // Copy every component to its new place
+        unsigned int vertexEnd = 0;
+        glBindBuffer(GL_COPY_READ_BUFFER, arena.VBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+        for (auto resident : arena.Residents) {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, vertexBytes * resident->BaseVertex, vertexBytes * vertexEnd, vertexBytes * resident->NumberOfVertices);
+            resident->BaseVertex = vertexEnd;
+            resident->VBO = vbo;
+            vertexEnd += resident->NumberOfVertices;
+        }
+
+        unsigned int indexEnd = 0;
+        glBindBuffer(GL_COPY_READ_BUFFER, arena.IBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, ibo);
+        for (auto resident : arena.Residents) {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, indexBytes * resident->FirstIndex, indexBytes * indexEnd, indexBytes * resident->NumberOfIndices);
+            resident->FirstIndex = indexEnd;
+            resident->IBO = ibo;
+            indexEnd += resident->NumberOfIndices;
+        }
+
+        if (arena.VBO != 0)
+            glDeleteBuffers(1, &arena.VBO);
+        if (arena.IBO != 0)
+            glDeleteBuffers(1, &arena.IBO);
+        arena.VBO = vbo;
+        arena.IBO = ibo;
+        arena.VertexCapacity = vertexCapacity;
+        arena.IndexCapacity = indexCapacity;
+
+        // Everything after the packed components is one free block
+        arena.FreeVertices.clear();
+        arena.FreeIndices.clear();
+        Free(arena.FreeVertices, vertexEnd, vertexCapacity - vertexEnd);
+        Free(arena.FreeIndices, indexEnd, indexCapacity - indexEnd);
+
+        // Point the shared vertex array at the new buffers
+        PrivateGlobal::GLState::BindVertexArray(arena.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        int offset = 0;
+        int attribute = 0;
+        for (auto floatsInAttribute : arena.FloatsPerAttributePerVertex) {
+            glVertexAttribPointer(attribute, floatsInAttribute, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(vertexBytes), (void*)(offset * sizeof(float)));
+            glEnableVertexAttribArray(attribute);
+            offset += floatsInAttribute;
+            attribute++;
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    }
+
+    // Finds room for a component, compacting or growing the arena if no free block is large enough.
+    void Reserve(GeometryArenaMember& arena, unsigned int vertices, unsigned int indices, unsigned int& baseVertex, unsigned int& firstIndex)
+    {
+        if (Allocate(arena.FreeVertices, vertices, baseVertex)) {
+            if (Allocate(arena.FreeIndices, indices, firstIndex))
+                return;
+            Free(arena.FreeVertices, baseVertex, vertices);
+        }
+
+        // Compacting is enough if the free space is only fragmented, otherwise grow geometrically
+        const auto verticesNeeded = arena.VertexCapacity - FreeSpace(arena.FreeVertices) + vertices;
+        const auto indicesNeeded = arena.IndexCapacity - FreeSpace(arena.FreeIndices) + indices;
+        const auto vertexCapacity = verticesNeeded <= arena.VertexCapacity ? arena.VertexCapacity : std::max(2 * arena.VertexCapacity, verticesNeeded);
+        const auto indexCapacity = indicesNeeded <= arena.IndexCapacity ? arena.IndexCapacity : std::max(2 * arena.IndexCapacity, indicesNeeded);
+        Rebuild(arena, vertexCapacity, indexCapacity);
+
+        const bool reserved = Allocate(arena.FreeVertices, vertices, baseVertex) && Allocate(arena.FreeIndices, indices, firstIndex);
+        Helper::RuntimeAssert(reserved, "Geometry arena failed to make room for component.");
+    }
+
+}
+
+namespace Charis {
+
+    GeometryArena::GeometryArena(const std::vector<unsigned int>& floatsPerAttributePerVertex, unsigned int initialVertexCapacity, unsigned int initialIndexCapacity)
+    {
+        Helper::RuntimeAssert(!floatsPerAttributePerVertex.empty(), "Must provide attribute float sizes.");
+        Helper::RuntimeAssert(initialVertexCapacity > 0 && initialIndexCapacity > 0, "Geometry arena capacities must be positive.");
+
+        m->FloatsPerAttributePerVertex = floatsPerAttributePerVertex;
+        m->FloatsPerVertex = std::reduce(floatsPerAttributePerVertex.begin(), floatsPerAttributePerVertex.end());
+        glGenVertexArrays(1, &m->VAO);
+        Rebuild(*m, initialVertexCapacity, initialIndexCapacity);
+    }
+
+    Component GeometryArena::CreateComponent(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const unsigned int* indices, unsigned int numberOfIndices)
+    {
+        Helper::RuntimeAssert(numberOfIndices >= 3, "Must provide at least 3 vertices to model.");
+        Helper::RuntimeAssert(numberOfIndices % 3 == 0, "Number of vertices must be multiple of 3.");
+        Helper::RuntimeAssert(numberOfVertexAttributes % m->FloatsPerVertex == 0, "Vertex attributes must match the layout of the geometry arena.");
+
+        const auto vertices = numberOfVertexAttributes / m->FloatsPerVertex;
+        unsigned int baseVertex{};
+        unsigned int firstIndex{};
+        Reserve(*m, vertices, numberOfIndices, baseVertex, firstIndex);
+
+        // Upload into the reserved ranges
+        const auto vertexBytes = sizeof(float) * m->FloatsPerVertex;
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m->VBO);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, vertexBytes * baseVertex, vertexBytes * vertices, vertexAttributes);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m->IBO);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, sizeof(unsigned int) * firstIndex, sizeof(unsigned int) * numberOfIndices, indices);
+        PrivateGlobal::Statistics::CountUpload(vertexBytes * vertices);
+        PrivateGlobal::Statistics::CountUpload(sizeof(unsigned int) * numberOfIndices);
+
+        Component component;
+        auto& member = *component.m;
+        member.VAO = m->VAO;
+        member.NumberOfAttributes = static_cast<unsigned int>(m->FloatsPerAttributePerVertex.size());
+        member.NumberOfVertices = vertices;
+        member.VBO = m->VBO;
+        member.UsingIBO = true;
+        member.NumberOfIndices = numberOfIndices;
+        member.IBO = m->IBO;
+        member.Arena = m;
+        member.BaseVertex = baseVertex;
+        member.FirstIndex = firstIndex;
+        Component::ComputeBounds(member, vertexAttributes, vertices, static_cast<unsigned int>(vertexBytes), { VertexAttribute::Float, m->FloatsPerAttributePerVertex[0], false });
+        m->Residents.push_back(&member);
+
+        return component;
+    }
+
+    void GeometryArena::Compact()
+    {
+        Rebuild(*m, m->VertexCapacity, m->IndexCapacity);
+    }
+
+    GeometryArena::Usage GeometryArena::CurrentUsage() const
+    {
+        auto usage = Usage{};
+        usage.VertexCapacity = m->VertexCapacity;
+        usage.VerticesUsed = m->VertexCapacity - FreeSpace(m->FreeVertices);
+        usage.IndexCapacity = m->IndexCapacity;
+        usage.IndicesUsed = m->IndexCapacity - FreeSpace(m->FreeIndices);
+        usage.FreeBlocks = static_cast<unsigned int>(m->FreeVertices.size() + m->FreeIndices.size());
+        return usage;
+    }
+
+    void GeometryArena::Release(Component::ModelComponentMember& component)
+    {
+        auto& arena = *component.Arena;
+        Free(arena.FreeVertices, component.BaseVertex, component.NumberOfVertices);
+        Free(arena.FreeIndices, component.FirstIndex, component.NumberOfIndices);
+
+        auto resident = std::find(arena.Residents.begin(), arena.Residents.end(), &component);
+        if (resident != arena.Residents.end()) {
+            *resident = arena.Residents.back();
+            arena.Residents.pop_back();
+        }
+    }
+
+    void GeometryArenaMember::DeleteObjects()
+    {
+        PrivateGlobal::GLState::ForgetVertexArray(VAO);
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &IBO);
+        if (IndirectBuffer != 0)
+            glDeleteBuffers(1, &IndirectBuffer);
+    }
+
+}
\ No newline at end of file
@@ -1,86 +1,392 @@
-#include "Initialize.h"
-#include "Utility.h"
-#include "Private/CharisGlobals.hpp"
-#include "External/stb_image.h"
-#include <iostream>
-
-// Libraries
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
-{
-    // make sure the viewport matches the new window dimensions; note that width and height will be significantly larger than specified on retina displays.
-    glViewport(0, 0, width, height);
-    // Set global variables
-    Charis::PrivateGlobal::Window::Width = static_cast<unsigned int>(width);
-    Charis::PrivateGlobal::Window::Height = static_cast<unsigned int>(height);
-}
-static void mouse_callback(GLFWwindow* window, double xPosIn, double yPosIn)
-{
-    Charis::PrivateGlobal::Mouse::X = static_cast<float>(xPosIn);
-    Charis::PrivateGlobal::Mouse::Y = static_cast<float>(yPosIn);
-}
-static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
-{
-    Charis::PrivateGlobal::Mouse::Wheel += static_cast<float>(yoffset);
-}
-
-namespace Charis {
-
-	void Initialize(unsigned int width, unsigned int height, const std::string& name)
-	{
-        // glfw: initialize and configure
-		Helper::RuntimeAssert(glfwInit() == GLFW_TRUE, "Failed to initialize GLFW.");
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#ifdef __APPLE__
-		glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-        // Set global variables
-        PrivateGlobal::Window::Width = width;
-        PrivateGlobal::Window::Height = height;
-		// glfw window creation
-		PrivateGlobal::Window = glfwCreateWindow(width, height, name.data(), NULL, NULL);
-		Helper::RuntimeAssert(PrivateGlobal::Window != NULL, "Failed to create GLFW window.");
-        glfwMakeContextCurrent(PrivateGlobal::Window);
-        glfwSetFramebufferSizeCallback(PrivateGlobal::Window, framebuffer_size_callback);
-        glfwSetCursorPosCallback(PrivateGlobal::Window, mouse_callback);
-        glfwSetScrollCallback(PrivateGlobal::Window, scroll_callback);
-		
-        // glad: load all OpenGL function pointers
-        Helper::RuntimeAssert(gladLoadGLLoader((GLADloadproc)glfwGetProcAddress), "Failed to initialize GLAD.");
-
-        // configure global opengl state
-        glEnable(GL_DEPTH_TEST);
-
-        // tell stb_image.h to flip loaded texture's on the y-axis
-        stbi_set_flip_vertically_on_load(true);
-	}
-
-    void StartFrame()
-    {
-        const auto& RGB = PrivateGlobal::BackgroundRGB;
-        glClearColor(RGB[0], RGB[1], RGB[2], 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    }
-
-    void EndFrame()
-    {
-        glfwSwapBuffers(PrivateGlobal::Window);
-        glfwPollEvents();
-    }
-
-    bool WindowIsOpen()
-    {
-        return !glfwWindowShouldClose(PrivateGlobal::Window);
-    }
-
-    void CleanUp()
-    {
-        // glfw: terminate, clearing all previously allocated GLFW resources
-        glfwTerminate();
-    }
-
+#include "Initialize.h"
+#include "Utility.h"
+#include "Profiler.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/GLExtensions.hpp"
+#include "Private/AsyncLoading.hpp"
+#include "Private/FrameConstants.hpp"
+#include "Private/Profiling.hpp"
+#include "External/stb_image.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+// Libraries
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    // make sure the viewport matches the new window dimensions; note that width and height will be significantly larger than specified on retina displays.
+    glViewport(0, 0, width, height);
+    // Set global variables
+    Charis::PrivateGlobal::Window::Width = static_cast<unsigned int>(width);
+    Charis::PrivateGlobal::Window::Height = static_cast<unsigned int>(height);
+}
+static void mouse_callback(GLFWwindow* window, double xPosIn, double yPosIn)
+{
+    Charis::PrivateGlobal::Mouse::X = static_cast<float>(xPosIn);
+    Charis::PrivateGlobal::Mouse::Y = static_cast<float>(yPosIn);
+}
+static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    Charis::PrivateGlobal::Mouse::Wheel += static_cast<float>(yoffset);
+}
+
+static void APIENTRY debug_message_callback(GLenum /*source*/, GLenum /*type*/, GLuint /*id*/, GLenum severity, GLsizei length, const GLchar* message, const void* /*userParam*/)
+{
+    using Charis::Utility::DiagnosticSeverity;
+    namespace PrivateGL = Charis::PrivateGL;
+    const auto diagnosticSeverity = severity == PrivateGL::DEBUG_SEVERITY_HIGH ? DiagnosticSeverity::Error
+        : severity == PrivateGL::DEBUG_SEVERITY_NOTIFICATION ? DiagnosticSeverity::Notification : DiagnosticSeverity::Warning;
+    Charis::PrivateGlobal::Diagnose(diagnosticSeverity, std::string("GL: ") + std::string(message, length > 0 ? length : std::strlen(message)));
+}
+
+// Creates the framebuffer object that headless contexts render into, and leaves it bound.
+static void CreateOffscreenTarget(unsigned int width, unsigned int height)
+{
+    using Offscreen = Charis::PrivateGlobal::Offscreen;
+    glGenRenderbuffers(1, &Offscreen::ColorRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, Offscreen::ColorRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &Offscreen::DepthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, Offscreen::DepthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &Offscreen::FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, Offscreen::FBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, Offscreen::ColorRBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, Offscreen::DepthRBO);
+    Charis::Helper::RuntimeAssert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to create offscreen framebuffer.");
+    glViewport(0, 0, width, height);
+}
+
+static void ReadBackFrame()
+{
+    using Charis::PrivateGlobal::Readback;
+    const auto width = Charis::PrivateGlobal::Window::Width;
+    const auto height = Charis::PrivateGlobal::Window::Height;
+    Readback::Pixels.resize(4 * static_cast<size_t>(width) * height);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, Readback::Pixels.data());
+    Readback::Sink(Readback::Pixels.data(), width, height);
+}
+
+// Fills the FrameConstants uniform block with one upload, and keeps the view for picking levels of detail and culling meshlets.
+static void UpdateFrameConstants(const Charis::FrameView& view, const Charis::FrameLights& lights)
+{
+    using namespace Charis;
+    using Buffer = PrivateGlobal::FrameConstantsBuffer;
+
+    auto constants = PrivateGlobal::Std140FrameConstants{};
+    constants.View = view.View;
+    constants.Projection = view.Projection;
+    constants.ViewProjection = view.Projection * view.View;
+    constants.CameraPosition = view.CameraPosition;
+    constants.Time = Utility::GetTime();
+    constants.Viewport = glm::vec2(PrivateGlobal::Window::Width, PrivateGlobal::Window::Height);
+
+    const auto& directional = lights.Directional;
+    constants.Directional = { directional.Direction, 0.0f, directional.Ambient, 0.0f, directional.Diffuse, 0.0f, directional.Specular, 0.0f };
+    const auto pointLightCount = std::min<size_t>(lights.PointLights.size(), FrameConstants::MaxPointLights);
+    constants.PointLightCount = static_cast<int>(pointLightCount);
+    for (size_t i = 0; i < pointLightCount; i++) {
+        const auto& light = lights.PointLights[i];
+        constants.PointLights[i] = { light.Position, light.Constant, light.Ambient, light.Linear, light.Diffuse, light.Quadratic, light.Specular, 0.0f };
+    }
+
+    // Every frame in flight has its own constants, so writing them never waits for the GPU to finish reading those of an earlier frame
+    if (Buffer::UBO == 0) {
+        auto alignment = GLint{};
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = std::max(alignment, 1);
+        Buffer::Stride = (sizeof(constants) + alignment - 1) / alignment * alignment;
+        glGenBuffers(1, &Buffer::UBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, Buffer::UBO);
+        glBufferData(GL_UNIFORM_BUFFER, Buffer::Stride * PrivateGlobal::FrameSync::MaxFramesInFlight, nullptr, GL_DYNAMIC_DRAW);
+    }
+    const auto offset = Buffer::Stride * PrivateGlobal::FrameSync::Current;
+    glBindBuffer(GL_UNIFORM_BUFFER, Buffer::UBO);
+    auto mapped = glMapBufferRange(GL_UNIFORM_BUFFER, offset, sizeof(constants), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (mapped == nullptr)
+        Helper::RuntimeAssert(false, "Failed to map frame constants buffer.");
+    std::memcpy(mapped, &constants, sizeof(constants));
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
+    glBindBufferRange(GL_UNIFORM_BUFFER, FrameConstants::BindingPoint, Buffer::UBO, offset, sizeof(constants));
+    PrivateGlobal::Statistics::CountUpload(sizeof(constants));
+
+    PrivateGlobal::CurrentView::View = view;
+    PrivateGlobal::CurrentView::Given = true;
+}
+
+static float MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Waits for the GPU to finish the frame that last used the per frame buffers of the current frame, then deletes its fence.
+static void WaitForFrame(unsigned int frame)
+{
+    auto& fence = Charis::PrivateGlobal::FrameSync::Fences[frame];
+    if (fence == nullptr)
+        return;
+    // the first wait flushes the fence to the GPU, so it is bound to signal and later waits need not flush again
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    constexpr GLuint64 timeout = 1'000'000'000;
+    while (glClientWaitSync(fence, flags, timeout) == GL_TIMEOUT_EXPIRED)
+        flags = 0;
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+// Sleeps until the target frame rate allows the next frame to start, then samples input. Sleeping ends a millisecond early 
+// and spins for the rest, since sleeps overshoot by up to the timer resolution of the system.
+static void PaceFrame()
+{
+    using namespace std::chrono;
+    using Sync = Charis::PrivateGlobal::FrameSync;
+    const auto start = steady_clock::now();
+    if (Sync::Pacing.TargetFPS > 0.0f) {
+        const auto frameTime = duration_cast<steady_clock::duration>(duration<double>(1.0 / Sync::Pacing.TargetFPS));
+        const auto target = Sync::FrameStart + frameTime;
+        if (target - start > milliseconds(1))
+            std::this_thread::sleep_until(target - milliseconds(1));
+        while (steady_clock::now() < target) {}
+        // a frame that ran more than a frame late starts the schedule over instead of rushing the next frames to catch up
+        const auto now = steady_clock::now();
+        Sync::FrameStart = now - target > frameTime ? now : target;
+    }
+    else {
+        Sync::FrameStart = start;
+    }
+    glfwPollEvents();
+    Sync::PacePending = false;
+    Charis::PrivateGlobal::Statistics::Current.CpuWaitMilliseconds += MillisecondsSince(start);
+}
+
+// Routes KHR_debug messages to the diagnostic handler. The paranoid check level reports them from the call that caused them, and low severity ones too.
+static void EnableDebugOutput()
+{
+    namespace PrivateGL = Charis::PrivateGL;
+    if (CHARIS_CHECK_LEVEL == CHARIS_CHECK_OFF || !PrivateGL::DebugMessageCallback || !PrivateGL::DebugMessageControl)
+        return;
+
+    glEnable(PrivateGL::DEBUG_OUTPUT);
+    if (CHARIS_CHECK_LEVEL >= CHARIS_CHECK_PARANOID)
+        glEnable(PrivateGL::DEBUG_OUTPUT_SYNCHRONOUS);
+    PrivateGL::DebugMessageCallback(debug_message_callback, nullptr);
+    PrivateGL::DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, PrivateGL::DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+    if (CHARIS_CHECK_LEVEL < CHARIS_CHECK_PARANOID)
+        PrivateGL::DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, PrivateGL::DEBUG_SEVERITY_LOW, 0, nullptr, GL_FALSE);
+}
+
+namespace Charis {
+
+	void Initialize(unsigned int width, unsigned int height, const std::string& name, ContextMode mode)
+	{
+        // resources released after an earlier CleanUp lost their context with it, their names could belong to objects of the new one
+        PrivateGlobal::DestroyReleasedResources(false);
+        const bool headless = mode != Windowed;
+        PrivateGlobal::Offscreen::Headless = headless;
+
+        // glfw: initialize and configure, headless contexts use the null platform which never opens a display
+        glfwInitHint(GLFW_PLATFORM, headless ? GLFW_PLATFORM_NULL : GLFW_ANY_PLATFORM);
+		Helper::RuntimeAssert(glfwInit() == GLFW_TRUE, "Failed to initialize GLFW.");
+		if (headless) {
+			// Software drivers may not reach 4.6, Charis only needs 3.3 and loads anything newer as optional extensions
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, mode == HeadlessEGL ? GLFW_EGL_CONTEXT_API : GLFW_OSMESA_CONTEXT_API);
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		}
+		else {
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+		}
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		// a debug context reports more, and more precisely, at some cost to the driver
+		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, CHARIS_CHECK_LEVEL >= CHARIS_CHECK_PARANOID ? GLFW_TRUE : GLFW_FALSE);
+#ifdef __APPLE__
+		glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+        // Set global variables
+        PrivateGlobal::Window::Width = width;
+        PrivateGlobal::Window::Height = height;
+		// glfw window creation
+		PrivateGlobal::Window = glfwCreateWindow(width, height, name.data(), NULL, NULL);
+		Helper::RuntimeAssert(PrivateGlobal::Window != NULL, headless ? "Failed to create headless GL context." : "Failed to create GLFW window.");
+        glfwMakeContextCurrent(PrivateGlobal::Window);
+        if (!headless)
+            glfwSetFramebufferSizeCallback(PrivateGlobal::Window, framebuffer_size_callback);
+        glfwSetCursorPosCallback(PrivateGlobal::Window, mouse_callback);
+        glfwSetScrollCallback(PrivateGlobal::Window, scroll_callback);
+		
+        // glad: load all OpenGL function pointers
+        Helper::RuntimeAssert(gladLoadGLLoader((GLADloadproc)glfwGetProcAddress), "Failed to initialize GLAD.");
+        PrivateGL::LoadExtensions();
+        EnableDebugOutput();
+
+        // headless contexts have no default framebuffer, so every frame goes into an offscreen one
+        if (headless)
+            CreateOffscreenTarget(width, height);
+
+        // configure global opengl state
+        PrivateGlobal::GLState::SetDepthTest(true);
+
+        // tell stb_image.h to flip loaded texture's on the y-axis
+        stbi_set_flip_vertically_on_load(true);
+	}
+
+    void StartFrame()
+    {
+        // late input sampling paces here, so the frame is built from input sampled right before it
+        if (PrivateGlobal::FrameSync::PacePending)
+            PaceFrame();
+        CHARIS_PROFILE_GPU_ZONE("StartFrame");
+        const auto& RGB = PrivateGlobal::BackgroundRGB;
+        PrivateGlobal::GLState::SetClearColor({ RGB[0], RGB[1], RGB[2], 1.0f });
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        PrivateGlobal::Statistics::CountCall();
+
+        // create the GL objects of models loaded in the background
+        PrivateGlobal::UploadQueue::Drain();
+    }
+
+    void StartFrame(const Camera& camera, const FrameLights& lights)
+    {
+        StartFrame({ camera.ViewMatrix(), camera.ProjectionMatrix(), camera.Position }, lights);
+    }
+
+    void StartFrame(const FrameView& view, const FrameLights& lights)
+    {
+        StartFrame();
+        UpdateFrameConstants(view, lights);
+    }
+
+    void EndFrame()
+    {
+        if (PrivateGlobal::Readback::Sink)
+            ReadBackFrame();
+
+        using Sync = PrivateGlobal::FrameSync;
+        auto& statistics = PrivateGlobal::Statistics::Current;
+        {
+            CHARIS_PROFILE_ZONE("SwapBuffers");
+            const auto start = std::chrono::steady_clock::now();
+            // there is nothing to present without a window, flushing keeps the frames moving through the driver instead
+            if (PrivateGlobal::Offscreen::Headless)
+                glFlush();
+            else
+                glfwSwapBuffers(PrivateGlobal::Window);
+            statistics.CpuWaitMilliseconds += MillisecondsSince(start);
+        }
+        {
+            CHARIS_PROFILE_ZONE("WaitForGPU");
+            // fence this frame, then wait for the oldest frame in flight, whose per frame buffers the next frame writes
+            Sync::Fences[Sync::Current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            Sync::Current = (Sync::Current + 1) % Sync::Pacing.FramesInFlight;
+            Sync::Frame++;
+            const auto start = std::chrono::steady_clock::now();
+            WaitForFrame(Sync::Current);
+            statistics.GpuWaitMilliseconds = MillisecondsSince(start);
+            PrivateGlobal::InstanceBuffers::Used[Sync::Current] = 0;
+        }
+        {
+            CHARIS_PROFILE_ZONE("DestroyReleasedResources");
+            PrivateGlobal::DestroyReleasedResources(true);
+        }
+        if (Sync::Pacing.LateInputSampling)
+            Sync::PacePending = true;
+        else
+            PaceFrame();
+        PrivateGlobal::ProfileFrame(statistics);
+        PrivateGlobal::Statistics::EndFrame();
+        PrivateGlobal::ShaderCompilation::WaitedThisFrame = false;
+    }
+
+    void SetFramePacing(const FramePacing& pacing)
+    {
+        using Sync = PrivateGlobal::FrameSync;
+        Helper::RuntimeAssert(PrivateGlobal::Window != nullptr, "Initialize Charis before setting the frame pacing.");
+        Helper::RuntimeAssert(pacing.FramesInFlight >= 1 && pacing.FramesInFlight <= Sync::MaxFramesInFlight, "Frames in flight must be between 1 and " + std::to_string(Sync::MaxFramesInFlight) + ".");
+        Helper::RuntimeAssert(pacing.TargetFPS >= 0.0f, "Target frame rate can not be negative.");
+
+        // the per frame buffers are shared out anew, so no frame may still use them
+        for (unsigned int frame = 0; frame < Sync::MaxFramesInFlight; frame++)
+            WaitForFrame(frame);
+        Sync::Current = 0;
+        Sync::Frame++;
+        PrivateGlobal::InstanceBuffers::Used = {};
+        Sync::Pacing = pacing;
+        Sync::FrameStart = std::chrono::steady_clock::now();
+        if (!pacing.LateInputSampling)
+            Sync::PacePending = false;
+
+        if (!PrivateGlobal::Offscreen::Headless) {
+            const bool lateSwaps = glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear");
+            switch (pacing.Mode) {
+            case PresentMode::Immediate: glfwSwapInterval(0); break;
+            case PresentMode::VSync: glfwSwapInterval(1); break;
+            case PresentMode::AdaptiveSync: glfwSwapInterval(lateSwaps ? -1 : 1); break;
+            }
+        }
+    }
+
+    void SetFrameReadback(FrameReadback readback)
+    {
+        PrivateGlobal::Readback::Sink = std::move(readback);
+        if (!PrivateGlobal::Readback::Sink)
+            PrivateGlobal::Readback::Pixels = {};
+    }
+
+    bool WindowIsOpen()
+    {
+        return !glfwWindowShouldClose(PrivateGlobal::Window);
+    }
+
+    void CleanUp()
+    {
+        // stop background loading first, the dropped uploads own GL objects that must go before the context
+        PrivateGlobal::WorkerPool::Stop();
+        PrivateGlobal::UploadQueue::Clear();
+        PrivateGlobal::DestroyReleasedResources(true);
+
+        for (auto& vbo : PrivateGlobal::InstanceBuffers::VBO) {
+            if (vbo != 0)
+                glDeleteBuffers(1, &vbo);
+            vbo = 0;
+        }
+        PrivateGlobal::InstanceBuffers::Capacity = {};
+        PrivateGlobal::InstanceBuffers::Used = {};
+        for (auto& fence : PrivateGlobal::FrameSync::Fences) {
+            if (fence != nullptr)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+        PrivateGlobal::FrameSync::Current = 0;
+        PrivateGlobal::FrameSync::PacePending = false;
+        PrivateGlobal::ReleaseProfilerQueries();
+        PrivateGlobal::GLState::Reset();
+
+        using Offscreen = PrivateGlobal::Offscreen;
+        if (Offscreen::Headless) {
+            glDeleteFramebuffers(1, &Offscreen::FBO);
+            glDeleteRenderbuffers(1, &Offscreen::ColorRBO);
+            glDeleteRenderbuffers(1, &Offscreen::DepthRBO);
+            Offscreen::FBO = Offscreen::ColorRBO = Offscreen::DepthRBO = 0;
+            Offscreen::Headless = false;
+        }
+        if (PrivateGlobal::FrameConstantsBuffer::UBO != 0)
+            glDeleteBuffers(1, &PrivateGlobal::FrameConstantsBuffer::UBO);
+        PrivateGlobal::FrameConstantsBuffer::UBO = 0;
+        PrivateGlobal::FrameConstantsBuffer::Stride = 0;
+        PrivateGlobal::Readback::Sink = {};
+        PrivateGlobal::Readback::Pixels = {};
+
+        // glfw: terminate, clearing all previously allocated GLFW resources
+        glfwTerminate();
+    }
+
 }
\ No newline at end of file
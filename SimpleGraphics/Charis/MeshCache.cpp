@@ -0,0 +1,367 @@
+#include "Private/MeshCache.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <system_error>
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using namespace Charis::PrivateGlobal;
+
+    constexpr char Magic[8] = { 'C', 'H', 'A', 'R', 'M', 'E', 'S', 'H' };
+    constexpr std::uint32_t Version = 1;
+    // Blobs start on page boundaries, which also satisfies the alignment of the vertex and index types
+    constexpr std::uint64_t PageSize = 4096;
+
+    // File layout: header, table, then page aligned vertex and index blobs of every mesh.
+    // The table holds the texture table (count, then type, name length and name per texture)
+    // followed per mesh by vertex offset and count, index offset and count, and the indices of its textures in the texture table.
+    struct Header {
+        char Magic[8];
+        std::uint32_t Version;
+        std::uint32_t ImportFlags;
+        std::uint32_t VertexSize;
+        std::uint32_t MeshCount;
+        std::uint64_t SourceSize;
+        std::int64_t SourceTime;
+        std::uint64_t SourceHash;
+        std::uint64_t TableSize;
+    };
+
+    struct SourceKey {
+        std::uint64_t Size{};
+        std::int64_t Time{};
+    };
+
+    std::string CachePath(const std::string& modelPath)
+    {
+        return modelPath + ".charismesh";
+    }
+
+    bool ReadSourceKey(const std::string& modelPath, SourceKey& key)
+    {
+        std::error_code error;
+        key.Size = std::filesystem::file_size(modelPath, error);
+        if (error)
+            return false;
+        key.Time = std::filesystem::last_write_time(modelPath, error).time_since_epoch().count();
+        return !error;
+    }
+
+    // FNV-1a over the whole model file, used when the modification time changed but the content may not have
+    std::uint64_t HashSource(const std::string& modelPath)
+    {
+        const auto source = MappedFile(modelPath);
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const auto byte : source.Bytes()) {
+            hash ^= byte;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::uint64_t AlignToPage(std::uint64_t offset)
+    {
+        return (offset + PageSize - 1) / PageSize * PageSize;
+    }
+
+    // Appends plain values to a byte buffer
+    struct Writer {
+        std::vector<unsigned char> Bytes;
+
+        template<typename T>
+        void Write(const T& value)
+        {
+            const auto size = Bytes.size();
+            Bytes.resize(size + sizeof(T));
+            std::memcpy(Bytes.data() + size, &value, sizeof(T));
+        }
+        void Write(const std::string& text)
+        {
+            Write(static_cast<std::uint32_t>(text.size()));
+            Bytes.insert(Bytes.end(), text.begin(), text.end());
+        }
+    };
+
+    // Reads plain values from a byte range, failing instead of reading past its end
+    struct Reader {
+        std::span<const unsigned char> Bytes;
+        size_t Offset{};
+        bool Failed = false;
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            if (Offset + sizeof(T) > Bytes.size()) {
+                Failed = true;
+                return value;
+            }
+            std::memcpy(&value, Bytes.data() + Offset, sizeof(T));
+            Offset += sizeof(T);
+            return value;
+        }
+        std::string ReadString()
+        {
+            const auto length = Read<std::uint32_t>();
+            if (Failed || Offset + length > Bytes.size()) {
+                Failed = true;
+                return {};
+            }
+            auto text = std::string(reinterpret_cast<const char*>(Bytes.data() + Offset), length);
+            Offset += length;
+            return text;
+        }
+    };
+
+    // Writes a new cache file of the given size next to the cache and renames it over the cache, so a concurrent load never maps a half written file.
+    // Failing is not an error, the cache is then just left as it was.
+    template<typename WriteFunction>
+    void ReplaceCacheFile(const std::string& cachePath, std::uint64_t size, WriteFunction write)
+    {
+        const auto temporaryPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return;
+            write(file);
+        }
+        if (std::error_code error; !std::filesystem::exists(temporaryPath, error) || std::filesystem::file_size(temporaryPath, error) != size) {
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        if (error)
+            std::filesystem::remove(temporaryPath, error);
+    }
+
+    template<typename T>
+    bool BlobFits(std::span<const unsigned char> file, std::uint64_t offset, std::uint64_t count)
+    {
+        return offset % alignof(T) == 0 && offset <= file.size() && count <= (file.size() - offset) / sizeof(T);
+    }
+
+}
+
+namespace Charis {
+
+    namespace PrivateGlobal {
+
+#ifdef _WIN32
+        MappedFile::MappedFile(const std::string& path)
+        {
+            // sharing deletion lets a refreshed cache be renamed over a file that is still mapped
+            const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return;
+            m_File = file;
+
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+                return;
+            m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_Mapping == nullptr)
+                return;
+            m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+            if (m_Data != nullptr)
+                m_Size = static_cast<size_t>(size.QuadPart);
+        }
+
+        MappedFile::~MappedFile()
+        {
+            if (m_Data != nullptr)
+                UnmapViewOfFile(m_Data);
+            if (m_Mapping != nullptr)
+                CloseHandle(m_Mapping);
+            if (m_File != nullptr)
+                CloseHandle(m_File);
+        }
+#else
+        MappedFile::MappedFile(const std::string& path)
+        {
+            const int file = open(path.c_str(), O_RDONLY);
+            if (file == -1)
+                return;
+
+            struct stat status{};
+            if (fstat(file, &status) == 0 && status.st_size > 0) {
+                void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+                if (data != MAP_FAILED) {
+                    m_Data = static_cast<const unsigned char*>(data);
+                    m_Size = static_cast<size_t>(status.st_size);
+                }
+            }
+            // the mapping stays valid after the file is closed
+            close(file);
+        }
+
+        MappedFile::~MappedFile()
+        {
+            if (m_Data != nullptr)
+                munmap(const_cast<unsigned char*>(m_Data), m_Size);
+        }
+#endif
+
+        bool ReadMeshCache(const std::string& modelPath, std::uint32_t importFlags, SceneData& sceneData)
+        {
+            SourceKey key;
+            if (!ReadSourceKey(modelPath, key))
+                return false;
+
+            auto cache = std::make_shared<MappedFile>(CachePath(modelPath));
+            const auto file = cache->Bytes();
+            if (file.size() < sizeof(Header))
+                return false;
+
+            Header header;
+            std::memcpy(&header, file.data(), sizeof(Header));
+            if (std::memcmp(header.Magic, Magic, sizeof(Magic)) != 0 || header.Version != Version)
+                return false;
+            if (header.ImportFlags != importFlags || header.VertexSize != sizeof(VertexAttributes) || header.SourceSize != key.Size)
+                return false;
+            // a new modification time with the same content, for example after a checkout, still hits
+            if (header.SourceTime != key.Time && header.SourceHash != HashSource(modelPath))
+                return false;
+            if (header.TableSize > file.size() - sizeof(Header))
+                return false;
+
+            auto reader = Reader{ .Bytes = file.subspan(sizeof(Header), header.TableSize) };
+            SceneData scene;
+
+            const auto textureCount = reader.Read<std::uint32_t>();
+            for (std::uint32_t i = 0; i < textureCount && !reader.Failed; i++) {
+                const auto type = reader.Read<std::uint32_t>();
+                auto name = reader.ReadString();
+                if (type > Texture::Null)
+                    return false;
+                scene.TextureFiles.push_back({ std::move(name), static_cast<Texture::TextureType>(type) });
+            }
+
+            for (std::uint32_t i = 0; i < header.MeshCount && !reader.Failed; i++) {
+                const auto vertexOffset = reader.Read<std::uint64_t>();
+                const auto vertexCount = reader.Read<std::uint64_t>();
+                const auto indexOffset = reader.Read<std::uint64_t>();
+                const auto indexCount = reader.Read<std::uint64_t>();
+                if (!BlobFits<VertexAttributes>(file, vertexOffset, vertexCount) || !BlobFits<unsigned int>(file, indexOffset, indexCount))
+                    return false;
+
+                auto& mesh = scene.Meshes.emplace_back();
+                mesh.Vertices = { reinterpret_cast<const VertexAttributes*>(file.data() + vertexOffset), static_cast<size_t>(vertexCount) };
+                mesh.Indices = { reinterpret_cast<const unsigned int*>(file.data() + indexOffset), static_cast<size_t>(indexCount) };
+
+                const auto meshTextureCount = reader.Read<std::uint32_t>();
+                for (std::uint32_t j = 0; j < meshTextureCount && !reader.Failed; j++) {
+                    const auto texture = reader.Read<std::uint32_t>();
+                    if (texture >= scene.TextureFiles.size())
+                        return false;
+                    mesh.TextureFiles.push_back(scene.TextureFiles[texture].first);
+                }
+            }
+            if (reader.Failed)
+                return false;
+
+            // the hash confirmed the content, store the new modification time so that later loads do not hash the model file again
+            if (header.SourceTime != key.Time) {
+                auto refreshed = header;
+                refreshed.SourceTime = key.Time;
+                ReplaceCacheFile(CachePath(modelPath), file.size(), [&](std::ofstream& out) {
+                    out.write(reinterpret_cast<const char*>(&refreshed), sizeof(Header));
+                    out.write(reinterpret_cast<const char*>(file.data() + sizeof(Header)), static_cast<std::streamsize>(file.size() - sizeof(Header)));
+                });
+            }
+
+            scene.Directory = std::move(sceneData.Directory);
+            scene.Cache = std::move(cache);
+            sceneData = std::move(scene);
+            return true;
+        }
+
+        void WriteMeshCache(const std::string& modelPath, std::uint32_t importFlags, const SceneData& sceneData)
+        {
+            SourceKey key;
+            if (!ReadSourceKey(modelPath, key))
+                return;
+
+            // Texture table, then the meshes with blob offsets counted from the first page after header and table
+            Writer table;
+            table.Write(static_cast<std::uint32_t>(sceneData.TextureFiles.size()));
+            for (const auto& [name, type] : sceneData.TextureFiles) {
+                table.Write(static_cast<std::uint32_t>(type));
+                table.Write(name);
+            }
+
+            size_t tableSize = table.Bytes.size();
+            for (const auto& mesh : sceneData.Meshes)
+                tableSize += 4 * sizeof(std::uint64_t) + sizeof(std::uint32_t) * (1 + mesh.TextureFiles.size());
+
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> blobOffsets;
+            auto offset = AlignToPage(sizeof(Header) + tableSize);
+            for (const auto& mesh : sceneData.Meshes) {
+                const auto vertexOffset = offset;
+                offset = AlignToPage(vertexOffset + mesh.Vertices.size_bytes());
+                const auto indexOffset = offset;
+                offset = AlignToPage(indexOffset + mesh.Indices.size_bytes());
+                blobOffsets.push_back({ vertexOffset, indexOffset });
+            }
+
+            for (size_t i = 0; i < sceneData.Meshes.size(); i++) {
+                const auto& mesh = sceneData.Meshes[i];
+                table.Write(blobOffsets[i].first);
+                table.Write(static_cast<std::uint64_t>(mesh.Vertices.size()));
+                table.Write(blobOffsets[i].second);
+                table.Write(static_cast<std::uint64_t>(mesh.Indices.size()));
+                table.Write(static_cast<std::uint32_t>(mesh.TextureFiles.size()));
+                for (const auto& name : mesh.TextureFiles) {
+                    const auto texture = std::find_if(sceneData.TextureFiles.begin(), sceneData.TextureFiles.end(), [&](const auto& file) { return file.first == name; });
+                    table.Write(static_cast<std::uint32_t>(texture - sceneData.TextureFiles.begin()));
+                }
+            }
+
+            Header header{};
+            std::memcpy(header.Magic, Magic, sizeof(Magic));
+            header.Version = Version;
+            header.ImportFlags = importFlags;
+            header.VertexSize = sizeof(VertexAttributes);
+            header.MeshCount = static_cast<std::uint32_t>(sceneData.Meshes.size());
+            header.SourceSize = key.Size;
+            header.SourceTime = key.Time;
+            header.SourceHash = HashSource(modelPath);
+            header.TableSize = table.Bytes.size();
+
+            ReplaceCacheFile(CachePath(modelPath), offset, [&](std::ofstream& file) {
+                const auto pad = [&](std::uint64_t to) {
+                    static constexpr char zeros[PageSize] = {};
+                    const auto position = static_cast<std::uint64_t>(file.tellp());
+                    file.write(zeros, static_cast<std::streamsize>(to - position));
+                };
+                file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+                file.write(reinterpret_cast<const char*>(table.Bytes.data()), static_cast<std::streamsize>(table.Bytes.size()));
+                for (size_t i = 0; i < sceneData.Meshes.size(); i++) {
+                    const auto& mesh = sceneData.Meshes[i];
+                    pad(blobOffsets[i].first);
+                    file.write(reinterpret_cast<const char*>(mesh.Vertices.data()), static_cast<std::streamsize>(mesh.Vertices.size_bytes()));
+                    pad(blobOffsets[i].second);
+                    file.write(reinterpret_cast<const char*>(mesh.Indices.data()), static_cast<std::streamsize>(mesh.Indices.size_bytes()));
+                }
+                pad(offset);
+            });
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "Meshlets.h"
+#include "Utility.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace {
+
+    constexpr unsigned int None = ~0u;
+
+    // Fills the sphere and normal cone of a meshlet from its triangles.
+    void ComputeMeshletBounds(Charis::Meshlet& meshlet, const float* vertexAttributes, unsigned int floatsPerVertex, const std::vector<unsigned int>& indices)
+    {
+        const auto positionOf = [&](unsigned int vertex) {
+            const auto position = vertexAttributes + static_cast<size_t>(vertex) * floatsPerVertex;
+            return glm::vec3(position[0], position[1], position[2]);
+        };
+        const auto first = indices.begin() + meshlet.FirstIndex;
+        const auto last = first + meshlet.NumberOfIndices;
+
+        // Centered on the box, like the bounds of components
+        auto box = Charis::BoundingBox{};
+        for (auto index = first; index != last; ++index)
+            box.Add(positionOf(*index));
+        meshlet.Sphere = { box.Center(), 0.0f };
+        for (auto index = first; index != last; ++index)
+            meshlet.Sphere.Radius = std::max(meshlet.Sphere.Radius, glm::length(positionOf(*index) - meshlet.Sphere.Center));
+
+        std::vector<glm::vec3> normals;
+        auto sum = glm::vec3(0.0f);
+        for (auto index = first; index != last; index += 3) {
+            const auto p0 = positionOf(index[0]);
+            const auto normal = glm::cross(positionOf(index[1]) - p0, positionOf(index[2]) - p0);
+            const auto length = glm::length(normal);
+            if (length == 0.0f)
+                continue;
+            normals.push_back(normal / length);
+            sum += normals.back();
+        }
+
+        // Triangles that face more than 90 degrees apart can never all face away at once
+        const auto sumLength = glm::length(sum);
+        if (normals.empty() || sumLength < 1e-6f)
+            return;
+        const auto axis = sum / sumLength;
+        auto smallestDot = 1.0f;
+        for (const auto& normal : normals)
+            smallestDot = std::min(smallestDot, glm::dot(normal, axis));
+        if (smallestDot <= 0.0f)
+            return;
+        meshlet.ConeAxis = axis;
+        meshlet.ConeCutoff = std::sqrt(1.0f - smallestDot * smallestDot);
+    }
+
+}
+
+namespace Charis {
+
+    std::vector<Meshlet> BuildMeshlets(const float* vertexAttributes, unsigned int floatsPerVertex, unsigned int numberOfVertices, std::vector<unsigned int>& indices)
+    {
+        Helper::RuntimeAssert(floatsPerVertex >= 3, "Vertices must start with a three float position.");
+        Helper::RuntimeAssert(indices.size() % 3 == 0, "Number of indices must be a multiple of 3.");
+        CHARIS_ASSERT_PARANOID(std::all_of(indices.begin(), indices.end(), [&](unsigned int index) { return index < numberOfVertices; }), "Indices must refer to vertices.");
+        const auto triangleCount = static_cast<unsigned int>(indices.size() / 3);
+        const auto positionOf = [&](unsigned int vertex) {
+            const auto position = vertexAttributes + static_cast<size_t>(vertex) * floatsPerVertex;
+            return glm::vec3(position[0], position[1], position[2]);
+        };
+
+        // Triangles around every vertex
+        std::vector<unsigned int> triangleStarts(static_cast<size_t>(numberOfVertices) + 1, 0);
+        for (auto index : indices)
+            triangleStarts[index + 1]++;
+        std::partial_sum(triangleStarts.begin(), triangleStarts.end(), triangleStarts.begin());
+        std::vector<unsigned int> vertexTriangles(indices.size());
+        {
+            auto fill = std::vector<unsigned int>(triangleStarts.begin(), triangleStarts.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+                vertexTriangles[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        std::vector<Meshlet> meshlets;
+        std::vector<unsigned int> reordered;
+        reordered.reserve(indices.size());
+        std::vector<bool> used(triangleCount, false);
+        // Meshlet that last took the vertex, and that last queued the triangle as a candidate
+        std::vector<unsigned int> vertexMeshlet(numberOfVertices, None);
+        std::vector<unsigned int> queuedBy(triangleCount, None);
+        std::vector<unsigned int> candidates;
+        unsigned int nextSeed = 0;
+
+        while (reordered.size() < indices.size()) {
+            const auto id = static_cast<unsigned int>(meshlets.size());
+            auto meshlet = Meshlet{};
+            meshlet.FirstIndex = static_cast<unsigned int>(reordered.size());
+            unsigned int vertexCount = 0;
+            auto vertexSum = glm::vec3(0.0f);
+
+            // Continue next to the previous meshlet if it left unused neighbours, so consecutive meshlets stay close
+            auto seed = None;
+            for (auto candidate : candidates) {
+                if (!used[candidate]) {
+                    seed = candidate;
+                    break;
+                }
+            }
+            while (seed == None) {
+                if (!used[nextSeed])
+                    seed = nextSeed;
+                nextSeed++;
+            }
+            candidates.clear();
+
+            const auto newVertices = [&](unsigned int triangle) {
+                unsigned int count = 0;
+                for (int corner = 0; corner < 3; corner++)
+                    count += vertexMeshlet[indices[3 * static_cast<size_t>(triangle) + corner]] != id;
+                return count;
+            };
+            const auto add = [&](unsigned int triangle) {
+                used[triangle] = true;
+                for (int corner = 0; corner < 3; corner++) {
+                    const auto vertex = indices[3 * static_cast<size_t>(triangle) + corner];
+                    reordered.push_back(vertex);
+                    if (vertexMeshlet[vertex] != id) {
+                        vertexMeshlet[vertex] = id;
+                        vertexCount++;
+                        vertexSum += positionOf(vertex);
+                    }
+                    for (auto i = triangleStarts[vertex]; i < triangleStarts[vertex + 1]; i++) {
+                        const auto neighbour = vertexTriangles[i];
+                        if (!used[neighbour] && queuedBy[neighbour] != id) {
+                            queuedBy[neighbour] = id;
+                            candidates.push_back(neighbour);
+                        }
+                    }
+                }
+            };
+
+            add(seed);
+            unsigned int triangles = 1;
+            while (triangles < Meshlet::MaxTriangles) {
+                // The neighbour that adds the fewest vertices, and of those the one closest to the middle of the meshlet, keeps meshlets round
+                const auto center = vertexSum / static_cast<float>(vertexCount);
+                auto best = None;
+                auto bestNew = 4u;
+                auto bestDistance = 0.0f;
+                for (size_t i = 0; i < candidates.size();) {
+                    const auto candidate = candidates[i];
+                    if (used[candidate]) {
+                        candidates[i] = candidates.back();
+                        candidates.pop_back();
+                        continue;
+                    }
+                    i++;
+                    const auto added = newVertices(candidate);
+                    if (vertexCount + added > Meshlet::MaxVertices || added > bestNew)
+                        continue;
+                    const auto index = indices.begin() + 3 * static_cast<size_t>(candidate);
+                    const auto centroid = (positionOf(index[0]) + positionOf(index[1]) + positionOf(index[2])) / 3.0f;
+                    const auto distance = glm::dot(centroid - center, centroid - center);
+                    if (added < bestNew || distance < bestDistance) {
+                        best = candidate;
+                        bestNew = added;
+                        bestDistance = distance;
+                    }
+                    // A triangle between vertices the meshlet already has is free, so there is no need to look further
+                    if (added == 0)
+                        break;
+                }
+                if (best == None)
+                    break;
+                add(best);
+                triangles++;
+            }
+
+            meshlet.NumberOfIndices = 3 * triangles;
+            meshlets.push_back(meshlet);
+        }
+
+        indices = std::move(reordered);
+        for (auto& meshlet : meshlets)
+            ComputeMeshletBounds(meshlet, vertexAttributes, floatsPerVertex, indices);
+        return meshlets;
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Bounds.h"
+#include <vector>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	/// <summary>
+	/// A small cluster of neighbouring triangles of a component, which is culled as a whole, see Shader::DrawMeshlets and CullMeshlets.
+	/// Dense meshes are rarely all in view or all facing the camera, so culling their meshlets saves vertex work that culling the whole component can not.
+	/// </summary>
+	struct Meshlet {
+		// Range of the index buffer of the component, the triangles of a meshlet are next to each other.
+		unsigned int FirstIndex{};
+		unsigned int NumberOfIndices{};
+		// Sphere around the triangles, in model space.
+		BoundingSphere Sphere;
+		// Cone around the normals of the triangles. The angle between any normal and the axis is at most 90 degrees minus the angle whose sine is ConeCutoff.
+		// A cutoff of 1 means the triangles face too many ways for the meshlet to ever be culled as back facing.
+		glm::vec3 ConeAxis{};
+		float ConeCutoff = 1.0f;
+
+		// Limits of a meshlet, small enough that the culling tests stay tight and large enough that there are few meshlets to test.
+		static constexpr unsigned int MaxVertices = 64;
+		static constexpr unsigned int MaxTriangles = 124;
+	};
+
+	/// <summary>
+	/// Splits triangles into meshlets of neighbouring triangles and reorders the indices so the triangles of every meshlet are next to each other.
+	/// Meshlets are grown one triangle at a time, picking the neighbour that adds the fewest new vertices. Pass the result to Component::SetMeshlets.
+	/// </summary>
+	/// <param name="vertexAttributes">Pointer to the vertex attributes, of which the first three floats of every vertex are the position.</param>
+	/// <param name="floatsPerVertex">Number of floats per vertex.</param>
+	/// <param name="numberOfVertices">Number of vertices.</param>
+	/// <param name="indices">Indices to vertices, where every three indices make up a triangle. Reordered in place.</param>
+	std::vector<Meshlet> BuildMeshlets(const float* vertexAttributes, unsigned int floatsPerVertex, unsigned int numberOfVertices, std::vector<unsigned int>& indices);
+
+}
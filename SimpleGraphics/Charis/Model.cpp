@@ -1,226 +1,576 @@
-#include "Model.h"
-#include "Texture.h"
-#include <iostream>
-
-// Libraries
-#include <glm/glm.hpp>
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-
-namespace {
-    using namespace Charis;
-
-	std::string Directory;
-
-    const std::vector<unsigned int> FloatsPerAttribute = { 3, 3, 2, 3, 3 };
-    constexpr unsigned int TotalFloats = 14;
-	struct VertexAttributes {
-        // position
-        glm::vec3 Position;
-        // normal
-        glm::vec3 Normal;
-        // texCoords
-        glm::vec2 TexCoords;
-        // tangent
-        glm::vec3 Tangent;
-        // bitangent
-        glm::vec3 Bitangent;
-
-        //bone indexes which will influence this vertex
-        // int m_BoneIDs[MAX_BONE_INFLUENCE];
-        //weights from each bone
-        // float m_Weights[MAX_BONE_INFLUENCE];
-	};
-
-    struct ModelMemberRefs {
-        std::vector<Component>& components;
-        std::map<std::string, Texture>& loadedTextures;
-    };
-	void LoadModel(const std::string& filepath, ModelMemberRefs& mmr);
-	void ProcessNode(aiNode* node, const aiScene* scene, ModelMemberRefs& mmr);
-	Component ProcessMesh(aiMesh* mesh, const aiScene* scene, ModelMemberRefs& mmr);
-	std::vector<Texture> LoadMaterialTextures(aiMaterial* mat, aiTextureType type, Texture::TextureType textureType, ModelMemberRefs& mmr);
-    Component CreateModelComponentFromVertexAttributes(const std::vector<VertexAttributes>& vertices, const std::vector<unsigned int>& indices, const std::vector<Texture>& textures);
-
-	void LoadModel(const std::string& filepath, ModelMemberRefs& mmr)
-	{
-		// read file via ASSIMP
-		Assimp::Importer importer;
-		const aiScene* scene = importer.ReadFile(filepath, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
-		// check for errors
-		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
-		{
-			std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
-			return;
-		}
-		// retrieve the directory path of the filepath
-		Directory = filepath.substr(0, filepath.find_last_of('/'));
-
-		// process ASSIMP's root node recursively
-		ProcessNode(scene->mRootNode, scene, mmr);
-	}
-
-    void ProcessNode(aiNode* node, const aiScene* scene, ModelMemberRefs& mmr)
-    {
-        // process each mesh located at the current node
-        for (unsigned int i = 0; i < node->mNumMeshes; i++)
-        {
-            // the node object only contains indices to index the actual objects in the scene. 
-            // the scene contains all the data, node is just to keep stuff organized (like relations between nodes).
-            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            mmr.components.push_back(ProcessMesh(mesh, scene, mmr));
-        }
-        // after we've processed all of the meshes (if any) we then recursively process each of the children nodes
-        for (unsigned int i = 0; i < node->mNumChildren; i++)
-        {
-            ProcessNode(node->mChildren[i], scene, mmr);
-        }
-    }
-
-	Component ProcessMesh(aiMesh* mesh, const aiScene* scene, ModelMemberRefs& mmr)
-	{
-        static_assert(sizeof(VertexAttributes) == TotalFloats * sizeof(float));
-
-        // data to fill
-        std::vector<VertexAttributes> vertices;
-        std::vector<unsigned int> indices;
-        std::vector<Texture> textures;
-
-        // walk through each of the mesh's vertices
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-        {
-            VertexAttributes vertex{};
-            glm::vec3 vec{}; // declare a placeholder vector since assimp uses its own vector class that doesn't directly convert to glm's vec3 class so we transfer the data to this placeholder glm::vec3 first.
-            // positions
-            vec.x = mesh->mVertices[i].x;
-            vec.y = mesh->mVertices[i].y;
-            vec.z = mesh->mVertices[i].z;
-            vertex.Position = vec;
-            // normals
-            if (mesh->HasNormals())
-            {
-                vec.x = mesh->mNormals[i].x;
-                vec.y = mesh->mNormals[i].y;
-                vec.z = mesh->mNormals[i].z;
-                vertex.Normal = vec;
-            }
-            // texture coordinates
-            if (mesh->mTextureCoords[0]) // does the mesh contain texture coordinates?
-            {
-                // a vertex can contain up to 8 different texture coordinates. We thus make the assumption that we won't 
-                // use models where a vertex can have multiple texture coordinates so we always take the first set (0).
-                vec.x = mesh->mTextureCoords[0][i].x;
-                vec.y = mesh->mTextureCoords[0][i].y;
-                vertex.TexCoords = glm::vec2(vec);
-            }
-            if (mesh->HasTangentsAndBitangents()) {
-                // tangent
-                vec.x = mesh->mTangents[i].x;
-                vec.y = mesh->mTangents[i].y;
-                vec.z = mesh->mTangents[i].z;
-                vertex.Tangent = vec;
-                // bitangent
-                vec.x = mesh->mBitangents[i].x;
-                vec.y = mesh->mBitangents[i].y;
-                vec.z = mesh->mBitangents[i].z;
-                vertex.Bitangent = vec;
-            }
-
-            vertices.push_back(vertex);
-        }
-        // now wak through each of the mesh's faces (a face is a mesh its triangle) and retrieve the corresponding vertex indices.
-        for (unsigned int i = 0; i < mesh->mNumFaces; i++)
-        {
-            aiFace face = mesh->mFaces[i];
-            // retrieve all indices of the face and store them in the indices vector
-            for (unsigned int j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);
-        }
-        // process materials
-        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-        // we assume a convention for sampler names in the shaders. Each diffuse texture should be named
-        // as 'texture_diffuseN' where N is a sequential number ranging from 1 to MAX_SAMPLER_NUMBER. 
-        // Same applies to other texture as the following list summarizes:
-        // diffuse: texture_diffuseN
-        // specular: texture_specularN
-        // normal: texture_normalN
-
-        // 1. diffuse maps
-        std::vector<Texture> diffuseMaps = LoadMaterialTextures(material, aiTextureType_DIFFUSE, Texture::Diffuse, mmr);
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-        // 2. specular maps
-        std::vector<Texture> specularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, Texture::Specular, mmr);
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
-        // 3. normal maps
-        std::vector<Texture> normalMaps = LoadMaterialTextures(material, aiTextureType_NORMALS, Texture::Normal, mmr);
-        textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
-        // 4. height maps
-        std::vector<Texture> heightMaps = LoadMaterialTextures(material, aiTextureType_HEIGHT, Texture::Height, mmr);
-        textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
-        // 5. ambient maps
-        std::vector<Texture> ambientMaps = LoadMaterialTextures(material, aiTextureType_AMBIENT, Texture::Ambient, mmr);
-        textures.insert(textures.end(), ambientMaps.begin(), ambientMaps.end());
-
-        // return a component object created from the extracted mesh data
-        return CreateModelComponentFromVertexAttributes(vertices, indices, textures);
-	}
-
-    std::vector<Texture> LoadMaterialTextures(aiMaterial* mat, aiTextureType type, Texture::TextureType textureType, ModelMemberRefs& mmr)
-    {
-        std::vector<Texture> textures;
-        for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
-        {
-            // Get texture filename
-            aiString aiFilename;
-            mat->GetTexture(type, i, &aiFilename);
-            std::string filename = aiFilename.C_Str();
-
-            // Check if texture has already been loaded, otherwise load it
-            if (mmr.loadedTextures.contains(filename)) {
-                auto& texture = mmr.loadedTextures.at(filename);
-                textures.push_back(texture);
-            }
-            else {
-                auto texture = Texture(Directory + '/' + filename, textureType);
-                textures.push_back(texture);
-                mmr.loadedTextures.insert({ filename, texture });
-            }
-
-        }
-        return textures;
-    }
-
-    Component CreateModelComponentFromVertexAttributes(const std::vector<VertexAttributes>& vertices, const std::vector<unsigned int>& indices, const std::vector<Texture>& textures)
-    {
-        static_assert(sizeof(VertexAttributes) == sizeof(float) * TotalFloats, "Number of floats in simple VertexAttributes struct must match number of attribute floats.");
-
-        auto vertexArray = reinterpret_cast<const float*>(vertices.data());
-        auto vertexCount = static_cast<unsigned int>(TotalFloats * vertices.size());
-        auto indexArray = indices.data();
-        auto indexCount = static_cast<unsigned int>(indices.size());
-
-        auto component = Component(vertexArray, vertexCount, indexArray, indexCount, FloatsPerAttribute);
-        component.Textures = textures;
-        return component;
-    }
-
-
-
-}
-
-
-namespace Charis {
-
-	Model::Model(const std::string& filepath)
-	{
-        ModelMemberRefs mmr = { .components = Components, .loadedTextures = m_LoadedTextures };
-        LoadModel(filepath, mmr);
-	}
-
-	Model::Model(const std::vector<Component>& components)
-		: Components(components)
-	{}
-
-}
-
+#include "Model.h"
+#include "Texture.h"
+#include "GeometryArena.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/AsyncLoading.hpp"
+#include "Private/DecodedImage.hpp"
+#include "Private/MeshCache.hpp"
+#include "Private/Simplify.hpp"
+#include <atomic>
+#include <latch>
+#include <limits>
+#include <cmath>
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+namespace {
+    using namespace Charis;
+
+    using PrivateGlobal::VertexAttributes;
+    using PrivateGlobal::CompactVertexAttributes;
+    using PrivateGlobal::TotalFloats;
+    using PrivateGlobal::MeshData;
+    using PrivateGlobal::SceneData;
+
+    // Post-processing of model files, part of the mesh cache key
+    constexpr unsigned int ImportFlags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+
+	void LoadModel(const std::string& filepath, SceneData& sceneData);
+	void ProcessNode(aiNode* node, const aiScene* scene, SceneData& sceneData);
+	MeshData ProcessMesh(aiMesh* mesh, const aiScene* scene, SceneData& sceneData);
+	void LoadMaterialTextures(aiMaterial* mat, aiTextureType type, Texture::TextureType textureType, MeshData& meshData, SceneData& sceneData);
+    void CompactMesh(MeshData& meshData);
+    void GenerateLevelsOfDetail(MeshData& meshData, const Model::LodSettings& lods);
+    void ClusterMesh(MeshData& meshData);
+    DecodedImage DecodeTexture(const SceneData& sceneData, const std::string& filename);
+    Component CreateModelComponentFromVertexAttributes(const MeshData& meshData, const std::map<std::string, Texture>& loadedTextures, GeometryArena* arena);
+
+	void LoadModel(const std::string& filepath, SceneData& sceneData)
+	{
+		// retrieve the directory path of the filepath
+		sceneData.Directory = filepath.substr(0, filepath.find_last_of('/'));
+
+		// a valid mesh cache skips ASSIMP entirely
+		if (PrivateGlobal::ReadMeshCache(filepath, ImportFlags, sceneData))
+			return;
+
+		// read file via ASSIMP
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(filepath, ImportFlags);
+		// check for errors
+		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
+		{
+			PrivateGlobal::Diagnose(Utility::DiagnosticSeverity::Error, std::string("ASSIMP:: ") + importer.GetErrorString());
+			return;
+		}
+		// process ASSIMP's root node recursively
+		ProcessNode(scene->mRootNode, scene, sceneData);
+
+		// meshes use their own vertices and indices, which are stored for the next load
+		for (auto& meshData : sceneData.Meshes) {
+			meshData.Vertices = meshData.OwnedVertices;
+			meshData.Indices = meshData.OwnedIndices;
+		}
+		PrivateGlobal::WriteMeshCache(filepath, ImportFlags, sceneData);
+	}
+
+    void ProcessNode(aiNode* node, const aiScene* scene, SceneData& sceneData)
+    {
+        // process each mesh located at the current node
+        for (unsigned int i = 0; i < node->mNumMeshes; i++)
+        {
+            // the node object only contains indices to index the actual objects in the scene. 
+            // the scene contains all the data, node is just to keep stuff organized (like relations between nodes).
+            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+            sceneData.Meshes.push_back(ProcessMesh(mesh, scene, sceneData));
+        }
+        // after we've processed all of the meshes (if any) we then recursively process each of the children nodes
+        for (unsigned int i = 0; i < node->mNumChildren; i++)
+        {
+            ProcessNode(node->mChildren[i], scene, sceneData);
+        }
+    }
+
+	MeshData ProcessMesh(aiMesh* mesh, const aiScene* scene, SceneData& sceneData)
+	{
+        static_assert(sizeof(VertexAttributes) == TotalFloats * sizeof(float));
+
+        // data to fill
+        MeshData meshData;
+        auto& vertices = meshData.OwnedVertices;
+        auto& indices = meshData.OwnedIndices;
+        vertices.resize(mesh->mNumVertices);
+        indices.reserve(3 * static_cast<size_t>(mesh->mNumFaces));
+
+        // walk through each of the mesh's vertices
+        for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+        {
+            auto& vertex = vertices[i];
+            glm::vec3 vec{}; // declare a placeholder vector since assimp uses its own vector class that doesn't directly convert to glm's vec3 class so we transfer the data to this placeholder glm::vec3 first.
+            // positions
+            vec.x = mesh->mVertices[i].x;
+            vec.y = mesh->mVertices[i].y;
+            vec.z = mesh->mVertices[i].z;
+            vertex.Position = vec;
+            // normals
+            if (mesh->HasNormals())
+            {
+                vec.x = mesh->mNormals[i].x;
+                vec.y = mesh->mNormals[i].y;
+                vec.z = mesh->mNormals[i].z;
+                vertex.Normal = vec;
+            }
+            // texture coordinates
+            if (mesh->mTextureCoords[0]) // does the mesh contain texture coordinates?
+            {
+                // a vertex can contain up to 8 different texture coordinates. We thus make the assumption that we won't 
+                // use models where a vertex can have multiple texture coordinates so we always take the first set (0).
+                vec.x = mesh->mTextureCoords[0][i].x;
+                vec.y = mesh->mTextureCoords[0][i].y;
+                vertex.TexCoords = glm::vec2(vec);
+            }
+            if (mesh->HasTangentsAndBitangents()) {
+                // tangent
+                vec.x = mesh->mTangents[i].x;
+                vec.y = mesh->mTangents[i].y;
+                vec.z = mesh->mTangents[i].z;
+                vertex.Tangent = vec;
+                // bitangent
+                vec.x = mesh->mBitangents[i].x;
+                vec.y = mesh->mBitangents[i].y;
+                vec.z = mesh->mBitangents[i].z;
+                vertex.Bitangent = vec;
+            }
+        }
+        // now wak through each of the mesh's faces (a face is a mesh its triangle) and retrieve the corresponding vertex indices.
+        for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+        {
+            aiFace face = mesh->mFaces[i];
+            // retrieve all indices of the face and store them in the indices vector
+            for (unsigned int j = 0; j < face.mNumIndices; j++)
+                indices.push_back(face.mIndices[j]);
+        }
+        // process materials
+        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+        // we assume a convention for sampler names in the shaders. Each diffuse texture should be named
+        // as 'texture_diffuseN' where N is a sequential number ranging from 1 to MAX_SAMPLER_NUMBER. 
+        // Same applies to other texture as the following list summarizes:
+        // diffuse: texture_diffuseN
+        // specular: texture_specularN
+        // normal: texture_normalN
+
+        // 1. diffuse maps
+        LoadMaterialTextures(material, aiTextureType_DIFFUSE, Texture::Diffuse, meshData, sceneData);
+        // 2. specular maps
+        LoadMaterialTextures(material, aiTextureType_SPECULAR, Texture::Specular, meshData, sceneData);
+        // 3. normal maps
+        LoadMaterialTextures(material, aiTextureType_NORMALS, Texture::Normal, meshData, sceneData);
+        // 4. height maps
+        LoadMaterialTextures(material, aiTextureType_HEIGHT, Texture::Height, meshData, sceneData);
+        // 5. ambient maps
+        LoadMaterialTextures(material, aiTextureType_AMBIENT, Texture::Ambient, meshData, sceneData);
+
+        // return the extracted mesh data, components are created from it later
+        return meshData;
+	}
+
+    void LoadMaterialTextures(aiMaterial* mat, aiTextureType type, Texture::TextureType textureType, MeshData& meshData, SceneData& sceneData)
+    {
+        for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
+        {
+            // Get texture filename
+            aiString aiFilename;
+            mat->GetTexture(type, i, &aiFilename);
+            std::string filename = aiFilename.C_Str();
+            meshData.TextureFiles.push_back(filename);
+
+            // Check if texture has already been seen, otherwise remember to load it
+            auto& textureFiles = sceneData.TextureFiles;
+            const bool seen = std::any_of(textureFiles.begin(), textureFiles.end(), [&](const auto& file) { return file.first == filename; });
+            if (!seen)
+                textureFiles.push_back({ filename, textureType });
+        }
+    }
+
+    std::int16_t Snorm16(float value)
+    {
+        return static_cast<std::int16_t>(std::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    // Maps a unit vector onto the octahedron and unfolds it into a square, which keeps the error even over all directions.
+    glm::vec2 OctahedralEncode(glm::vec3 vector)
+    {
+        const auto length = glm::abs(vector.x) + glm::abs(vector.y) + glm::abs(vector.z);
+        if (length == 0.0f)
+            return { 0.0f, 0.0f };
+        vector /= length;
+        auto encoded = glm::vec2(vector.x, vector.y);
+        if (vector.z < 0.0f) {
+            const auto sign = glm::vec2(encoded.x >= 0.0f ? 1.0f : -1.0f, encoded.y >= 0.0f ? 1.0f : -1.0f);
+            encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * sign;
+        }
+        return encoded;
+    }
+
+    // Quantizes the vertices of a mesh into the compact format and narrows its indices, replacing the full precision data.
+    void CompactMesh(MeshData& meshData)
+    {
+        // Positions are stored relative to the bounds of the mesh, so the 16 bits are spent where the mesh is
+        auto lower = glm::vec3(std::numeric_limits<float>::max());
+        auto upper = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const auto& vertex : meshData.Vertices) {
+            lower = glm::min(lower, vertex.Position);
+            upper = glm::max(upper, vertex.Position);
+        }
+        const auto center = 0.5f * (lower + upper);
+        const auto extent = glm::max(0.5f * (upper - lower), glm::vec3(std::numeric_limits<float>::min()));
+        meshData.PositionDequantization = { 
+            extent.x, 0.0f, 0.0f, 0.0f, 
+            0.0f, extent.y, 0.0f, 0.0f, 
+            0.0f, 0.0f, extent.z, 0.0f, 
+            center.x, center.y, center.z, 1.0f 
+        };
+
+        auto& compact = meshData.CompactVertices;
+        compact.resize(meshData.Vertices.size());
+        for (size_t i = 0; i < compact.size(); i++) {
+            const auto& vertex = meshData.Vertices[i];
+            const auto position = (vertex.Position - center) / extent;
+            const auto normal = OctahedralEncode(vertex.Normal);
+            const auto tangent = OctahedralEncode(vertex.Tangent);
+            const bool flipped = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f;
+            compact[i] = {
+                { Snorm16(position.x), Snorm16(position.y), Snorm16(position.z), Snorm16(flipped ? -1.0f : 1.0f) },
+                { Snorm16(normal.x), Snorm16(normal.y) },
+                { glm::packHalf1x16(vertex.TexCoords.x), glm::packHalf1x16(vertex.TexCoords.y) },
+                { Snorm16(tangent.x), Snorm16(tangent.y) }
+            };
+        }
+
+        if (meshData.Vertices.size() <= 65536)
+            meshData.CompactIndices.assign(meshData.Indices.begin(), meshData.Indices.end());
+        else
+            meshData.CompactLargeIndices.assign(meshData.Indices.begin(), meshData.Indices.end());
+
+        meshData.Vertices = {};
+        meshData.Indices = {};
+        meshData.OwnedVertices = {};
+        meshData.OwnedIndices = {};
+    }
+
+    // Simplifies the full mesh once per level, each time from the full mesh so the errors do not add up.
+    void GenerateLevelsOfDetail(MeshData& meshData, const Model::LodSettings& lods)
+    {
+        if (meshData.Vertices.empty())
+            return;
+        auto lower = glm::vec3(std::numeric_limits<float>::max());
+        auto upper = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const auto& vertex : meshData.Vertices) {
+            lower = glm::min(lower, vertex.Position);
+            upper = glm::max(upper, vertex.Position);
+        }
+        const auto maxError = lods.MaxError * glm::length(upper - lower);
+
+        auto previousCount = meshData.Indices.size();
+        auto target = static_cast<double>(meshData.Indices.size());
+        for (unsigned int level = 0; level < lods.Levels; level++) {
+            target *= lods.TriangleRatio;
+            const auto targetIndices = 3 * static_cast<size_t>(target / 3.0);
+            auto error = 0.0f;
+            auto indices = PrivateGlobal::SimplifyMesh(meshData.Vertices, meshData.Indices, targetIndices, maxError, error);
+
+            // A level that barely removes anything is not worth drawing, and the next would be no smaller
+            if (indices.empty() || indices.size() > previousCount - previousCount / 8)
+                break;
+            previousCount = indices.size();
+            meshData.LevelsOfDetail.push_back({ std::move(indices), error });
+        }
+    }
+
+    // Splits the full mesh into meshlets and reorders its indices to match.
+    void ClusterMesh(MeshData& meshData)
+    {
+        if (meshData.Indices.empty())
+            return;
+        // The indices may point into the mapped mesh cache, so they are reordered in a copy
+        auto indices = std::vector<unsigned int>(meshData.Indices.begin(), meshData.Indices.end());
+        meshData.Meshlets = BuildMeshlets(reinterpret_cast<const float*>(meshData.Vertices.data()), TotalFloats, static_cast<unsigned int>(meshData.Vertices.size()), indices);
+        meshData.OwnedIndices = std::move(indices);
+        meshData.Indices = meshData.OwnedIndices;
+    }
+
+    // Bytes of the indices of the levels of detail of a mesh, in the index size of its component.
+    size_t LevelIndexBytes(const MeshData& meshData)
+    {
+        const auto indexBytes = meshData.CompactIndices.empty() ? sizeof(unsigned int) : sizeof(std::uint16_t);
+        size_t bytes = 0;
+        for (const auto& level : meshData.LevelsOfDetail)
+            bytes += indexBytes * level.Indices.size();
+        return bytes;
+    }
+
+    // Bytes the component of a mesh uploads, counted against the upload budget.
+    size_t UploadBytes(const MeshData& meshData)
+    {
+        return sizeof(VertexAttributes) * meshData.Vertices.size() + sizeof(unsigned int) * meshData.Indices.size()
+            + sizeof(CompactVertexAttributes) * meshData.CompactVertices.size() + sizeof(std::uint16_t) * meshData.CompactIndices.size()
+            + sizeof(unsigned int) * meshData.CompactLargeIndices.size() + LevelIndexBytes(meshData);
+    }
+
+    DecodedImage DecodeTexture(const SceneData& sceneData, const std::string& filename)
+    {
+        // mip levels are built here as well, so the main thread only has to upload
+        DecodedImage image;
+        image.Decode(sceneData.Directory + '/' + filename);
+        image.GenerateMips();
+        return image;
+    }
+
+    Component CreateCompactModelComponent(const MeshData& meshData)
+    {
+        const bool small = meshData.CompactLargeIndices.empty();
+        const void* indexArray = small ? static_cast<const void*>(meshData.CompactIndices.data()) : meshData.CompactLargeIndices.data();
+        const auto indexCount = static_cast<unsigned int>(small ? meshData.CompactIndices.size() : meshData.CompactLargeIndices.size());
+        auto component = Component(meshData.CompactVertices.data(), static_cast<unsigned int>(meshData.CompactVertices.size()), Model::CompactFileAttributes, 
+            indexArray, indexCount, small ? Component::Indices16 : Component::Indices32, meshData.LevelsOfDetail);
+        component.SetPositionDequantization(meshData.PositionDequantization);
+        return component;
+    }
+
+    Component CreateModelComponentFromVertexAttributes(const MeshData& meshData, const std::map<std::string, Texture>& loadedTextures, GeometryArena* arena)
+    {
+        if (!meshData.CompactVertices.empty()) {
+            auto component = CreateCompactModelComponent(meshData);
+            component.SetMeshlets(meshData.Meshlets);
+            for (const auto& filename : meshData.TextureFiles)
+                component.Textures.push_back(loadedTextures.at(filename));
+            return component;
+        }
+
+        auto vertexArray = reinterpret_cast<const float*>(meshData.Vertices.data());
+        auto vertexCount = static_cast<unsigned int>(TotalFloats * meshData.Vertices.size());
+        auto indexArray = meshData.Indices.data();
+        auto indexCount = static_cast<unsigned int>(meshData.Indices.size());
+
+        auto component = arena ? arena->CreateComponent(vertexArray, vertexCount, indexArray, indexCount) 
+                               : Component(vertexArray, vertexCount, indexArray, indexCount, Model::FloatsPerFileAttribute, meshData.LevelsOfDetail);
+        if (!arena)
+            component.SetMeshlets(meshData.Meshlets);
+        for (const auto& filename : meshData.TextureFiles)
+            component.Textures.push_back(loadedTextures.at(filename));
+        return component;
+    }
+
+    // Simplifies, clusters and compacts a mesh as the options ask, in that order, since the levels and meshlets are made from the full precision vertices.
+    void PrepareMesh(MeshData& meshData, const Model::LoadOptions& options)
+    {
+        if (options.Lods)
+            GenerateLevelsOfDetail(meshData, *options.Lods);
+        if (options.Clustering == Model::Meshlets)
+            ClusterMesh(meshData);
+        if (options.Format == Model::Compact)
+            CompactMesh(meshData);
+    }
+
+    // Runs a step of the processing of every mesh on the worker pool and waits for them. Must not be called from a worker.
+    template<typename Step>
+    void ProcessMeshesInParallel(SceneData& sceneData, const Step& step)
+    {
+        std::latch processed(static_cast<std::ptrdiff_t>(sceneData.Meshes.size()));
+        for (auto& meshData : sceneData.Meshes) {
+            PrivateGlobal::WorkerPool::Submit([&]() {
+                step(meshData);
+                processed.count_down();
+            });
+        }
+        processed.wait();
+    }
+
+    // Decodes all textures of a scene on the worker pool, then creates them and all components on the calling thread.
+    void CreateModel(SceneData& sceneData, std::vector<Component>& components, std::map<std::string, Texture>& loadedTextures, GeometryArena* arena)
+    {
+        const auto textureCount = sceneData.TextureFiles.size();
+        std::vector<DecodedImage> images(textureCount);
+        std::latch decoded(static_cast<std::ptrdiff_t>(textureCount));
+        for (size_t i = 0; i < textureCount; i++) {
+            PrivateGlobal::WorkerPool::Submit([&, i]() {
+                images[i] = DecodeTexture(sceneData, sceneData.TextureFiles[i].first);
+                decoded.count_down();
+            });
+        }
+        decoded.wait();
+
+        for (size_t i = 0; i < textureCount; i++) {
+            const auto& [filename, textureType] = sceneData.TextureFiles[i];
+            loadedTextures.insert({ filename, images[i].CreateTexture(textureType) });
+            images[i] = {};
+        }
+        for (const auto& meshData : sceneData.Meshes)
+            components.push_back(CreateModelComponentFromVertexAttributes(meshData, loadedTextures, arena));
+    }
+
+}
+
+
+namespace Charis {
+
+	Model::Model(const std::string& filepath)
+		: Model(filepath, LoadOptions{})
+	{}
+
+	Model::Model(const std::string& filepath, const LoadOptions& options)
+	{
+        CheckLoadOptions(options);
+        SceneData sceneData;
+        LoadModel(filepath, sceneData);
+        if (options.Lods || options.Clustering == Meshlets || options.Format == Compact)
+            ProcessMeshesInParallel(sceneData, [&](MeshData& meshData) { PrepareMesh(meshData, options); });
+        CreateModel(sceneData, Components, m_LoadedTextures, options.Arena);
+	}
+
+	Model::Model(const std::vector<Component>& components)
+		: Components(components)
+	{}
+
+	BoundingBox Model::LocalBounds() const
+	{
+		auto box = BoundingBox{};
+		for (const auto& component : Components)
+			box.Add(component.LocalBounds());
+		return box;
+	}
+
+	Model::Model(std::vector<Component>&& components, std::map<std::string, Texture>&& loadedTextures)
+		: Components(std::move(components)), m_LoadedTextures(std::move(loadedTextures))
+	{}
+
+	void Model::CheckLoadOptions(const LoadOptions& options)
+	{
+        if (options.Lods)
+            Helper::RuntimeAssert(options.Lods->TriangleRatio > 0.0f && options.Lods->TriangleRatio < 1.0f, "Level of detail triangle ratio must be in (0, 1).");
+        if (options.Arena) {
+            Helper::RuntimeAssert(options.Arena->m->FloatsPerAttributePerVertex == FloatsPerFileAttribute, "Geometry arena layout must match the vertex attributes of model files.");
+            // Arena components hold full precision vertices in the layout of the arena, and no index ranges besides their own
+            Helper::RuntimeAssert(options.Format == FullPrecision, "Models in a geometry arena must have the FullPrecision vertex format.");
+            Helper::RuntimeAssert(!options.Lods, "Models in a geometry arena can not have levels of detail.");
+            Helper::RuntimeAssert(options.Clustering == WholeComponents, "Models in a geometry arena can not have meshlets.");
+        }
+	}
+
+	bool AsyncModel::IsReady() const
+	{
+        return m->Loaded.has_value();
+	}
+
+	const Model& AsyncModel::Get() const
+	{
+        Helper::RuntimeAssert(IsReady(), "Model is not loaded yet.");
+        return *m->Loaded;
+	}
+
+	void AsyncModel::SetPlaceholder(const Model& placeholder)
+	{
+        m->Placeholder = placeholder;
+	}
+
+	const Model* AsyncModel::Drawable() const
+	{
+        if (m->Loaded)
+            return &*m->Loaded;
+        if (m->Placeholder)
+            return &*m->Placeholder;
+        return nullptr;
+	}
+
+	AsyncModel AsyncModel::Start(const std::string& filepath, const Model::LoadOptions& options)
+	{
+        Model::CheckLoadOptions(options);
+        // State shared by all jobs of one load. GL objects in it are only created and destroyed by upload jobs on the main thread.
+        // The load holds no reference on the model it fills in, so dropping every handle destroys the member at the next frame boundary,
+        // on the main thread like the upload jobs, and the jobs after that see it abandoned.
+        struct Load {
+            SceneData Scene;
+            std::vector<DecodedImage> Images;
+            std::atomic<size_t> ImagesLeft;
+            std::optional<GeometryArena> Arena;
+            std::vector<Component> Components;
+            std::map<std::string, Texture> LoadedTextures;
+            AsyncModelMember* Target{};
+            std::shared_ptr<std::atomic<bool>> TargetAbandoned;
+
+            // True if every handle to the model is gone, so the rest of the load can be skipped.
+            bool Abandoned() const { return TargetAbandoned->load(std::memory_order_relaxed); }
+        };
+
+        auto handle = AsyncModel();
+        auto load = std::make_shared<Load>();
+        load->Target = &*handle.m;
+        load->TargetAbandoned = handle.m->Abandoned;
+        if (options.Arena)
+            load->Arena = *options.Arena;
+
+        // Queued after all textures, since components refer to them
+        const auto queueComponents = [](const std::shared_ptr<Load>& load) {
+            for (size_t i = 0; i < load->Scene.Meshes.size(); i++) {
+                const auto& meshData = load->Scene.Meshes[i];
+                const auto bytes = UploadBytes(meshData);
+                PrivateGlobal::UploadQueue::Push({ bytes, [load, i]() {
+                    if (load->Abandoned())
+                        return;
+                    auto arena = load->Arena ? &*load->Arena : nullptr;
+                    load->Components.push_back(CreateModelComponentFromVertexAttributes(load->Scene.Meshes[i], load->LoadedTextures, arena));
+                } });
+            }
+            PrivateGlobal::UploadQueue::Push({ 0, [load]() {
+                if (!load->Abandoned())
+                    load->Target->Loaded.emplace(Model(std::move(load->Components), std::move(load->LoadedTextures)));
+                load->Components.clear();
+                load->LoadedTextures.clear();
+                load->Scene = {};
+            } });
+        };
+
+        // The load holds its own copy of the arena, so the pointer is not taken along
+        auto processing = options;
+        processing.Arena = nullptr;
+
+        PrivateGlobal::WorkerPool::Submit([load, filepath, processing, queueComponents]() {
+            LoadModel(filepath, load->Scene);
+            // One mesh after the other, since waiting for other jobs from inside a worker could leave no worker to run them
+            for (auto& meshData : load->Scene.Meshes)
+                PrepareMesh(meshData, processing);
+
+            const auto textureCount = load->Scene.TextureFiles.size();
+            load->Images.resize(textureCount);
+            load->ImagesLeft = textureCount;
+            if (textureCount == 0) {
+                queueComponents(load);
+                return;
+            }
+
+            // Decode every image on its own worker, uploading each as soon as it is decoded
+            for (size_t i = 0; i < textureCount; i++) {
+                PrivateGlobal::WorkerPool::Submit([load, i, queueComponents]() {
+                    auto& image = load->Images[i];
+                    image = DecodeTexture(load->Scene, load->Scene.TextureFiles[i].first);
+                    const auto bytes = image.Bytes();
+                    PrivateGlobal::UploadQueue::Push({ bytes, [load, i]() {
+                        if (load->Abandoned())
+                            return;
+                        const auto& [filename, textureType] = load->Scene.TextureFiles[i];
+                        load->LoadedTextures.insert({ filename, load->Images[i].CreateTexture(textureType) });
+                        load->Images[i] = {};
+                    } });
+
+                    // The last decoded image queues the components, after all texture uploads
+                    if (load->ImagesLeft.fetch_sub(1) == 1)
+                        queueComponents(load);
+                });
+            }
+        });
+
+        return handle;
+	}
+
+	AsyncModel LoadModelAsync(const std::string& filepath, const Model::LoadOptions& options)
+	{
+        return AsyncModel::Start(filepath, options);
+	}
+
+}
@@ -1,38 +1,162 @@
-#pragma once
-#include "Component.h"
-#include <string>
-#include <map>
-
-namespace Charis {
-
-	/// <summary>A model is a set of components (or just one) and can be created from model files or components.</summary>
-	class Model
-	{
-	public:
-		/// <summary>
-		/// Constructor for a Model.
-		/// A model constructed from a file will contain standardized vertex attributes which shaders must accomodate.
-		/// For vertex shader input attributes, at locations 0-4, the following are expected: 
-		/// vec3 position, vec3 normal, vec2 texture coordinate, vec3 tangent, vec3 bitangent.
-		/// </summary>
-		/// <param name="filepath">Path to model file to be loaded.</param>
-		Model(const std::string& filepath);
-		/// <summary>
-		/// Constructor for a Model.
-		/// </summary>
-		/// <param name="components">A list of components, sharing the same local coordinate system, that together make up a model.</param>
-		Model(const std::vector<Component>& components);
-
-		/// <summary>
-		/// If the model was constructed from a file then this function returns a map of loaded textures, 
-		/// with file names as keys and their textures as values. 
-		/// </summary>
-		const std::map<std::string, Texture>& LoadedTextures() const { return m_LoadedTextures; }
-		std::vector<Component> Components;
-	private:
-		std::map<std::string, Texture> m_LoadedTextures;
-	};
-
-}
-
-
+#pragma once
+#include "Component.h"
+#include <string>
+#include <map>
+#include <optional>
+#include <memory>
+#include <atomic>
+
+namespace Charis {
+
+	class GeometryArena;
+
+	/// <summary>A model is a set of components (or just one) and can be created from model files or components.</summary>
+	class Model
+	{
+	public:
+		enum VertexFormat {
+			// Vertex attributes of FloatsPerFileAttribute, 56 bytes per vertex.
+			FullPrecision,
+			// Vertex attributes of CompactFileAttributes, 20 bytes per vertex, with 16 bit indices where possible.
+			Compact
+		};
+		/// <summary>How the level of detail option simplifies the meshes of a model file.</summary>
+		struct LodSettings {
+			// Number of coarser levels after the full mesh. Fewer are made if a mesh can not be simplified further within MaxError.
+			unsigned int Levels = 3;
+			// Fraction of the triangles of the full mesh to aim for at each level, so the second level aims for TriangleRatio squared and so on.
+			float TriangleRatio = 0.5f;
+			// Largest error of any level, as a fraction of the diagonal of the bounds of the mesh.
+			float MaxError = 0.05f;
+		};
+
+		enum Clustering {
+			// Components are drawn and culled whole.
+			WholeComponents,
+			// Components are split into meshlets, see BuildMeshlets, and their indices reordered to match.
+			Meshlets
+		};
+
+		/// <summary>
+		/// How a model file is loaded, for the Model file constructor and LoadModelAsync. The defaults load full precision components without
+		/// levels of detail or meshlets. Components in a GeometryArena can not have the other options, loading aborts with a message if they are combined.
+		/// </summary>
+		struct LoadOptions {
+			/// <summary>
+			/// Vertex format of the components. A Compact model expects these vertex shader input attributes, at locations 0-3:
+			/// vec4 position (xyz in [-1, 1] within the bounds of the component, w the sign of the bitangent), vec2 octahedral encoded normal, 
+			/// vec2 texture coordinate, vec2 octahedral encoded tangent. The bitangent is cross(normal, tangent) * position.w.
+			/// The shader must declare uniform mat4 PositionDequantization, see Component::SetPositionDequantization, and multiply positions by it.
+			/// </summary>
+			VertexFormat Format = FullPrecision;
+			/// <summary>
+			/// Levels of detail to make, none if empty. Every mesh is simplified by collapsing the edges that change its shape, normals and texture coordinates
+			/// the least. Open borders and texture seams are kept, so the levels do not tear. The levels share the vertices of the full mesh and are stored
+			/// after it in the same index buffer. Draw it with the level of detail overload of Shader::Draw. Simplifying takes time, and is done on the
+			/// worker threads for every load.
+			/// </summary>
+			std::optional<LodSettings> Lods{};
+			/// <summary>
+			/// Draw a model with Meshlets clustering with Shader::DrawMeshlets, which only draws the meshlets in view. This pays off for dense meshes
+			/// that are seldom entirely on screen. The meshlets are built on the worker threads for every load, they are not part of the mesh cache.
+			/// </summary>
+			Model::Clustering Clustering = WholeComponents;
+			/// <summary>
+			/// Arena to create the components in, if any. Its layout must be FloatsPerFileAttribute. All components of the model then share the buffers
+			/// of the arena and the model is drawn with a single multi-draw call per set of textures.
+			/// </summary>
+			GeometryArena* Arena = nullptr;
+		};
+
+		/// <summary>
+		/// Constructor for a Model.
+		/// A model constructed from a file will contain standardized vertex attributes which shaders must accomodate.
+		/// For vertex shader input attributes, at locations 0-4, the following are expected: 
+		/// vec3 position, vec3 normal, vec2 texture coordinate, vec3 tangent, vec3 bitangent.
+		/// </summary>
+		/// <param name="filepath">Path to model file to be loaded.</param>
+		Model(const std::string& filepath);
+		/// <summary>Constructor for a Model with load options, see LoadOptions for the vertex attributes of the Compact format.</summary>
+		/// <param name="filepath">Path to model file to be loaded.</param>
+		/// <param name="options">How to load the file.</param>
+		Model(const std::string& filepath, const LoadOptions& options);
+		/// <summary>
+		/// Constructor for a Model.
+		/// </summary>
+		/// <param name="components">A list of components, sharing the same local coordinate system, that together make up a model.</param>
+		Model(const std::vector<Component>& components);
+
+		/// <summary>
+		/// If the model was constructed from a file then this function returns a map of loaded textures, 
+		/// with file names as keys and their textures as values. 
+		/// </summary>
+		const std::map<std::string, Texture>& LoadedTextures() const { return m_LoadedTextures; }
+		/// <summary>Box around the bounds of all components, in model space.</summary>
+		BoundingBox LocalBounds() const;
+		std::vector<Component> Components;
+
+		// Number of floats per vertex attribute of models constructed from a file.
+		inline static const std::vector<unsigned int> FloatsPerFileAttribute = { 3, 3, 2, 3, 3 };
+		// Vertex attributes of models constructed from a file with the Compact vertex format.
+		inline static const std::vector<VertexAttribute> CompactFileAttributes = {
+			{ VertexAttribute::Short, 4, true },
+			{ VertexAttribute::Short, 2, true },
+			{ VertexAttribute::HalfFloat, 2, false },
+			{ VertexAttribute::Short, 2, true }
+		};
+
+		friend class AsyncModel;
+	private:
+		Model(std::vector<Component>&& components, std::map<std::string, Texture>&& loadedTextures);
+		// Aborts if the options can not be combined or do not fit the arena.
+		static void CheckLoadOptions(const LoadOptions& options);
+
+		std::map<std::string, Texture> m_LoadedTextures;
+	};
+
+	/// <summary>
+	/// Handle to a model that is loaded in the background, see LoadModelAsync.
+	/// The model becomes ready during a later StartFrame, and can be drawn with a Shader before that, which draws its placeholder if it has one.
+	/// </summary>
+	class AsyncModel
+	{
+	public:
+		/// <summary>Checks if the model is loaded and all of its GL objects have been created.</summary>
+		bool IsReady() const;
+		/// <summary>Returns the loaded model. Aborts if the model is not ready.</summary>
+		const Model& Get() const;
+		/// <summary>Sets a model to draw instead while this model is not ready. Without a placeholder nothing is drawn until the model is ready.</summary>
+		void SetPlaceholder(const Model& placeholder);
+		/// <summary>Returns the loaded model if it is ready, otherwise the placeholder. Returns null if there is neither.</summary>
+		const Model* Drawable() const;
+
+		friend AsyncModel LoadModelAsync(const std::string& filepath, const Model::LoadOptions& options);
+	private:
+		AsyncModel() = default;
+		static AsyncModel Start(const std::string& filepath, const Model::LoadOptions& options);
+
+		struct AsyncModelMember {
+			std::optional<Model> Loaded;
+			std::optional<Model> Placeholder;
+			// Shared with the load, which skips the rest of its work once the last handle is gone and this member was destroyed
+			std::shared_ptr<std::atomic<bool>> Abandoned = std::make_shared<std::atomic<bool>>(false);
+
+			~AsyncModelMember() { Abandoned->store(true, std::memory_order_relaxed); }
+			// The models release their own resources, see ResourceRegistry::Pool.
+			void DeleteObjects() {}
+		};
+		Resource<AsyncModelMember> m = Resource<AsyncModelMember>::Make();
+	};
+
+	/// <summary>
+	/// Loads a model file without blocking, see the Model file constructors for the vertex attributes and options.
+	/// The file is parsed and its images decoded on worker threads, after which StartFrame creates the textures and components 
+	/// within the upload budget of every frame, see Utility::SetUploadBudget.
+	/// </summary>
+	/// <param name="filepath">Path to model file to be loaded.</param>
+	/// <param name="options">How to load the file. The arena, if any, is kept alive by the load until it is done.</param>
+	AsyncModel LoadModelAsync(const std::string& filepath, const Model::LoadOptions& options = {});
+
+}
+
+
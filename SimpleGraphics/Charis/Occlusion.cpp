@@ -0,0 +1,502 @@
+#include "Occlusion.h"
+#include "Utility.h"
+#include "Profiler.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/AsyncLoading.hpp"
+#include "Private/SimdLanes.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <latch>
+#include <limits>
+#include <thread>
+
+namespace Charis {
+
+    // Triangles and bins of one Rasterize, kept from frame to frame so their storage is reused.
+    // Shared with the helper jobs, which may only start after the pass is done and then find no bins left.
+    struct OcclusionPass {
+        // A triangle in pixel coordinates, as three edge functions that are not negative inside and a depth plane.
+        // Both are evaluated as A * x + B * y + C at pixel centers.
+        struct ScreenTriangle {
+            std::array<float, 3> EdgeA, EdgeB, EdgeC;
+            float DepthA, DepthB, DepthC;
+            int MinX, MaxX, MinY, MaxY;
+        };
+        struct PixelRect {
+            int MinX, MaxX, MinY, MaxY;
+        };
+
+        std::vector<ScreenTriangle> Triangles;
+        std::vector<PixelRect> Bins;
+        std::vector<std::vector<unsigned int>> BinTriangles;
+        std::vector<unsigned int> WorkBins;
+        float* Depths{};
+        float* TileDepths{};
+        unsigned int Width{};
+        std::atomic<unsigned int> NextBin = 0;
+        std::unique_ptr<std::latch> Done;
+
+        // Transformed vertices of the occluder being set up
+        std::vector<glm::vec4> Clip;
+        std::vector<unsigned int> Outside;
+        std::vector<glm::vec3> Screen;
+    };
+
+}
+
+namespace {
+    using namespace Charis;
+#if CHARIS_SIMD_LANES > 1
+    using namespace Charis::PrivateGlobal::Simd;
+#endif
+
+    // Pixels per side of the tiles that keep their farthest depth
+    constexpr unsigned int TileSize = 8;
+    // Pixels per side of the bins that are rasterized as one job, multiples of the tile size
+    constexpr unsigned int BinWidth = 64;
+    constexpr unsigned int BinHeight = 32;
+    // Triangles on screen from which the bins are shared with the worker threads
+    constexpr size_t ParallelTriangles = 1024;
+
+    using ScreenTriangle = OcclusionPass::ScreenTriangle;
+    using PixelRect = OcclusionPass::PixelRect;
+
+    // Bits of the sides of the frustum a clip space vertex is outside of
+    constexpr unsigned int Left = 1;
+    constexpr unsigned int Right = 2;
+    constexpr unsigned int Bottom = 4;
+    constexpr unsigned int Top = 8;
+    constexpr unsigned int Far = 16;
+    constexpr unsigned int Near = 32;
+    unsigned int OutsideBits(const glm::vec4& clip)
+    {
+        return (clip.x < -clip.w ? Left : 0u) | (clip.x > clip.w ? Right : 0u) | (clip.y < -clip.w ? Bottom : 0u) | (clip.y > clip.w ? Top : 0u)
+            | (clip.z > clip.w ? Far : 0u) | (clip.z < -clip.w ? Near : 0u);
+    }
+
+    // Pixel coordinates and depth in [0, 1] of a clip space vertex in front of the near plane.
+    glm::vec3 ToScreen(const glm::vec4& clip, unsigned int width, unsigned int height)
+    {
+        const auto ndc = glm::vec3(clip) * (1.0f / clip.w);
+        return { (0.5f * ndc.x + 0.5f) * width, (0.5f * ndc.y + 0.5f) * height, 0.5f * ndc.z + 0.5f };
+    }
+
+    // Rounding of values well inside the range of int, without the library call of std::ceil and std::floor.
+    int Ceiling(float value)
+    {
+        const auto truncated = static_cast<int>(value);
+        return truncated + (static_cast<float>(truncated) < value);
+    }
+    int Floor(float value)
+    {
+        const auto truncated = static_cast<int>(value);
+        return truncated - (static_cast<float>(truncated) > value);
+    }
+
+    // Sets up a triangle of vertices on screen. Returns false if it covers no pixel centers.
+    bool SetupTriangle(std::array<glm::vec3, 3> screen, unsigned int width, unsigned int height, ScreenTriangle& triangle)
+    {
+        const auto lower = glm::min(glm::min(screen[0], screen[1]), screen[2]);
+        const auto upper = glm::max(glm::max(screen[0], screen[1]), screen[2]);
+        // Pixel centers inside the bounds, clamped as floats first since vertices near the near plane can be far off screen
+        triangle.MinX = Ceiling(std::clamp(lower.x - 0.5f, -1.0f, static_cast<float>(width)));
+        triangle.MaxX = Floor(std::clamp(upper.x - 0.5f, -1.0f, static_cast<float>(width)));
+        triangle.MinY = Ceiling(std::clamp(lower.y - 0.5f, -1.0f, static_cast<float>(height)));
+        triangle.MaxY = Floor(std::clamp(upper.y - 0.5f, -1.0f, static_cast<float>(height)));
+        triangle.MinX = std::max(triangle.MinX, 0);
+        triangle.MinY = std::max(triangle.MinY, 0);
+        triangle.MaxX = std::min(triangle.MaxX, static_cast<int>(width) - 1);
+        triangle.MaxY = std::min(triangle.MaxY, static_cast<int>(height) - 1);
+        if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+            return false;
+
+        // Counter-clockwise on screen from here on, occluders are solid from both sides
+        auto area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) - (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+        if (area < 0.0f) {
+            std::swap(screen[1], screen[2]);
+            area = -area;
+        }
+        if (!(area > 1e-6f))
+            return false;
+
+        for (size_t i = 0; i < 3; i++) {
+            const auto& from = screen[i];
+            const auto& to = screen[(i + 1) % 3];
+            triangle.EdgeA[i] = from.y - to.y;
+            triangle.EdgeB[i] = to.x - from.x;
+            triangle.EdgeC[i] = -(triangle.EdgeA[i] * from.x + triangle.EdgeB[i] * from.y);
+        }
+        const auto& a = screen[0];
+        const auto& b = screen[1];
+        const auto& c = screen[2];
+        triangle.DepthA = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+        triangle.DepthB = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+        triangle.DepthC = a.z - triangle.DepthA * a.x - triangle.DepthB * a.y;
+        return true;
+    }
+
+    // Clips a triangle against the near plane, z >= -w, leaving up to two triangles.
+    unsigned int ClipNear(const std::array<glm::vec4, 3>& triangle, std::array<std::array<glm::vec4, 3>, 2>& clipped)
+    {
+        std::array<glm::vec4, 4> polygon{};
+        unsigned int count = 0;
+        for (size_t i = 0; i < 3; i++) {
+            const auto& from = triangle[i];
+            const auto& to = triangle[(i + 1) % 3];
+            const auto fromDistance = from.z + from.w;
+            const auto toDistance = to.z + to.w;
+            if (fromDistance >= 0.0f)
+                polygon[count++] = from;
+            if ((fromDistance >= 0.0f) != (toDistance >= 0.0f))
+                polygon[count++] = from + (to - from) * (fromDistance / (fromDistance - toDistance));
+        }
+        if (count < 3)
+            return 0;
+        clipped[0] = { polygon[0], polygon[1], polygon[2] };
+        if (count == 3)
+            return 1;
+        clipped[1] = { polygon[0], polygon[2], polygon[3] };
+        return 2;
+    }
+
+    // Keeps the nearest depth of the triangles of a bin in every pixel, then updates the farthest depth of the tiles of the bin.
+    void RasterizeBin(const OcclusionPass& pass, unsigned int bin)
+    {
+        const auto& rect = pass.Bins[bin];
+        for (auto index : pass.BinTriangles[bin]) {
+            const auto& triangle = pass.Triangles[index];
+            const auto minX = std::max(triangle.MinX, rect.MinX);
+            const auto maxX = std::min(triangle.MaxX, rect.MaxX);
+            const auto minY = std::max(triangle.MinY, rect.MinY);
+            const auto maxY = std::min(triangle.MaxY, rect.MaxY);
+
+#if CHARIS_SIMD_LANES > 1
+            static constexpr float laneOffsets[8] = { 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f };
+            const auto offsets = Load(laneOffsets);
+            const Lanes edgeA[3] = { Broadcast(triangle.EdgeA[0]), Broadcast(triangle.EdgeA[1]), Broadcast(triangle.EdgeA[2]) };
+            const auto depthA = Broadcast(triangle.DepthA);
+            const auto lowest = Broadcast(-(minX + 0.5f));
+            const auto highest = Broadcast(maxX + 0.5f);
+            const auto negate = Broadcast(-1.0f);
+            // Bins start on a multiple of the lane count, so the lanes never leave the row
+            const auto firstX = minX - minX % CHARIS_SIMD_LANES;
+#endif
+            for (auto y = minY; y <= maxY; y++) {
+                const auto centerY = y + 0.5f;
+                float* row = pass.Depths + static_cast<size_t>(y) * pass.Width;
+                std::array<float, 3> rowEdges{};
+                for (size_t i = 0; i < 3; i++)
+                    rowEdges[i] = triangle.EdgeB[i] * centerY + triangle.EdgeC[i];
+                const auto rowDepth = triangle.DepthB * centerY + triangle.DepthC;
+
+#if CHARIS_SIMD_LANES > 1
+                const Lanes rowEdge[3] = { Broadcast(rowEdges[0]), Broadcast(rowEdges[1]), Broadcast(rowEdges[2]) };
+                const auto rowDepths = Broadcast(rowDepth);
+                for (auto x = firstX; x <= maxX; x += CHARIS_SIMD_LANES) {
+                    const auto centerX = Plus(Broadcast(static_cast<float>(x)), offsets);
+                    auto inside = And(NotNegative(Plus(centerX, lowest)), NotNegative(Plus(Times(centerX, negate), highest)));
+                    for (size_t i = 0; i < 3; i++)
+                        inside = And(inside, NotNegative(Plus(Times(edgeA[i], centerX), rowEdge[i])));
+                    if (Bits(inside) == 0)
+                        continue;
+                    const auto depth = Plus(Times(depthA, centerX), rowDepths);
+                    const auto stored = Load(row + x);
+                    Store(row + x, Select(inside, Min(depth, stored), stored));
+                }
+#else
+                for (auto x = minX; x <= maxX; x++) {
+                    const auto centerX = x + 0.5f;
+                    bool inside = true;
+                    for (size_t i = 0; i < 3; i++)
+                        inside = inside && triangle.EdgeA[i] * centerX + rowEdges[i] >= 0.0f;
+                    if (inside)
+                        row[x] = std::min(row[x], triangle.DepthA * centerX + rowDepth);
+                }
+#endif
+            }
+        }
+
+        const auto tilesPerRow = pass.Width / TileSize;
+        for (auto tileY = rect.MinY / static_cast<int>(TileSize); tileY <= rect.MaxY / static_cast<int>(TileSize); tileY++) {
+            for (auto tileX = rect.MinX / static_cast<int>(TileSize); tileX <= rect.MaxX / static_cast<int>(TileSize); tileX++) {
+                auto farthest = 0.0f;
+                for (unsigned int y = 0; y < TileSize; y++) {
+                    const float* row = pass.Depths + static_cast<size_t>(tileY * TileSize + y) * pass.Width + tileX * TileSize;
+                    for (unsigned int x = 0; x < TileSize; x++)
+                        farthest = std::max(farthest, row[x]);
+                }
+                pass.TileDepths[static_cast<size_t>(tileY) * tilesPerRow + tileX] = farthest;
+            }
+        }
+    }
+
+    // Takes bins until none are left.
+    void RasterizeBins(OcclusionPass& pass)
+    {
+        for (auto next = pass.NextBin++; next < pass.WorkBins.size(); next = pass.NextBin++) {
+            RasterizeBin(pass, pass.WorkBins[next]);
+            pass.Done->count_down();
+        }
+    }
+
+}
+
+namespace Charis {
+
+    OcclusionCuller::OcclusionCuller(unsigned int width, unsigned int height)
+        : m(std::make_shared<OcclusionCullerMember>())
+    {
+        Helper::RuntimeAssert(width > 0 && height > 0 && width % TileSize == 0 && height % TileSize == 0, "Occlusion buffer size must be a positive multiple of 8.");
+        m->Width = width;
+        m->Height = height;
+        m->Depths.assign(static_cast<size_t>(width) * height, 1.0f);
+        m->TileDepths.assign(static_cast<size_t>(width / TileSize) * (height / TileSize), 1.0f);
+    }
+
+    unsigned int OcclusionCuller::AddOccluder(const float* vertexAttributes, unsigned int floatsPerVertex, unsigned int numberOfVertices, const unsigned int* indices, unsigned int numberOfIndices)
+    {
+        Helper::RuntimeAssert(floatsPerVertex >= 3, "Vertices must start with a three float position.");
+        Helper::RuntimeAssert(numberOfIndices % 3 == 0, "Number of indices must be a multiple of 3.");
+        CHARIS_ASSERT_PARANOID(std::all_of(indices, indices + numberOfIndices, [&](unsigned int index) { return index < numberOfVertices; }), "Indices must refer to vertices.");
+
+        const auto occluder = static_cast<unsigned int>(m->Meshes.size());
+        m->Meshes.push_back({ static_cast<unsigned int>(m->Positions.size()), static_cast<unsigned int>(m->Indices.size()), numberOfIndices });
+        for (unsigned int i = 0; i < numberOfVertices; i++) {
+            const auto position = vertexAttributes + static_cast<size_t>(i) * floatsPerVertex;
+            m->Positions.emplace_back(position[0], position[1], position[2]);
+        }
+        m->Indices.insert(m->Indices.end(), indices, indices + numberOfIndices);
+        return occluder;
+    }
+
+    unsigned int OcclusionCuller::AddOccluder(const BoundingBox& box)
+    {
+        Helper::RuntimeAssert(!box.IsEmpty(), "Occluder box must not be empty.");
+        std::array<float, 24> corners{};
+        for (unsigned int i = 0; i < 8; i++) {
+            corners[3 * i] = (i & 1) ? box.Max.x : box.Min.x;
+            corners[3 * i + 1] = (i & 2) ? box.Max.y : box.Min.y;
+            corners[3 * i + 2] = (i & 4) ? box.Max.z : box.Min.z;
+        }
+        static constexpr std::array<unsigned int, 36> faces = {
+            0, 2, 1, 1, 2, 3,  4, 5, 6, 5, 7, 6,
+            0, 1, 4, 1, 5, 4,  2, 6, 3, 3, 6, 7,
+            0, 4, 2, 2, 4, 6,  1, 3, 5, 3, 7, 5
+        };
+        return AddOccluder(corners.data(), 3, 8, faces.data(), static_cast<unsigned int>(faces.size()));
+    }
+
+    void OcclusionCuller::ClearOccluders()
+    {
+        m->Positions.clear();
+        m->Indices.clear();
+        m->Meshes.clear();
+    }
+
+    void OcclusionCuller::Rasterize(const glm::mat4& viewProjection, std::span<const Instance> instances)
+    {
+        CHARIS_PROFILE_ZONE("OcclusionCuller::Rasterize");
+        const auto start = std::chrono::steady_clock::now();
+        const auto width = m->Width;
+        const auto height = m->Height;
+        std::fill(m->Depths.begin(), m->Depths.end(), 1.0f);
+        std::fill(m->TileDepths.begin(), m->TileDepths.end(), 1.0f);
+        m->ViewProjection = viewProjection;
+        m->Last = {};
+
+        // A helper job of an earlier frame that has not run yet still holds its pass, which is then left to it
+        if (!m->Pass || m->Pass.use_count() > 1)
+            m->Pass = std::make_shared<OcclusionPass>();
+        const auto pass = m->Pass;
+        pass->Depths = m->Depths.data();
+        pass->TileDepths = m->TileDepths.data();
+        pass->Width = width;
+        pass->Triangles.clear();
+        pass->Bins.clear();
+        pass->WorkBins.clear();
+        pass->NextBin = 0;
+        const auto binsPerRow = (width + BinWidth - 1) / BinWidth;
+        const auto binRows = (height + BinHeight - 1) / BinHeight;
+        for (unsigned int y = 0; y < binRows; y++) {
+            for (unsigned int x = 0; x < binsPerRow; x++) {
+                pass->Bins.push_back({ static_cast<int>(x * BinWidth), static_cast<int>(std::min((x + 1) * BinWidth, width)) - 1,
+                    static_cast<int>(y * BinHeight), static_cast<int>(std::min((y + 1) * BinHeight, height)) - 1 });
+            }
+        }
+        pass->BinTriangles.resize(pass->Bins.size());
+        for (auto& binTriangles : pass->BinTriangles)
+            binTriangles.clear();
+
+        const auto addTriangle = [&](const std::array<glm::vec3, 3>& screen) {
+            auto triangle = ScreenTriangle{};
+            if (!SetupTriangle(screen, width, height, triangle))
+                return;
+            const auto index = static_cast<unsigned int>(pass->Triangles.size());
+            pass->Triangles.push_back(triangle);
+            for (auto binY = triangle.MinY / static_cast<int>(BinHeight); binY <= triangle.MaxY / static_cast<int>(BinHeight); binY++) {
+                for (auto binX = triangle.MinX / static_cast<int>(BinWidth); binX <= triangle.MaxX / static_cast<int>(BinWidth); binX++)
+                    pass->BinTriangles[binY * binsPerRow + binX].push_back(index);
+            }
+        };
+
+        // Vertices are projected once, triangles entirely outside one side of the frustum are dropped and those that cross the near plane clipped
+        auto& clip = pass->Clip;
+        auto& outside = pass->Outside;
+        auto& screen = pass->Screen;
+        for (const auto& instance : instances) {
+            CHARIS_ASSERT(instance.Occluder < m->Meshes.size(), "Culler has no occluder at index ", instance.Occluder, ".");
+            const auto& mesh = m->Meshes[instance.Occluder];
+            const auto modelViewProjection = viewProjection * instance.Transform;
+            const auto vertexCount = (instance.Occluder + 1 < m->Meshes.size() ? m->Meshes[instance.Occluder + 1].FirstPosition : static_cast<unsigned int>(m->Positions.size())) - mesh.FirstPosition;
+            clip.resize(vertexCount);
+            outside.resize(vertexCount);
+            screen.resize(vertexCount);
+            for (unsigned int i = 0; i < vertexCount; i++) {
+                clip[i] = modelViewProjection * glm::vec4(m->Positions[mesh.FirstPosition + i], 1.0f);
+                outside[i] = OutsideBits(clip[i]);
+                if ((outside[i] & Near) == 0)
+                    screen[i] = ToScreen(clip[i], width, height);
+            }
+
+            m->Last.Triangles += mesh.NumberOfIndices / 3;
+            for (unsigned int i = 0; i < mesh.NumberOfIndices; i += 3) {
+                const auto* index = &m->Indices[mesh.FirstIndex + i];
+                if ((outside[index[0]] & outside[index[1]] & outside[index[2]]) != 0)
+                    continue;
+                if (((outside[index[0]] | outside[index[1]] | outside[index[2]]) & Near) == 0) {
+                    addTriangle({ screen[index[0]], screen[index[1]], screen[index[2]] });
+                    continue;
+                }
+
+                std::array<std::array<glm::vec4, 3>, 2> clipped{};
+                const auto parts = ClipNear({ clip[index[0]], clip[index[1]], clip[index[2]] }, clipped);
+                for (unsigned int part = 0; part < parts; part++)
+                    addTriangle({ ToScreen(clipped[part][0], width, height), ToScreen(clipped[part][1], width, height), ToScreen(clipped[part][2], width, height) });
+            }
+        }
+
+        for (unsigned int bin = 0; bin < pass->Bins.size(); bin++) {
+            if (!pass->BinTriangles[bin].empty())
+                pass->WorkBins.push_back(bin);
+        }
+        pass->Done = std::make_unique<std::latch>(static_cast<std::ptrdiff_t>(pass->WorkBins.size()));
+
+        // Every bin owns its pixels and tiles, so the bins need no locks and the result does not depend on which thread took which bin
+        // A few triangles are done before a worker would even wake up, and a single core gains nothing from helpers
+        const auto workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        const auto helpers = pass->Triangles.size() < ParallelTriangles || pass->WorkBins.empty() ? 0 : std::min<size_t>(pass->WorkBins.size() - 1, workers);
+        for (size_t i = 0; i < helpers; i++)
+            PrivateGlobal::WorkerPool::Submit([pass]() { RasterizeBins(*pass); });
+        RasterizeBins(*pass);
+        pass->Done->wait();
+
+        m->Last.RasterizeMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        PrivateGlobal::Statistics::CountOcclusionRasterization(m->Last.Triangles, m->Last.RasterizeMilliseconds);
+    }
+
+    bool OcclusionCuller::IsVisible(const BoundingBox& box)
+    {
+        const auto count = [&](bool visible) {
+            if (visible) {
+                m->Last.Visible++;
+            }
+            else {
+                m->Last.Occluded++;
+                PrivateGlobal::Statistics::CountOcclusion(1);
+            }
+            return visible;
+        };
+        if (box.IsEmpty())
+            return count(false);
+
+        // Bounds of the corners on screen, and the depth of the nearest one
+        auto lower = glm::vec3(std::numeric_limits<float>::max());
+        auto upper = glm::vec3(std::numeric_limits<float>::lowest());
+        for (unsigned int i = 0; i < 8; i++) {
+            const auto corner = glm::vec3((i & 1) ? box.Max.x : box.Min.x, (i & 2) ? box.Max.y : box.Min.y, (i & 4) ? box.Max.z : box.Min.z);
+            const auto clip = m->ViewProjection * glm::vec4(corner, 1.0f);
+            if (clip.z < -clip.w || clip.w <= 0.0f)
+                return count(true);
+            const auto ndc = glm::vec3(clip) / clip.w;
+            lower = glm::min(lower, ndc);
+            upper = glm::max(upper, ndc);
+        }
+        const auto nearest = 0.5f * lower.z + 0.5f;
+
+        // Every pixel the box touches, not only those whose centers it covers
+        const auto width = static_cast<float>(m->Width);
+        const auto height = static_cast<float>(m->Height);
+        const auto minX = static_cast<int>(std::floor(std::clamp((0.5f * lower.x + 0.5f) * width, -1.0f, width)));
+        const auto maxX = static_cast<int>(std::ceil(std::clamp((0.5f * upper.x + 0.5f) * width, -1.0f, width + 1.0f))) - 1;
+        const auto minY = static_cast<int>(std::floor(std::clamp((0.5f * lower.y + 0.5f) * height, -1.0f, height)));
+        const auto maxY = static_cast<int>(std::ceil(std::clamp((0.5f * upper.y + 0.5f) * height, -1.0f, height + 1.0f))) - 1;
+        const auto rect = PixelRect{ std::max(minX, 0), std::min(maxX, static_cast<int>(m->Width) - 1), std::max(minY, 0), std::min(maxY, static_cast<int>(m->Height) - 1) };
+        if (rect.MinX > rect.MaxX || rect.MinY > rect.MaxY)
+            return count(false);
+
+        // Tiles whose farthest depth is nearer than the box hide their part of it, otherwise the pixels the box covers are checked
+        const auto tileSize = static_cast<int>(TileSize);
+        const auto tilesPerRow = m->Width / TileSize;
+        for (auto tileY = rect.MinY / tileSize; tileY <= rect.MaxY / tileSize; tileY++) {
+            for (auto tileX = rect.MinX / tileSize; tileX <= rect.MaxX / tileSize; tileX++) {
+                if (m->TileDepths[static_cast<size_t>(tileY) * tilesPerRow + tileX] < nearest)
+                    continue;
+                const auto x0 = std::max(tileX * tileSize, rect.MinX);
+                const auto x1 = std::min(tileX * tileSize + tileSize - 1, rect.MaxX);
+                const auto y0 = std::max(tileY * tileSize, rect.MinY);
+                const auto y1 = std::min(tileY * tileSize + tileSize - 1, rect.MaxY);
+                if (x1 - x0 + 1 == tileSize && y1 - y0 + 1 == tileSize)
+                    return count(true);
+                for (auto y = y0; y <= y1; y++) {
+                    const float* row = m->Depths.data() + static_cast<size_t>(y) * m->Width;
+                    for (auto x = x0; x <= x1; x++) {
+                        if (row[x] >= nearest)
+                            return count(true);
+                    }
+                }
+            }
+        }
+        return count(false);
+    }
+
+    bool OcclusionCuller::IsVisible(const BoundingBox& localBox, const glm::mat4& transform)
+    {
+        return IsVisible(localBox.Transformed(transform));
+    }
+
+    const std::vector<unsigned int>& OcclusionCuller::Cull(std::span<const BoundingBox> boxes, std::span<const unsigned int> indices)
+    {
+        auto& visible = m->Visible;
+        visible.clear();
+        for (auto index : indices) {
+            CHARIS_ASSERT(index < boxes.size(), "Culler has no box at index ", index, ".");
+            if (IsVisible(boxes[index]))
+                visible.push_back(index);
+        }
+        return visible;
+    }
+
+    OcclusionCuller::Counts OcclusionCuller::LastCounts() const
+    {
+        return m->Last;
+    }
+
+    unsigned int OcclusionCuller::Width() const
+    {
+        return m->Width;
+    }
+
+    unsigned int OcclusionCuller::Height() const
+    {
+        return m->Height;
+    }
+
+    std::span<const float> OcclusionCuller::Depths() const
+    {
+        return m->Depths;
+    }
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "Bounds.h"
+#include <vector>
+#include <span>
+#include <memory>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	struct OcclusionPass;
+
+	/// <summary>
+	/// Culls objects hidden behind occluders, by rasterizing the occluders on the CPU into a small depth buffer and testing boxes against it.
+	/// Occluders are triangle meshes kept on the CPU, typically a few large, simple shapes like walls and floors that lie inside the components they stand for.
+	/// The buffer is split into bins that are rasterized in parallel on the worker threads, and every 8 by 8 tile keeps its farthest depth,
+	/// so most boxes are accepted or rejected from a handful of tiles. Results only depend on the inputs, not on the threads or their timing.
+	/// Rasterizing and testing add the occluder triangles, the rasterization time and the occluded and visible counts to Utility::FrameStatistics.
+	/// </summary>
+	class OcclusionCuller
+	{
+	public:
+		/// <summary>Constructor for an OcclusionCuller.</summary>
+		/// <param name="width">Width of the depth buffer in pixels, a multiple of 8.</param>
+		/// <param name="height">Height of the depth buffer in pixels, a multiple of 8.</param>
+		OcclusionCuller(unsigned int width = 256, unsigned int height = 128);
+
+		/// <summary>Adds occluder geometry. Returns the index of the occluder, counting from 0 in the order they were added.</summary>
+		/// <param name="vertexAttributes">Pointer to the vertex attributes, of which the first three floats of every vertex are the position.</param>
+		/// <param name="floatsPerVertex">Number of floats per vertex.</param>
+		/// <param name="numberOfVertices">Number of vertices.</param>
+		/// <param name="indices">Pointer to indices to vertices, where every three indices make up a triangle. Either winding is fine.</param>
+		/// <param name="numberOfIndices">Number of indices.</param>
+		unsigned int AddOccluder(const float* vertexAttributes, unsigned int floatsPerVertex, unsigned int numberOfVertices, const unsigned int* indices, unsigned int numberOfIndices);
+		/// <summary>Adds a solid box as occluder geometry. Returns the index of the occluder, see AddOccluder.</summary>
+		unsigned int AddOccluder(const BoundingBox& box);
+		/// <summary>Removes all occluders.</summary>
+		void ClearOccluders();
+
+		/// <summary>An occluder placed in the world.</summary>
+		struct Instance {
+			unsigned int Occluder{};
+			glm::mat4 Transform = glm::mat4(1.0f);
+		};
+		/// <summary>
+		/// Clears the depth buffer and rasterizes the occluder instances into it, as seen through the view projection.
+		/// Boxes are tested against this buffer until the next call. The calling thread works on the bins as well, so it never waits on jobs queued before it.
+		/// Must not be called from a worker thread.
+		/// </summary>
+		/// <param name="viewProjection">Projection matrix times view matrix, with clip space depth in [-w, w] as made by glm::perspective.</param>
+		/// <param name="instances">Occluders to rasterize.</param>
+		void Rasterize(const glm::mat4& viewProjection, std::span<const Instance> instances);
+
+		/// <summary>
+		/// Checks if any part of a box in world coordinates could be visible past the occluders. Boxes outside the depth buffer are not visible,
+		/// and boxes that cross the near plane always are. Test boxes against the frustum first, since those outside it cost as much to test as the others.
+		/// </summary>
+		bool IsVisible(const BoundingBox& box);
+		/// <summary>Checks a box in the local coordinates of a transform, see IsVisible for world boxes.</summary>
+		bool IsVisible(const BoundingBox& localBox, const glm::mat4& transform);
+		/// <summary>
+		/// Tests the boxes at the given indices, for example those left by FrustumCuller::Cull. Returns the indices of the visible boxes, in the same order.
+		/// The list is valid until the next call to Cull.
+		/// </summary>
+		/// <param name="boxes">Boxes in world coordinates.</param>
+		/// <param name="indices">Indices of the boxes to test.</param>
+		const std::vector<unsigned int>& Cull(std::span<const BoundingBox> boxes, std::span<const unsigned int> indices);
+
+		struct Counts {
+			unsigned int Triangles{};
+			float RasterizeMilliseconds{};
+			unsigned int Visible{};
+			unsigned int Occluded{};
+		};
+		/// <summary>Returns the triangles rasterized and time taken by the last Rasterize, and the boxes tested since.</summary>
+		Counts LastCounts() const;
+
+		unsigned int Width() const;
+		unsigned int Height() const;
+		/// <summary>Returns the depth buffer, row by row from the bottom, with depth in [0, 1] where 1 is the far plane and nothing rasterized.</summary>
+		std::span<const float> Depths() const;
+
+	private:
+		struct OcclusionCullerMember {
+			unsigned int Width{};
+			unsigned int Height{};
+			std::vector<float> Depths;
+			// Farthest depth of every 8 by 8 tile
+			std::vector<float> TileDepths;
+
+			// Occluder meshes as positions and indices, one range of each per occluder
+			std::vector<glm::vec3> Positions;
+			std::vector<unsigned int> Indices;
+			struct Mesh {
+				unsigned int FirstPosition{};
+				unsigned int FirstIndex{};
+				unsigned int NumberOfIndices{};
+			};
+			std::vector<Mesh> Meshes;
+
+			glm::mat4 ViewProjection = glm::mat4(1.0f);
+			// Scratch of the last Rasterize, reused unless a worker still holds on to it
+			std::shared_ptr<OcclusionPass> Pass;
+			std::vector<unsigned int> Visible;
+			Counts Last{};
+		};
+		std::shared_ptr<OcclusionCullerMember> m;
+	};
+
+}
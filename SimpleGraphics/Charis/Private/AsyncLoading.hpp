@@ -0,0 +1,179 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// Background threads for the CPU side of loading, like parsing model files and decoding images. They never touch GL.
+		// Every worker has its own job queue. Jobs submitted by a worker go to its own queue and are taken newest first, 
+		// while idle workers steal the oldest jobs of the others, so a burst of jobs from one load spreads over all threads.
+		struct WorkerPool {
+			struct Queue {
+				std::mutex Mutex;
+				std::deque<std::function<void()>> Jobs;
+			};
+			inline static std::vector<std::thread> Threads;
+			inline static std::vector<std::unique_ptr<Queue>> Queues;
+			inline static thread_local int WorkerIndex = -1;
+			inline static std::atomic<unsigned int> NextQueue = 0;
+			inline static std::atomic<size_t> Pending = 0;
+			inline static std::mutex SleepMutex;
+			inline static std::condition_variable JobAdded;
+			inline static bool Stopping = false;
+
+			// Runs the job on one of the worker threads, which are started on first use.
+			static void Submit(std::function<void()> job)
+			{
+				if (WorkerIndex == -1)
+					Start();
+
+				// Jobs from outside the pool are spread over the queues
+				// Counted before it is queued, so a worker that takes it right away never sees fewer jobs than it took
+				{
+					std::lock_guard lock(SleepMutex);
+					Pending++;
+				}
+				const auto index = WorkerIndex != -1 ? WorkerIndex : NextQueue++ % Queues.size();
+				{
+					std::lock_guard lock(Queues[index]->Mutex);
+					Queues[index]->Jobs.push_back(std::move(job));
+				}
+				JobAdded.notify_one();
+			}
+
+			// Joins all threads. Jobs that have not started yet are dropped.
+			static void Stop()
+			{
+				{
+					std::lock_guard lock(SleepMutex);
+					Stopping = true;
+				}
+				JobAdded.notify_all();
+				for (auto& thread : Threads)
+					thread.join();
+				Threads.clear();
+				Queues.clear();
+				Pending = 0;
+				Stopping = false;
+			}
+
+		private:
+			static void Start()
+			{
+				std::lock_guard lock(SleepMutex);
+				if (!Threads.empty())
+					return;
+
+				const auto count = std::max(2u, std::thread::hardware_concurrency()) - 1;
+				for (unsigned int i = 0; i < count; i++)
+					Queues.push_back(std::make_unique<Queue>());
+				for (unsigned int i = 0; i < count; i++)
+					Threads.emplace_back(Work, static_cast<int>(i));
+			}
+
+			static bool TakeJob(int index, std::function<void()>& job)
+			{
+				// Newest job of the own queue first, it is most likely still in cache
+				{
+					auto& own = *Queues[index];
+					std::lock_guard lock(own.Mutex);
+					if (!own.Jobs.empty()) {
+						job = std::move(own.Jobs.back());
+						own.Jobs.pop_back();
+						return true;
+					}
+				}
+				// Otherwise steal the oldest job of another worker
+				for (size_t offset = 1; offset < Queues.size(); offset++) {
+					auto& other = *Queues[(index + offset) % Queues.size()];
+					std::lock_guard lock(other.Mutex);
+					if (!other.Jobs.empty()) {
+						job = std::move(other.Jobs.front());
+						other.Jobs.pop_front();
+						return true;
+					}
+				}
+				return false;
+			}
+
+			static void Work(int index)
+			{
+				WorkerIndex = index;
+				while (true) {
+					{
+						std::unique_lock lock(SleepMutex);
+						JobAdded.wait(lock, []() { return Stopping || Pending > 0; });
+						if (Stopping)
+							return;
+					}
+
+					std::function<void()> job;
+					if (!TakeJob(index, job))
+						continue;
+					Pending--;
+					job();
+				}
+			}
+		};
+
+		// GL work handed from the workers to the main thread. StartFrame drains it within a per frame budget so loading never causes frame spikes.
+		struct UploadQueue {
+			struct Job {
+				// Estimate of the bytes the job uploads, counted against the budget.
+				size_t Bytes{};
+				std::function<void()> Run;
+			};
+			inline static std::deque<Job> Jobs;
+			inline static std::mutex Mutex;
+			inline static size_t BudgetBytes = 16 << 20;
+			inline static float BudgetMilliseconds = 2.0f;
+
+			static void Push(Job job)
+			{
+				std::lock_guard lock(Mutex);
+				Jobs.push_back(std::move(job));
+			}
+
+			// Runs jobs until the byte or time budget of the frame is used up. At least one job runs every frame so large uploads still make progress.
+			static void Drain()
+			{
+				const auto start = std::chrono::steady_clock::now();
+				size_t bytes = 0;
+				while (true) {
+					Job job;
+					{
+						std::lock_guard lock(Mutex);
+						if (Jobs.empty())
+							return;
+						job = std::move(Jobs.front());
+						Jobs.pop_front();
+					}
+					job.Run();
+
+					bytes += job.Bytes;
+					const auto milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+					if (bytes >= BudgetBytes || milliseconds >= BudgetMilliseconds)
+						return;
+				}
+			}
+
+			static void Clear()
+			{
+				std::lock_guard lock(Mutex);
+				Jobs.clear();
+			}
+		};
+
+	}
+
+}
\ No newline at end of file
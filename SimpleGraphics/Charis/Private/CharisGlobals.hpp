@@ -1,29 +1,305 @@
-#pragma once
-#include <array>
-
-// Libraries
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-namespace Charis {
-
-	namespace PrivateGlobal {
-
-		inline GLFWwindow* Window = nullptr;
-		struct Window {
-			inline static unsigned int Width{};
-			inline static unsigned int Height{};
-		};
-
-		inline std::array<float, 3> BackgroundRGB{};
-
-		struct Mouse {
-			inline static float X{};
-			inline static float Y{};
-			inline static float Wheel{};
-		};
-
-
-	}
-
+#pragma once
+#include "GLExtensions.hpp"
+#include "../Utility.h"
+#include "../FrameConstants.h"
+#include "../Initialize.h"
+#include <array>
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <chrono>
+
+// Libraries
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		inline GLFWwindow* Window = nullptr;
+		struct Window {
+			inline static unsigned int Width{};
+			inline static unsigned int Height{};
+		};
+
+		inline std::array<float, 3> BackgroundRGB{};
+
+		// Render target of headless contexts, which have no default framebuffer. Stays bound for the whole session.
+		struct Offscreen {
+			inline static bool Headless = false;
+			inline static unsigned int FBO{};
+			inline static unsigned int ColorRBO{};
+			inline static unsigned int DepthRBO{};
+		};
+
+		// Settings of SetFramePacing, and the fence of every frame in flight. Buffers that Charis writes every frame have a part per frame in flight,
+		// which the CPU only writes again once EndFrame has waited on the fence of the frame that last used it.
+		struct FrameSync {
+			static constexpr unsigned int MaxFramesInFlight = 4;
+			inline static FramePacing Pacing{};
+			// Part of the per frame buffers of the current frame
+			inline static unsigned int Current{};
+			// Counts the frames ended, so per frame allocators can tell that a new frame has started
+			inline static std::uint64_t Frame{};
+			inline static std::array<GLsync, MaxFramesInFlight> Fences{};
+			// Start of the frame, for the target frame rate
+			inline static std::chrono::steady_clock::time_point FrameStart{};
+			// Set when LateInputSampling left the pacing and input of the next frame to StartFrame
+			inline static bool PacePending{};
+		};
+
+		// Uniform buffer of the FrameConstants block, created by the first StartFrame that fills it. Holds the constants of every frame in flight.
+		struct FrameConstantsBuffer {
+			inline static unsigned int UBO{};
+			// Bytes between the constants of two frames, a multiple of the uniform buffer offset alignment
+			inline static size_t Stride{};
+		};
+
+		// View of the last StartFrame that was given one, for picking levels of detail and culling meshlets.
+		struct CurrentView {
+			inline static FrameView View{};
+			inline static bool Given{};
+		};
+
+		// Settings of Utility::SetLevelOfDetailSelection.
+		struct LevelOfDetailSelection {
+			inline static float PixelError = 1.0f;
+			inline static float Hysteresis = 0.25f;
+		};
+
+		struct Readback {
+			inline static std::function<void(const unsigned char*, unsigned int, unsigned int)> Sink;
+			inline static std::vector<unsigned char> Pixels;
+		};
+
+		struct Mouse {
+			inline static float X{};
+			inline static float Y{};
+			inline static float Wheel{};
+		};
+
+		// Per-instance attribute buffers used by Shader::DrawInstanced, one per frame in flight. The uploads of a frame follow each other in its buffer.
+		struct InstanceBuffers {
+			inline static std::array<unsigned int, FrameSync::MaxFramesInFlight> VBO{};
+			inline static std::array<size_t, FrameSync::MaxFramesInFlight> Capacity{};
+			inline static std::array<size_t, FrameSync::MaxFramesInFlight> Used{};
+		};
+
+		// Handler of Utility::SetDiagnosticHandler, empty for printing to std::cerr.
+		struct Diagnostics {
+			inline static Utility::DiagnosticHandler Handler;
+		};
+		// Reports a message to the diagnostic handler.
+		void Diagnose(Utility::DiagnosticSeverity severity, const std::string& message);
+
+		// Destroys the resources released since the last call, see ResourceRegistry::DeferDestruction. Called on the thread of the GL context by EndFrame and CleanUp.
+		// Resources released after a CleanUp no longer have a context to delete their GL objects from, so Initialize destroys them without deleting any.
+		void DestroyReleasedResources(bool deleteObjects);
+
+		// Set when Shader::IsReady waited for the driver this frame, which it may only do once per frame without KHR_parallel_shader_compile.
+		struct ShaderCompilation {
+			inline static bool WaitedThisFrame{};
+		};
+
+		// Index type and byte offset of the first index of a component, as expected by the glDrawElements family. Index size is 2 or 4 bytes.
+		inline GLenum IndexType(unsigned int indexSize)
+		{
+			return indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		}
+		inline const void* IndexOffset(unsigned int firstIndex, unsigned int indexSize)
+		{
+			return reinterpret_cast<const void*>(static_cast<uintptr_t>(firstIndex) * indexSize);
+		}
+
+		// Counts of the GL work Charis submits, for Utility::GetFrameStatistics. EndFrame moves the counts of the current frame to the last frame.
+		struct Statistics {
+			inline static Utility::FrameStatistics Current{};
+			inline static Utility::FrameStatistics LastFrame{};
+
+			static void CountCall() { Current.GLCalls++; }
+			static void CountDraw(size_t triangles) { Current.DrawCalls++; Current.GLCalls++; Current.TrianglesDrawn += triangles; }
+			static void CountBind() { Current.Binds++; Current.GLCalls++; }
+			static void CountUpload(size_t bytes) { Current.GLCalls++; Current.UploadBytes += bytes; }
+			static void CountCulling(unsigned int visible, unsigned int culled) { Current.ObjectsVisible += visible; Current.ObjectsCulled += culled; }
+			static void CountLevelOfDetail(unsigned int drawn, unsigned int saved) { Current.LodTrianglesDrawn += drawn; Current.LodTrianglesSaved += saved; }
+			static void CountMeshlets(unsigned int visible, unsigned int culled, unsigned int trianglesCulled) { Current.MeshletsVisible += visible; Current.MeshletsCulled += culled; Current.MeshletTrianglesCulled += trianglesCulled; }
+			static void CountOcclusionRasterization(unsigned int triangles, float milliseconds) { Current.OccluderTriangles += triangles; Current.OcclusionMilliseconds += milliseconds; }
+			static void CountOcclusion(unsigned int occluded) { Current.ObjectsOccluded += occluded; }
+			static void EndFrame() { LastFrame = Current; Current = {}; }
+		};
+
+		/// <summary>
+		/// Shadow of the GL state that Charis changes. All Charis code binds through it so that unchanged state is never submitted again.
+		/// The setters return true when the state actually changed. Define CHARIS_CHECK_GL_STATE, or build with the paranoid CHARIS_CHECK_LEVEL, to cross-check the shadow against
+		/// glGet* on every call, which catches state changed behind Charis' back at the cost of a driver round trip per call.
+		/// </summary>
+		struct GLState {
+			inline static unsigned int Program{};
+			inline static unsigned int VertexArray{};
+			inline static unsigned int ActiveTexture{};
+			inline static std::array<unsigned int, 32> Textures{};
+			inline static bool DepthTest{};
+			inline static bool Blend{};
+			inline static bool CullFace{};
+			inline static std::array<float, 4> ClearColor{};
+
+			static bool UseProgram(unsigned int program)
+			{
+				Check(GL_CURRENT_PROGRAM, Program, "program");
+				if (program == Program)
+					return false;
+				glUseProgram(program);
+				Statistics::CountBind();
+				Program = program;
+				return true;
+			}
+
+			static bool BindVertexArray(unsigned int vertexArray)
+			{
+				Check(GL_VERTEX_ARRAY_BINDING, VertexArray, "vertex array");
+				if (vertexArray == VertexArray)
+					return false;
+				glBindVertexArray(vertexArray);
+				Statistics::CountBind();
+				VertexArray = vertexArray;
+				return true;
+			}
+
+			static bool SetActiveTexture(unsigned int binding)
+			{
+				Check(GL_ACTIVE_TEXTURE, GL_TEXTURE0 + ActiveTexture, "active texture");
+				if (binding == ActiveTexture)
+					return false;
+				glActiveTexture(GL_TEXTURE0 + binding);
+				Statistics::CountCall();
+				ActiveTexture = binding;
+				return true;
+			}
+
+			static bool BindTexture(unsigned int binding, unsigned int texture)
+			{
+#if defined(CHARIS_CHECK_GL_STATE) || CHARIS_CHECK_LEVEL >= CHARIS_CHECK_PARANOID
+				SetActiveTexture(binding);
+				Check(GL_TEXTURE_BINDING_2D, Textures[binding], "texture binding");
+#endif
+				if (texture == Textures[binding])
+					return false;
+				SetActiveTexture(binding);
+				glBindTexture(GL_TEXTURE_2D, texture);
+				Statistics::CountBind();
+				Textures[binding] = texture;
+				return true;
+			}
+
+			// Binds a range of textures, with a single multi-bind call if available. Returns the number of bindings that changed.
+			static unsigned int BindTextures(unsigned int first, unsigned int count, const unsigned int* textures)
+			{
+				unsigned int changed = 0;
+				for (unsigned int i = 0; i < count; i++)
+					changed += textures[i] != Textures[first + i];
+				if (changed == 0 || !PrivateGL::BindTextures) {
+					for (unsigned int i = 0; i < count; i++)
+						BindTexture(first + i, textures[i]);
+					return changed;
+				}
+
+				PrivateGL::BindTextures(first, count, textures);
+				Statistics::CountCall();
+				Statistics::Current.Binds += changed;
+				for (unsigned int i = 0; i < count; i++)
+					Textures[first + i] = textures[i];
+				return changed;
+			}
+
+			static bool SetDepthTest(bool enabled)
+			{
+				Check(GL_DEPTH_TEST, DepthTest, "depth test");
+				if (enabled == DepthTest)
+					return false;
+				enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+				Statistics::CountCall();
+				DepthTest = enabled;
+				return true;
+			}
+
+			static bool SetBlend(bool enabled)
+			{
+				Check(GL_BLEND, Blend, "blend");
+				if (enabled == Blend)
+					return false;
+				enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+				Statistics::CountCall();
+				Blend = enabled;
+				return true;
+			}
+
+			static bool SetCullFace(bool enabled)
+			{
+				Check(GL_CULL_FACE, CullFace, "cull face");
+				if (enabled == CullFace)
+					return false;
+				enabled ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
+				Statistics::CountCall();
+				CullFace = enabled;
+				return true;
+			}
+
+			static bool SetClearColor(const std::array<float, 4>& RGBA)
+			{
+				if (RGBA == ClearColor)
+					return false;
+				glClearColor(RGBA[0], RGBA[1], RGBA[2], RGBA[3]);
+				Statistics::CountCall();
+				ClearColor = RGBA;
+				return true;
+			}
+
+			// Deleted objects are unbound by GL, and their names can be reused by new objects.
+			static void ForgetProgram(unsigned int program)
+			{
+				if (program == Program)
+					UseProgram(0);
+			}
+			static void ForgetVertexArray(unsigned int vertexArray)
+			{
+				if (vertexArray == VertexArray)
+					VertexArray = 0;
+			}
+			static void ForgetTexture(unsigned int texture)
+			{
+				for (auto& bound : Textures) {
+					if (bound == texture)
+						bound = 0;
+				}
+			}
+
+			// Restores the shadow to the defaults of a new context.
+			static void Reset()
+			{
+				Program = 0;
+				VertexArray = 0;
+				ActiveTexture = 0;
+				Textures = {};
+				DepthTest = false;
+				Blend = false;
+				CullFace = false;
+				ClearColor = {};
+			}
+
+		private:
+			static void Check([[maybe_unused]] GLenum state, [[maybe_unused]] unsigned int shadow, [[maybe_unused]] const char* name)
+			{
+#if defined(CHARIS_CHECK_GL_STATE) || CHARIS_CHECK_LEVEL >= CHARIS_CHECK_PARANOID
+				int actual = 0;
+				glGetIntegerv(state, &actual);
+				if (static_cast<unsigned int>(actual) != shadow)
+					Helper::AssertionFailed("GL state shadow in sync", __FILE__, __LINE__, "GL state shadow is out of sync for ", name, ": expected ", shadow, " but GL has ", actual, ".");
+#endif
+			}
+		};
+
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include "../Texture.h"
+#include <string>
+#include <vector>
+
+namespace Charis {
+
+	// An image decoded from file, with its channel count kept as stored and an optional mip chain. Decoding and mip generation never touch GL,
+	// so they can run on worker threads, while CreateTexture must run on the main thread.
+	struct DecodedImage {
+		std::string Path;
+		int Width{};
+		int Height{};
+		int Channels{};
+		// Full size image, allocated by stb_image.
+		unsigned char* Pixels = nullptr;
+		// Mip levels after the full size image, each half the size of the previous down to 1x1. Empty if GL should generate them.
+		std::vector<std::vector<unsigned char>> Mips;
+
+		float DecodeMilliseconds{};
+		float MipMilliseconds{};
+
+		DecodedImage() = default;
+		DecodedImage(DecodedImage&& other) noexcept;
+		DecodedImage& operator=(DecodedImage&& other) noexcept;
+		~DecodedImage();
+
+		// Decodes the image file. Aborts if it can not be read.
+		void Decode(const std::string& path);
+		// Builds the full mip chain by averaging blocks of 2x2 pixels, with blocks 3 wide or high at the last column or row of an odd size.
+		void GenerateMips();
+		// Total size of the pixels of all levels.
+		size_t Bytes() const;
+		// Creates a texture from the image and reports its timings to the texture load hook.
+		Texture CreateTexture(Texture::TextureType type) const;
+	};
+
+}
\ No newline at end of file
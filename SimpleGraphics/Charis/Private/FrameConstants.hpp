@@ -0,0 +1,47 @@
+#pragma once
+#include "../FrameConstants.h"
+#include <array>
+#include <cstddef>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// Memory layout of the FrameConstants block in FrameConstants::ShaderSource, following the std140 rules: 
+		// vec3 takes 16 bytes unless a float follows it, and structs and arrays start at 16 byte boundaries.
+		struct Std140DirectionalLight {
+			glm::vec3 Direction; float Padding0;
+			glm::vec3 Ambient; float Padding1;
+			glm::vec3 Diffuse; float Padding2;
+			glm::vec3 Specular; float Padding3;
+		};
+		struct Std140PointLight {
+			glm::vec3 Position; float Constant;
+			glm::vec3 Ambient; float Linear;
+			glm::vec3 Diffuse; float Quadratic;
+			glm::vec3 Specular; float Padding;
+		};
+		struct Std140FrameConstants {
+			glm::mat4 View;
+			glm::mat4 Projection;
+			glm::mat4 ViewProjection;
+			glm::vec3 CameraPosition;
+			float Time;
+			glm::vec2 Viewport;
+			int PointLightCount;
+			float Padding;
+			Std140DirectionalLight Directional;
+			std::array<Std140PointLight, FrameConstants::MaxPointLights> PointLights;
+		};
+		static_assert(offsetof(Std140FrameConstants, CameraPosition) == 192);
+		static_assert(offsetof(Std140FrameConstants, Viewport) == 208);
+		static_assert(offsetof(Std140FrameConstants, Directional) == 224);
+		static_assert(offsetof(Std140FrameConstants, PointLights) == 288);
+		static_assert(sizeof(Std140FrameConstants) == 288 + 64 * FrameConstants::MaxPointLights);
+
+	}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// Libraries
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace Charis {
+
+	// The bundled glad loader only covers OpenGL 3.3 core, while Charis requests a 4.6 context.
+	// Newer entry points are loaded here and stay null if the context has neither the GL version nor the extension that provides them, so callers must keep a 3.3 fallback.
+	namespace PrivateGL {
+
+		constexpr GLenum DRAW_INDIRECT_BUFFER = 0x8F3F;
+		constexpr GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+		constexpr GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+		constexpr GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+		constexpr GLenum COMPLETION_STATUS = 0x91B1;
+		constexpr GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+		constexpr GLbitfield MAP_COHERENT_BIT = 0x0080;
+		constexpr GLenum DEBUG_OUTPUT = 0x92E0;
+		constexpr GLenum DEBUG_OUTPUT_SYNCHRONOUS = 0x8242;
+		constexpr GLenum DEBUG_SEVERITY_HIGH = 0x9146;
+		constexpr GLenum DEBUG_SEVERITY_MEDIUM = 0x9147;
+		constexpr GLenum DEBUG_SEVERITY_LOW = 0x9148;
+		constexpr GLenum DEBUG_SEVERITY_NOTIFICATION = 0x826B;
+
+		using BindTexturesProc = void (APIENTRYP)(GLuint first, GLsizei count, const GLuint* textures);
+		inline BindTexturesProc BindTextures = nullptr;
+
+		using MultiDrawElementsIndirectProc = void (APIENTRYP)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+		inline MultiDrawElementsIndirectProc MultiDrawElementsIndirect = nullptr;
+
+		using TexStorage2DProc = void (APIENTRYP)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
+		inline TexStorage2DProc TexStorage2D = nullptr;
+
+		using BufferStorageProc = void (APIENTRYP)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+		inline BufferStorageProc BufferStorage = nullptr;
+
+		using GetProgramBinaryProc = void (APIENTRYP)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+		inline GetProgramBinaryProc GetProgramBinary = nullptr;
+
+		using ProgramBinaryProc = void (APIENTRYP)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+		inline ProgramBinaryProc ProgramBinary = nullptr;
+
+		using ProgramParameteriProc = void (APIENTRYP)(GLuint program, GLenum pname, GLint value);
+		inline ProgramParameteriProc ProgramParameteri = nullptr;
+
+		// Only loaded if KHR_parallel_shader_compile (or the ARB version) is supported, since COMPLETION_STATUS can only be queried then.
+		using MaxShaderCompilerThreadsProc = void (APIENTRYP)(GLuint count);
+		inline MaxShaderCompilerThreadsProc MaxShaderCompilerThreads = nullptr;
+
+		// KHR_debug, core since 4.3
+		using DebugMessageCallbackProc = void (APIENTRYP)(GLDEBUGPROC callback, const void* userParam);
+		inline DebugMessageCallbackProc DebugMessageCallback = nullptr;
+
+		using DebugMessageControlProc = void (APIENTRYP)(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled);
+		inline DebugMessageControlProc DebugMessageControl = nullptr;
+
+		// Loads an entry point if the context provides it, either by its GL version or by the extension that adds it.
+		// GLX and EGL hand out an address for any name, so an address alone does not tell that the driver supports the function.
+		template<class Proc>
+		inline Proc LoadIfSupported(const char* name, int major, int minor, const char* extension)
+		{
+			const bool inVersion = GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+			if (!inVersion && !glfwExtensionSupported(extension))
+				return nullptr;
+			return reinterpret_cast<Proc>(glfwGetProcAddress(name));
+		}
+
+		// Loads all entry points above. Must be called after a context has been made current and glad has been loaded.
+		inline void LoadExtensions()
+		{
+			BindTextures = LoadIfSupported<BindTexturesProc>("glBindTextures", 4, 4, "GL_ARB_multi_bind");
+			MultiDrawElementsIndirect = LoadIfSupported<MultiDrawElementsIndirectProc>("glMultiDrawElementsIndirect", 4, 3, "GL_ARB_multi_draw_indirect");
+			TexStorage2D = LoadIfSupported<TexStorage2DProc>("glTexStorage2D", 4, 2, "GL_ARB_texture_storage");
+			BufferStorage = LoadIfSupported<BufferStorageProc>("glBufferStorage", 4, 4, "GL_ARB_buffer_storage");
+			GetProgramBinary = LoadIfSupported<GetProgramBinaryProc>("glGetProgramBinary", 4, 1, "GL_ARB_get_program_binary");
+			ProgramBinary = LoadIfSupported<ProgramBinaryProc>("glProgramBinary", 4, 1, "GL_ARB_get_program_binary");
+			ProgramParameteri = LoadIfSupported<ProgramParameteriProc>("glProgramParameteri", 4, 1, "GL_ARB_get_program_binary");
+			DebugMessageCallback = LoadIfSupported<DebugMessageCallbackProc>("glDebugMessageCallback", 4, 3, "GL_KHR_debug");
+			DebugMessageControl = LoadIfSupported<DebugMessageControlProc>("glDebugMessageControl", 4, 3, "GL_KHR_debug");
+			if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+				MaxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+			else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+				MaxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+			else
+				MaxShaderCompilerThreads = nullptr;
+		}
+
+	}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "../Texture.h"
+#include "../Component.h"
+#include <string>
+#include <vector>
+#include <span>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <array>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// Vertex attributes of models constructed from a file, see Model::FloatsPerFileAttribute.
+		struct VertexAttributes {
+			glm::vec3 Position;
+			glm::vec3 Normal;
+			glm::vec2 TexCoords;
+			glm::vec3 Tangent;
+			glm::vec3 Bitangent;
+		};
+		constexpr unsigned int TotalFloats = 14;
+		static_assert(sizeof(VertexAttributes) == sizeof(float) * TotalFloats, "Number of floats in simple VertexAttributes struct must match number of attribute floats.");
+
+		// Vertex attributes of models constructed from a file with Model::Compact, see Model::CompactFileAttributes.
+		struct CompactVertexAttributes {
+			// Snorm position within the bounds of the mesh, w is the sign of the bitangent
+			std::int16_t Position[4];
+			// Snorm octahedral encoded unit vectors
+			std::int16_t Normal[2];
+			// Half floats
+			std::uint16_t TexCoords[2];
+			std::int16_t Tangent[2];
+		};
+		static_assert(sizeof(CompactVertexAttributes) == 20, "Compact vertex attributes must be tightly packed.");
+
+		// A read-only view of a whole file in memory. Empty if the file could not be opened.
+		class MappedFile {
+		public:
+			explicit MappedFile(const std::string& path);
+			~MappedFile();
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			std::span<const unsigned char> Bytes() const { return { m_Data, m_Size }; }
+		private:
+			const unsigned char* m_Data = nullptr;
+			size_t m_Size{};
+			void* m_File = nullptr;
+			void* m_Mapping = nullptr;
+		};
+
+		// Everything read from a model file, before any GL object is created. Filling it never touches GL, so it can happen on a worker thread.
+		struct MeshData {
+			// Point either into the owned vectors, when parsed from the model file, or into the mapped mesh cache.
+			std::span<const VertexAttributes> Vertices;
+			std::span<const unsigned int> Indices;
+			std::vector<VertexAttributes> OwnedVertices;
+			std::vector<unsigned int> OwnedIndices;
+			// Only filled for compact models, which then leave the full vertices and indices empty. 
+			// 16 bit indices are used for meshes of at most 65536 vertices, otherwise the 32 bit CompactLargeIndices.
+			std::vector<CompactVertexAttributes> CompactVertices;
+			std::vector<std::uint16_t> CompactIndices;
+			std::vector<unsigned int> CompactLargeIndices;
+			// Column major transform from the snorm positions back to model space
+			std::array<float, 16> PositionDequantization{};
+			// File names of the textures of the mesh, see SceneData::TextureFiles
+			std::vector<std::string> TextureFiles;
+			// Coarser levels of the mesh, generated after loading for models with Model::LodSettings. Not part of the mesh cache.
+			std::vector<LevelOfDetail> LevelsOfDetail;
+			// Meshlets of the full mesh, built after loading for models with Model::Meshlets clustering. Not part of the mesh cache either.
+			std::vector<Meshlet> Meshlets;
+		};
+		struct SceneData {
+			std::string Directory;
+			std::vector<MeshData> Meshes;
+			// Every texture file of the scene once, with the type of its first use
+			std::vector<std::pair<std::string, Texture::TextureType>> TextureFiles;
+			// Keeps the mesh cache mapped while meshes point into it
+			std::shared_ptr<MappedFile> Cache;
+		};
+
+		// The mesh cache stores the scene of a model file in "<model file>.charismesh", keyed by the size, modification time and content hash
+		// of the model file, the import flags and the vertex layout. Vertex and index blobs are page aligned so they can be used straight from the mapping.
+		// Note that only the model file itself is keyed, changes to files it references (like an OBJ material library) are not noticed.
+
+		// Fills the scene from the cache of the model file. Returns false if there is no valid cache for the file and flags.
+		bool ReadMeshCache(const std::string& modelPath, std::uint32_t importFlags, SceneData& sceneData);
+		// Writes the scene to the cache of the model file. Failing to write is not an error, the next load just parses the model file again.
+		void WriteMeshCache(const std::string& modelPath, std::uint32_t importFlags, const SceneData& sceneData);
+
+	}
+
+}
\ No newline at end of file
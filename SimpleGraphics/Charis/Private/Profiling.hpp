@@ -0,0 +1,15 @@
+#pragma once
+#include "../Utility.h"
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// Records the frame and its counts, and reads back the GPU zones of an earlier frame. Called by EndFrame before the counts are reset.
+		void ProfileFrame(const Utility::FrameStatistics& statistics);
+		// Deletes the timestamp queries of the GPU zones. Called by CleanUp while the context is still current.
+		void ReleaseProfilerQueries();
+
+	}
+
+}
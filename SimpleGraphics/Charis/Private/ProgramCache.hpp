@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// Directory of the program cache, see Utility::SetProgramCacheDirectory. Empty turns the cache off.
+		struct ProgramCacheSettings {
+			inline static std::string Directory = "CharisProgramCache";
+		};
+
+		// The program cache stores linked program binaries in "<directory>/<key>.charisprogram", keyed by a hash of the vertex and fragment source,
+		// including the defines of the shader, and of the vendor, renderer and version strings of the driver. A driver update changes the key,
+		// but a driver may still refuse a binary it made itself, so loading a binary can fail and must fall back to compiling.
+
+		// True if the cache is on and the driver can save and load program binaries. Needs a current context.
+		bool ProgramCacheAvailable();
+		// Key of a program. Needs a current context.
+		std::uint64_t ProgramCacheKey(const std::string& vertexCode, const std::string& fragmentCode);
+		// Reads the binary of a program. Returns false if there is no valid cache file for the key.
+		bool ReadProgramCache(std::uint64_t key, std::uint32_t& binaryFormat, std::vector<unsigned char>& binary);
+		// Writes the binary of a program. Failing to write is not an error, the next start just compiles the program again.
+		void WriteProgramCache(std::uint64_t key, std::uint32_t binaryFormat, std::span<const unsigned char> binary);
+
+	}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+// SIMD width of the CPU culling loops, AVX needs /arch:AVX (or -mavx) while SSE2 is always there on x64
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CHARIS_SIMD_LANES 8
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CHARIS_SIMD_LANES 4
+#else
+#define CHARIS_SIMD_LANES 1
+#endif
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// A register of CHARIS_SIMD_LANES floats and the few operations the culling loops need. Comparisons give all bits set in the lanes where they hold.
+		// Not defined when CHARIS_SIMD_LANES is 1, callers then only use their scalar loops.
+		namespace Simd {
+#if CHARIS_SIMD_LANES == 8
+			using Lanes = __m256;
+			inline Lanes Load(const float* values) { return _mm256_loadu_ps(values); }
+			inline void Store(float* values, Lanes a) { _mm256_storeu_ps(values, a); }
+			inline Lanes Broadcast(float value) { return _mm256_set1_ps(value); }
+			inline Lanes Plus(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+			inline Lanes Times(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+			inline Lanes Min(Lanes a, Lanes b) { return _mm256_min_ps(a, b); }
+			inline Lanes Max(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+			inline Lanes NotNegative(Lanes a) { return _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_GE_OQ); }
+			inline Lanes Less(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			inline Lanes And(Lanes a, Lanes b) { return _mm256_and_ps(a, b); }
+			// Lanes of a where the mask is set, b elsewhere
+			inline Lanes Select(Lanes mask, Lanes a, Lanes b) { return _mm256_blendv_ps(b, a, mask); }
+			inline int Bits(Lanes a) { return _mm256_movemask_ps(a); }
+#elif CHARIS_SIMD_LANES == 4
+			using Lanes = __m128;
+			inline Lanes Load(const float* values) { return _mm_loadu_ps(values); }
+			inline void Store(float* values, Lanes a) { _mm_storeu_ps(values, a); }
+			inline Lanes Broadcast(float value) { return _mm_set1_ps(value); }
+			inline Lanes Plus(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+			inline Lanes Times(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+			inline Lanes Min(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+			inline Lanes Max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+			inline Lanes NotNegative(Lanes a) { return _mm_cmpge_ps(a, _mm_setzero_ps()); }
+			inline Lanes Less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+			inline Lanes And(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+			// Lanes of a where the mask is set, b elsewhere
+			inline Lanes Select(Lanes mask, Lanes a, Lanes b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+			inline int Bits(Lanes a) { return _mm_movemask_ps(a); }
+#endif
+		}
+
+	}
+
+}
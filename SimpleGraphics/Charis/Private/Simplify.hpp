@@ -0,0 +1,20 @@
+#pragma once
+#include "MeshCache.hpp"
+#include <vector>
+#include <span>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		// Simplifies a triangle mesh by collapsing edges in order of their quadric error, until it has at most targetIndexCount indices
+		// or every remaining collapse would move the surface more than maxError. The error of a collapse also counts how much the normal and
+		// texture coordinates change, so details inside texture islands go before their outlines. Vertices on open borders and on seams,
+		// where vertices at the same position have different normals or texture coordinates, are never moved, so the mesh stays closed.
+		// Returns indices of the simplified mesh, into the same vertices, and sets error to the largest distance a collapse moved the surface.
+		// Never touches GL, so it can run on a worker thread.
+		std::vector<unsigned int> SimplifyMesh(std::span<const VertexAttributes> vertices, std::span<const unsigned int> indices, size_t targetIndexCount, float maxError, float& error);
+
+	}
+
+}
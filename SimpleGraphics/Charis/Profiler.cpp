@@ -0,0 +1,385 @@
+#include "Profiler.h"
+#include "Utility.h"
+#include "Private/Profiling.hpp"
+#include <vector>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+
+// Libraries
+#include <glad/glad.h>
+
+namespace {
+
+    enum class RecordKind : std::uint8_t {
+        CpuZone,
+        GpuZone,
+        Frame,
+        Counter
+    };
+
+    // One zone, frame or counter. Times are in nanoseconds since the first record, GPU times included.
+    struct Record {
+        RecordKind Kind;
+        std::uint8_t Depth;
+        std::uint16_t Thread;
+        std::uint32_t Name;
+        std::uint64_t Frame;
+        std::uint64_t Start;
+        // End of zones and frames, value of counters
+        std::uint64_t EndOrValue;
+    };
+    static_assert(sizeof(Record) == 32, "Profiler records must be tightly packed.");
+
+    constexpr char Magic[8] = { 'C', 'H', 'A', 'R', 'P', 'R', 'O', 'F' };
+    constexpr std::uint32_t Version = 1;
+
+    // Frames between issuing the timestamps of a GPU zone and reading them back
+    constexpr unsigned int GpuLatency = 4;
+    // Thread of the GPU zones and of the frames in the Chrome trace, past any real thread index
+    constexpr unsigned int GpuTrack = 0x10000;
+    constexpr unsigned int FrameTrack = 0x10001;
+
+    struct GpuZoneQueries {
+        std::uint32_t Name;
+        std::uint8_t Depth;
+        unsigned int Begin;
+        unsigned int End;
+        bool Ended;
+    };
+    // Queries of the GPU zones of one frame. The query objects are kept and reused once the frame has been read back.
+    struct GpuFrame {
+        std::uint64_t Frame{};
+        std::vector<GpuZoneQueries> Zones;
+        std::vector<unsigned int> Queries;
+        size_t UsedQueries{};
+    };
+
+    struct ProfilerState {
+        inline static std::atomic<bool> Enabled{};
+        // Guards the ring, the names and the frame number, CPU zones may end on any thread
+        inline static std::mutex Mutex;
+        inline static std::vector<Record> Ring = std::vector<Record>(1 << 16);
+        inline static size_t Next{};
+        inline static size_t Count{};
+        inline static std::vector<std::string_view> Names;
+        inline static std::unordered_map<std::string_view, std::uint32_t> NameIndices;
+        inline static std::uint16_t Threads{};
+        inline static std::uint64_t Frame{};
+        inline static std::uint64_t FrameStart{};
+        // Only touched on the thread of the GL context
+        inline static std::array<GpuFrame, GpuLatency> GpuFrames{};
+        inline static std::uint8_t GpuDepth{};
+        inline static std::int64_t GpuOffset{};
+        inline static bool GpuCalibrated{};
+    };
+
+    thread_local std::uint8_t CpuDepth{};
+
+    std::uint64_t Now()
+    {
+        static const auto start = std::chrono::steady_clock::now();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::uint16_t ThreadIndex()
+    {
+        thread_local int index = -1;
+        if (index == -1) {
+            std::lock_guard lock(ProfilerState::Mutex);
+            index = ProfilerState::Threads++;
+        }
+        return static_cast<std::uint16_t>(index);
+    }
+
+    // Index of a zone or counter name, needs the mutex
+    std::uint32_t NameIndex(const char* name)
+    {
+        const auto [it, added] = ProfilerState::NameIndices.try_emplace(name, static_cast<std::uint32_t>(ProfilerState::Names.size()));
+        if (added)
+            ProfilerState::Names.push_back(it->first);
+        return it->second;
+    }
+
+    // Needs the mutex
+    void Push(RecordKind kind, std::uint8_t depth, std::uint16_t thread, const char* name, std::uint64_t frame, std::uint64_t start, std::uint64_t endOrValue)
+    {
+        auto& ring = ProfilerState::Ring;
+        ring[ProfilerState::Next] = { kind, depth, thread, NameIndex(name), frame, start, endOrValue };
+        ProfilerState::Next = (ProfilerState::Next + 1) % ring.size();
+        ProfilerState::Count = std::min(ProfilerState::Count + 1, ring.size());
+    }
+
+    // The records oldest first
+    std::vector<Record> OrderedRecords()
+    {
+        const auto& ring = ProfilerState::Ring;
+        std::vector<Record> records;
+        records.reserve(ProfilerState::Count);
+        const auto first = (ProfilerState::Next + ring.size() - ProfilerState::Count) % ring.size();
+        for (size_t i = 0; i < ProfilerState::Count; i++)
+            records.push_back(ring[(first + i) % ring.size()]);
+        return records;
+    }
+
+    // Reads back the GPU zones of a frame whose timestamps have been reached, and drops the others instead of waiting for them
+    void ReadGpuFrame(GpuFrame& gpuFrame)
+    {
+        std::vector<Record> zones;
+        for (const auto& zone : gpuFrame.Zones) {
+            if (!zone.Ended)
+                continue;
+            int available = GL_FALSE;
+            glGetQueryObjectiv(zone.End, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(zone.Begin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(zone.End, GL_QUERY_RESULT, &end);
+            const auto start = static_cast<std::uint64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(begin) + ProfilerState::GpuOffset, 0));
+            zones.push_back({ RecordKind::GpuZone, zone.Depth, 0, zone.Name, gpuFrame.Frame, start, start + (end - begin) });
+        }
+
+        std::lock_guard lock(ProfilerState::Mutex);
+        auto& ring = ProfilerState::Ring;
+        for (const auto& record : zones) {
+            ring[ProfilerState::Next] = record;
+            ProfilerState::Next = (ProfilerState::Next + 1) % ring.size();
+            ProfilerState::Count = std::min(ProfilerState::Count + 1, ring.size());
+        }
+    }
+
+    // Chrome trace event names are JSON strings
+    std::string Escaped(std::string_view text)
+    {
+        std::string escaped;
+        for (const char c : text) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                escaped += c;
+        }
+        return escaped;
+    }
+
+}
+
+namespace Charis {
+
+    namespace Profiler {
+
+        void SetEnabled(bool enabled)
+        {
+            if (enabled && !ProfilerState::Enabled) {
+                std::lock_guard lock(ProfilerState::Mutex);
+                ProfilerState::FrameStart = Now();
+                // GPU zones of frames from before the profiler was stopped are not read back anymore
+                for (auto& gpuFrame : ProfilerState::GpuFrames) {
+                    gpuFrame.Zones.clear();
+                    gpuFrame.UsedQueries = 0;
+                }
+                ProfilerState::GpuCalibrated = false;
+            }
+            ProfilerState::Enabled = enabled;
+        }
+
+        bool IsEnabled()
+        {
+            return ProfilerState::Enabled;
+        }
+
+        void SetCapacity(size_t records)
+        {
+            Helper::RuntimeAssert(records > 0, "Profiler capacity must be at least one record.");
+            std::lock_guard lock(ProfilerState::Mutex);
+            ProfilerState::Ring.assign(records, {});
+            ProfilerState::Next = ProfilerState::Count = 0;
+        }
+
+        void Clear()
+        {
+            std::lock_guard lock(ProfilerState::Mutex);
+            ProfilerState::Next = ProfilerState::Count = 0;
+        }
+
+        bool ExportChromeTrace(const std::string& path)
+        {
+            std::ofstream file(path, std::ios::trunc);
+            if (!file)
+                return false;
+
+            std::lock_guard lock(ProfilerState::Mutex);
+            const auto records = OrderedRecords();
+            char line[256];
+            const auto microseconds = [](std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; };
+
+            file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << FrameTrack << ",\"args\":{\"name\":\"Frames\"}},\n";
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GpuTrack << ",\"args\":{\"name\":\"GPU\"}}";
+            for (unsigned int thread = 0; thread < ProfilerState::Threads; thread++)
+                file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\"CPU " << thread << "\"}}";
+
+            for (const auto& record : records) {
+                const auto name = Escaped(ProfilerState::Names[record.Name]);
+                if (record.Kind == RecordKind::Counter) {
+                    std::snprintf(line, sizeof(line), "\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{\"value\":%llu}}",
+                        microseconds(record.Start), static_cast<unsigned long long>(record.EndOrValue));
+                }
+                else {
+                    const auto track = record.Kind == RecordKind::GpuZone ? GpuTrack : record.Kind == RecordKind::Frame ? FrameTrack : record.Thread;
+                    std::snprintf(line, sizeof(line), "\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%llu}}",
+                        record.Kind == RecordKind::GpuZone ? "gpu" : "cpu", microseconds(record.Start), microseconds(record.EndOrValue - record.Start),
+                        track, static_cast<unsigned long long>(record.Frame));
+                }
+                file << ",\n{\"name\":\"" << name << line;
+            }
+            file << "\n]}\n";
+            return static_cast<bool>(file);
+        }
+
+        bool ExportBinary(const std::string& path)
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return false;
+
+            std::lock_guard lock(ProfilerState::Mutex);
+            const auto records = OrderedRecords();
+            const auto nameCount = static_cast<std::uint32_t>(ProfilerState::Names.size());
+            file.write(Magic, sizeof(Magic));
+            file.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+            file.write(reinterpret_cast<const char*>(&nameCount), sizeof(nameCount));
+            for (const auto& name : ProfilerState::Names) {
+                const auto length = static_cast<std::uint32_t>(name.size());
+                file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                file.write(name.data(), length);
+            }
+            const auto recordCount = static_cast<std::uint64_t>(records.size());
+            file.write(reinterpret_cast<const char*>(&recordCount), sizeof(recordCount));
+            file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(Record)));
+            return static_cast<bool>(file);
+        }
+
+        CpuZone::CpuZone(const char* name)
+        {
+            if (!ProfilerState::Enabled)
+                return;
+            m_Name = name;
+            CpuDepth++;
+            m_Start = Now();
+        }
+
+        CpuZone::~CpuZone()
+        {
+            if (m_Name == nullptr)
+                return;
+            const auto end = Now();
+            CpuDepth--;
+            const auto thread = ThreadIndex();
+            std::lock_guard lock(ProfilerState::Mutex);
+            Push(RecordKind::CpuZone, CpuDepth, thread, m_Name, ProfilerState::Frame, m_Start, end);
+        }
+
+        GpuZone::GpuZone(const char* name)
+        {
+            if (!ProfilerState::Enabled)
+                return;
+
+            // Line the GPU clock up with the CPU clock once, so both kinds of zones share a timeline
+            if (!ProfilerState::GpuCalibrated) {
+                GLint64 gpuTime = 0;
+                glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+                ProfilerState::GpuOffset = static_cast<std::int64_t>(Now()) - gpuTime;
+                ProfilerState::GpuCalibrated = true;
+            }
+
+            m_Frame = ProfilerState::Frame;
+            auto& gpuFrame = ProfilerState::GpuFrames[m_Frame % GpuLatency];
+            gpuFrame.Frame = m_Frame;
+            if (gpuFrame.UsedQueries + 2 > gpuFrame.Queries.size()) {
+                gpuFrame.Queries.resize(gpuFrame.UsedQueries + 2);
+                glGenQueries(2, &gpuFrame.Queries[gpuFrame.UsedQueries]);
+            }
+            const auto begin = gpuFrame.Queries[gpuFrame.UsedQueries];
+            const auto end = gpuFrame.Queries[gpuFrame.UsedQueries + 1];
+            gpuFrame.UsedQueries += 2;
+
+            glQueryCounter(begin, GL_TIMESTAMP);
+            std::uint32_t nameIndex{};
+            {
+                std::lock_guard lock(ProfilerState::Mutex);
+                nameIndex = NameIndex(name);
+            }
+            m_Zone = static_cast<int>(gpuFrame.Zones.size());
+            gpuFrame.Zones.push_back({ nameIndex, ProfilerState::GpuDepth++, begin, end, false });
+        }
+
+        GpuZone::~GpuZone()
+        {
+            if (m_Zone == -1)
+                return;
+            ProfilerState::GpuDepth--;
+            // Zones that outlive the frames it takes to read them back are dropped
+            auto& gpuFrame = ProfilerState::GpuFrames[m_Frame % GpuLatency];
+            if (gpuFrame.Frame != m_Frame || static_cast<size_t>(m_Zone) >= gpuFrame.Zones.size())
+                return;
+            auto& zone = gpuFrame.Zones[m_Zone];
+            glQueryCounter(zone.End, GL_TIMESTAMP);
+            zone.Ended = true;
+        }
+
+    }
+
+    namespace PrivateGlobal {
+
+        void ProfileFrame(const Utility::FrameStatistics& statistics)
+        {
+            if (!ProfilerState::Enabled)
+                return;
+
+            const auto end = Now();
+            {
+                std::lock_guard lock(ProfilerState::Mutex);
+                const auto frame = ProfilerState::Frame;
+                Push(RecordKind::Frame, 0, 0, "Frame", frame, ProfilerState::FrameStart, end);
+                Push(RecordKind::Counter, 0, 0, "DrawCalls", frame, end, statistics.DrawCalls);
+                Push(RecordKind::Counter, 0, 0, "Triangles", frame, end, statistics.TrianglesDrawn);
+                Push(RecordKind::Counter, 0, 0, "GLCalls", frame, end, statistics.GLCalls);
+                Push(RecordKind::Counter, 0, 0, "Binds", frame, end, statistics.Binds);
+                Push(RecordKind::Counter, 0, 0, "UploadBytes", frame, end, statistics.UploadBytes);
+                Push(RecordKind::Counter, 0, 0, "CpuWaitMicroseconds", frame, end, static_cast<std::uint64_t>(statistics.CpuWaitMilliseconds * 1000.0f));
+                Push(RecordKind::Counter, 0, 0, "GpuWaitMicroseconds", frame, end, static_cast<std::uint64_t>(statistics.GpuWaitMilliseconds * 1000.0f));
+                ProfilerState::Frame = frame + 1;
+                ProfilerState::FrameStart = end;
+            }
+
+            // The queries of the next frame were issued GpuLatency - 1 frames ago, read them back before they are reused
+            auto& gpuFrame = ProfilerState::GpuFrames[ProfilerState::Frame % GpuLatency];
+            ReadGpuFrame(gpuFrame);
+            gpuFrame.Zones.clear();
+            gpuFrame.UsedQueries = 0;
+            gpuFrame.Frame = ProfilerState::Frame;
+        }
+
+        void ReleaseProfilerQueries()
+        {
+            for (auto& gpuFrame : ProfilerState::GpuFrames) {
+                if (!gpuFrame.Queries.empty())
+                    glDeleteQueries(static_cast<GLsizei>(gpuFrame.Queries.size()), gpuFrame.Queries.data());
+                gpuFrame = {};
+            }
+            ProfilerState::GpuDepth = 0;
+            ProfilerState::GpuCalibrated = false;
+        }
+
+    }
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+namespace Charis {
+
+	/// <summary>
+	/// Records where frame time goes: nestable CPU zones, GPU zones timed with GL_TIMESTAMP queries, and the counts of Utility::GetFrameStatistics for every frame.
+	/// Everything is kept in a fixed size ring of compact records that can be exported as a Chrome trace (chrome://tracing or https://ui.perfetto.dev) or as the raw records.
+	/// Zones are placed with the CHARIS_PROFILE_ZONE and CHARIS_PROFILE_GPU_ZONE macros, which compile to nothing unless CHARIS_PROFILE is defined,
+	/// so they can stay in production builds. Charis has zones of its own when it is built with CHARIS_PROFILE. Frames and counters are recorded either way.
+	/// </summary>
+	namespace Profiler {
+
+		/// <summary>Starts or stops recording. Recording is off by default, and a stopped profiler costs one branch per zone and frame.</summary>
+		void SetEnabled(bool enabled);
+		bool IsEnabled();
+		/// <summary>Sets the number of records kept, the oldest are overwritten first. A zone or a counter of a frame is one 32 byte record. Clears the records.</summary>
+		void SetCapacity(size_t records);
+		// Drops all records.
+		void Clear();
+		/// <summary>Writes the records as Chrome trace event JSON. Returns false if the file could not be written.</summary>
+		bool ExportChromeTrace(const std::string& path);
+		/// <summary>
+		/// Writes the records as they are kept: the magic "CHARPROF", a version, the zone and counter names, then the records oldest first.
+		/// Returns false if the file could not be written.
+		/// </summary>
+		bool ExportBinary(const std::string& path);
+
+		/// <summary>Times the scope it lives in on the CPU. The name must outlive the profiler, like a string literal. Use CHARIS_PROFILE_ZONE instead of constructing it.</summary>
+		class CpuZone {
+		public:
+			explicit CpuZone(const char* name);
+			~CpuZone();
+			CpuZone(const CpuZone&) = delete;
+			CpuZone& operator=(const CpuZone&) = delete;
+		private:
+			const char* m_Name = nullptr;
+			std::uint64_t m_Start{};
+		};
+
+		/// <summary>
+		/// Times the GL commands submitted in the scope it lives in on the GPU. The timestamps are read back a few frames later, and dropped if the GPU
+		/// has not reached them by then, so reading them never waits. Only use it on the thread of the GL context. Use CHARIS_PROFILE_GPU_ZONE instead of constructing it.
+		/// </summary>
+		class GpuZone {
+		public:
+			explicit GpuZone(const char* name);
+			~GpuZone();
+			GpuZone(const GpuZone&) = delete;
+			GpuZone& operator=(const GpuZone&) = delete;
+		private:
+			// Frame and position of the zone in the queries of that frame, -1 when not recording
+			std::uint64_t m_Frame{};
+			int m_Zone = -1;
+		};
+
+	}
+
+}
+
+#define CHARIS_PROFILE_CONCATENATE_INNER(a, b) a##b
+#define CHARIS_PROFILE_CONCATENATE(a, b) CHARIS_PROFILE_CONCATENATE_INNER(a, b)
+#ifdef CHARIS_PROFILE
+// Times the rest of the enclosing scope on the CPU.
+#define CHARIS_PROFILE_ZONE(name) ::Charis::Profiler::CpuZone CHARIS_PROFILE_CONCATENATE(charisCpuZone, __LINE__)(name)
+// Times the rest of the enclosing scope on both the CPU and the GPU.
+#define CHARIS_PROFILE_GPU_ZONE(name) CHARIS_PROFILE_ZONE(name); ::Charis::Profiler::GpuZone CHARIS_PROFILE_CONCATENATE(charisGpuZone, __LINE__)(name)
+#else
+#define CHARIS_PROFILE_ZONE(name) ((void)0)
+#define CHARIS_PROFILE_GPU_ZONE(name) ((void)0)
+#endif
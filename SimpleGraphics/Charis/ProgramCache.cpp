@@ -0,0 +1,142 @@
+#include "Private/ProgramCache.hpp"
+#include "Private/GLExtensions.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <system_error>
+#include <functional>
+#include <thread>
+
+// Libraries
+#include <glad/glad.h>
+
+namespace {
+
+    constexpr char Magic[8] = { 'C', 'H', 'A', 'R', 'P', 'R', 'O', 'G' };
+    constexpr std::uint32_t Version = 1;
+
+    // File layout: header, then the binary as returned by glGetProgramBinary.
+    struct Header {
+        char Magic[8];
+        std::uint32_t Version;
+        std::uint32_t BinaryFormat;
+        std::uint64_t Key;
+        std::uint64_t BinarySize;
+    };
+
+    // FNV-1a, continued from a previous hash
+    std::uint64_t Hash(std::uint64_t hash, const void* data, size_t size)
+    {
+        const auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+    std::uint64_t Hash(std::uint64_t hash, const std::string& text)
+    {
+        // the length separates the strings, so moving text from one to the next changes the key
+        const auto length = static_cast<std::uint64_t>(text.size());
+        hash = Hash(hash, &length, sizeof(length));
+        return Hash(hash, text.data(), text.size());
+    }
+
+    std::string DriverString(GLenum name)
+    {
+        const auto text = reinterpret_cast<const char*>(glGetString(name));
+        return text != nullptr ? text : "";
+    }
+
+    std::string CachePath(std::uint64_t key)
+    {
+        char name[17]{};
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(Charis::PrivateGlobal::ProgramCacheSettings::Directory) / (std::string(name) + ".charisprogram")).string();
+    }
+
+}
+
+namespace Charis {
+
+    namespace PrivateGlobal {
+
+        bool ProgramCacheAvailable()
+        {
+            if (ProgramCacheSettings::Directory.empty() || !PrivateGL::GetProgramBinary || !PrivateGL::ProgramBinary || !PrivateGL::ProgramParameteri)
+                return false;
+            int formats = 0;
+            glGetIntegerv(PrivateGL::NUM_PROGRAM_BINARY_FORMATS, &formats);
+            return formats > 0;
+        }
+
+        std::uint64_t ProgramCacheKey(const std::string& vertexCode, const std::string& fragmentCode)
+        {
+            std::uint64_t key = 14695981039346656037ull;
+            key = Hash(key, DriverString(GL_VENDOR));
+            key = Hash(key, DriverString(GL_RENDERER));
+            key = Hash(key, DriverString(GL_VERSION));
+            key = Hash(key, vertexCode);
+            return Hash(key, fragmentCode);
+        }
+
+        bool ReadProgramCache(std::uint64_t key, std::uint32_t& binaryFormat, std::vector<unsigned char>& binary)
+        {
+            std::ifstream file(CachePath(key), std::ios::binary);
+            if (!file)
+                return false;
+
+            Header header{};
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(Header)))
+                return false;
+            if (std::memcmp(header.Magic, Magic, sizeof(Magic)) != 0 || header.Version != Version || header.Key != key)
+                return false;
+            // a binary larger than GL can take is a broken file
+            if (header.BinarySize == 0 || header.BinarySize > static_cast<std::uint64_t>(INT32_MAX))
+                return false;
+
+            binary.resize(static_cast<size_t>(header.BinarySize));
+            if (!file.read(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(binary.size())))
+                return false;
+            binaryFormat = header.BinaryFormat;
+            return true;
+        }
+
+        void WriteProgramCache(std::uint64_t key, std::uint32_t binaryFormat, std::span<const unsigned char> binary)
+        {
+            std::error_code error;
+            std::filesystem::create_directories(ProgramCacheSettings::Directory, error);
+            if (error)
+                return;
+
+            Header header{};
+            std::memcpy(header.Magic, Magic, sizeof(Magic));
+            header.Version = Version;
+            header.BinaryFormat = binaryFormat;
+            header.Key = key;
+            header.BinarySize = binary.size();
+
+            // Write next to the cache and rename, so another process starting at the same time never reads a half written file
+            const auto cachePath = CachePath(key);
+            const auto temporaryPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            {
+                std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+                if (!file)
+                    return;
+                file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+                file.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+            }
+            if (!std::filesystem::exists(temporaryPath, error) || std::filesystem::file_size(temporaryPath, error) != sizeof(Header) + binary.size()) {
+                std::filesystem::remove(temporaryPath, error);
+                return;
+            }
+
+            std::filesystem::rename(temporaryPath, cachePath, error);
+            if (error)
+                std::filesystem::remove(temporaryPath, error);
+        }
+
+    }
+
+}
@@ -0,0 +1,116 @@
+#include "RenderQueue.h"
+#include "Utility.h"
+#include "Profiler.h"
+#include "Private/CharisGlobals.hpp"
+#include <array>
+#include <bit>
+
+// Libraries
+#include <glad/glad.h>
+
+namespace {
+
+	// Sort key layout, most significant first: program | vertex array | texture set | depth, 16 bits each.
+	// Names and hashes are truncated, which can only make the grouping less tight, never the drawing wrong.
+	uint64_t SortKey(unsigned int program, unsigned int vertexArray, const std::array<unsigned int, 32>& textureIDs, float depth)
+	{
+		uint32_t textureHash = 2166136261u;
+		for (auto id : textureIDs) {
+			textureHash ^= id;
+			textureHash *= 16777619u;
+		}
+		// The bits of a non-negative float sort the same way as the float itself
+		const auto depthBits = std::bit_cast<uint32_t>(depth > 0.0f ? depth : 0.0f) >> 16;
+
+		return (static_cast<uint64_t>(program & 0xFFFF) << 48)
+			| (static_cast<uint64_t>(vertexArray & 0xFFFF) << 32)
+			| (static_cast<uint64_t>((textureHash ^ (textureHash >> 16)) & 0xFFFF) << 16)
+			| static_cast<uint64_t>(depthBits & 0xFFFF);
+	}
+
+	// Least significant digit radix sort of indices by their 64 bit keys, 8 bits per pass. Passes where every key has the same digit are skipped.
+	void RadixSort(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch)
+	{
+		const auto count = static_cast<uint32_t>(keys.size());
+		order.resize(count);
+		scratch.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			order[i] = i;
+
+		for (unsigned int shift = 0; shift < 64; shift += 8) {
+			auto histogram = std::array<uint32_t, 256>{};
+			for (auto key : keys)
+				histogram[(key >> shift) & 0xFF]++;
+			if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (auto& bucket : histogram) {
+				const auto size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+			for (auto index : order)
+				scratch[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+			order.swap(scratch);
+		}
+	}
+
+}
+
+namespace Charis {
+
+	void RenderQueue::Submit(const Shader& shader, const Component& component, Shader::Uniform modelUniform, const glm::mat4& modelMatrix, float depth)
+	{
+		const auto modelLocation = shader.UniformLocation(modelUniform);
+		const auto textureIDs = shader.TextureBindings(component).TextureIDs;
+
+		m_Keys.push_back(SortKey(shader.m->ID, component.m->VAO, textureIDs, depth));
+		m_Submissions.push_back({ &shader, &component, modelLocation, modelMatrix });
+	}
+
+	void RenderQueue::Submit(const Shader& shader, const Model& model, Shader::Uniform modelUniform, const glm::mat4& modelMatrix, float depth)
+	{
+		for (const auto& component : model.Components) {
+			Submit(shader, component, modelUniform, modelMatrix, depth);
+		}
+	}
+
+	void RenderQueue::EndFrame()
+	{
+		CHARIS_PROFILE_GPU_ZONE("RenderQueue::EndFrame");
+		m_Statistics = {};
+		RadixSort(m_Keys, m_Order, m_SortScratch);
+
+		using GLState = PrivateGlobal::GLState;
+		for (auto index : m_Order) {
+			const auto& submission = m_Submissions[index];
+			const auto& shader = *submission.ShaderToUse;
+			const auto& component = *submission.ComponentToDraw;
+
+			// The state shadow skips everything already bound by the previous draw
+			m_Statistics.ProgramSwitches += GLState::UseProgram(shader.m->ID);
+			m_Statistics.VertexArraySwitches += GLState::BindVertexArray(component.m->VAO);
+
+			// The same bindings as Shader::Draw, which unbinds the reserved bindings the component has no texture for
+			m_Statistics.TextureBinds += shader.BindTextures(shader.TextureBindings(component));
+
+			glUniformMatrix4fv(submission.ModelLocation, 1, GL_FALSE, &submission.ModelMatrix[0][0]);
+			PrivateGlobal::Statistics::CountCall();
+			shader.SetPositionDequantization(component);
+
+			// The element buffer is part of the vertex array state, so it does not need to be bound again.
+			// Components in a GeometryArena share the vertex array and are told apart by their offsets.
+			if (component.m->UsingIBO)
+				glDrawElementsBaseVertex(GL_TRIANGLES, component.m->NumberOfIndices, PrivateGlobal::IndexType(component.m->IndexSize), PrivateGlobal::IndexOffset(component.m->FirstIndex, component.m->IndexSize), component.m->BaseVertex);
+			else
+				glDrawArrays(GL_TRIANGLES, component.m->BaseVertex, component.m->NumberOfVertices);
+			PrivateGlobal::Statistics::CountDraw(component.Triangles());
+			m_Statistics.Draws++;
+		}
+
+		m_Submissions.clear();
+		m_Keys.clear();
+	}
+
+}
@@ -0,0 +1,46 @@
+#include "Resource.h"
+#include "Private/CharisGlobals.hpp"
+#include <mutex>
+#include <vector>
+
+namespace {
+    using namespace Charis;
+
+    struct DeferredDestruction {
+        ResourceRegistry::DestroyFunction Destroy;
+        std::uint32_t Index;
+    };
+
+    struct DestructionQueue {
+        inline static std::mutex Mutex;
+        inline static std::vector<DeferredDestruction> Queued;
+        // Swapped with Queued while destroying, so both keep their capacity
+        inline static std::vector<DeferredDestruction> Destroying;
+    };
+}
+
+namespace Charis {
+
+    void ResourceRegistry::DeferDestruction(DestroyFunction destroy, std::uint32_t index)
+    {
+        std::lock_guard lock(DestructionQueue::Mutex);
+        DestructionQueue::Queued.push_back({ destroy, index });
+    }
+
+    void PrivateGlobal::DestroyReleasedResources(bool deleteObjects)
+    {
+        // Destroying a member can release others, which are destroyed in the same call
+        while (true) {
+            {
+                std::lock_guard lock(DestructionQueue::Mutex);
+                if (DestructionQueue::Queued.empty())
+                    return;
+                DestructionQueue::Destroying.swap(DestructionQueue::Queued);
+            }
+            for (const auto& destruction : DestructionQueue::Destroying)
+                destruction.Destroy(destruction.Index, deleteObjects);
+            DestructionQueue::Destroying.clear();
+        }
+    }
+
+}
@@ -0,0 +1,551 @@
+#include "SceneIndex.h"
+#include "Culling.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include <algorithm>
+#include <array>
+
+namespace {
+    using namespace Charis;
+
+    float SurfaceArea(const BoundingBox& box)
+    {
+        if (box.IsEmpty())
+            return 0.0f;
+        const auto size = box.Max - box.Min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool Overlaps(const BoundingBox& a, const BoundingBox& b)
+    {
+        return a.Min.x <= b.Max.x && a.Max.x >= b.Min.x && a.Min.y <= b.Max.y && a.Max.y >= b.Min.y && a.Min.z <= b.Max.z && a.Max.z >= b.Min.z;
+    }
+
+    bool Overlaps(const BoundingSphere& sphere, const BoundingBox& box)
+    {
+        const auto closest = glm::clamp(sphere.Center, box.Min, box.Max);
+        const auto offset = closest - sphere.Center;
+        return !box.IsEmpty() && glm::dot(offset, offset) <= sphere.Radius * sphere.Radius;
+    }
+
+    // Distance along the ray to where it enters the box, or nothing if it misses the box within the range.
+    std::optional<float> EnterDistance(const BoundingBox& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance)
+    {
+        const auto toMin = (box.Min - origin) * inverseDirection;
+        const auto toMax = (box.Max - origin) * inverseDirection;
+        const auto enter = std::max({ std::min(toMin.x, toMax.x), std::min(toMin.y, toMax.y), std::min(toMin.z, toMax.z), 0.0f });
+        const auto exit = std::min({ std::max(toMin.x, toMax.x), std::max(toMin.y, toMax.y), std::max(toMin.z, toMax.z), maxDistance });
+        if (box.IsEmpty() || enter > exit)
+            return std::nullopt;
+        return enter;
+    }
+
+    enum class Containment { Outside, Intersecting, Inside };
+
+    Containment Classify(const Frustum& frustum, const BoundingBox& box)
+    {
+        if (box.IsEmpty())
+            return Containment::Outside;
+
+        const auto center = box.Center();
+        const auto extents = box.Extents();
+        auto result = Containment::Inside;
+        for (const auto& plane : frustum.Planes) {
+            const auto normal = glm::vec3(plane);
+            const auto distance = glm::dot(normal, center) + plane.w;
+            const auto radius = glm::dot(glm::abs(normal), extents);
+            if (distance + radius < 0.0f)
+                return Containment::Outside;
+            if (distance - radius < 0.0f)
+                result = Containment::Intersecting;
+        }
+        return result;
+    }
+
+}
+
+namespace Charis {
+
+    struct SceneIndex::Tree {
+        using Member = SceneIndexMember;
+
+        static BoundingBox BoxOf(const Node& node)
+        {
+            return { node.Min, node.Max };
+        }
+
+        static unsigned int AddNode(Member& index, unsigned int parent)
+        {
+            const auto empty = BoundingBox{};
+            index.Nodes.push_back({ empty.Min, 0, empty.Max, 0 });
+            index.Parents.push_back(parent);
+            return static_cast<unsigned int>(index.Nodes.size() - 1);
+        }
+
+        // Gives a node its own slots and the objects.
+        static void MakeLeaf(Member& index, unsigned int node, const ObjectId* objects, unsigned int count)
+        {
+            auto& leaf = index.Nodes[node];
+            leaf.Index = static_cast<unsigned int>(index.LeafSlots.size());
+            leaf.Count = count;
+            index.LeafSlots.resize(index.LeafSlots.size() + MaxLeafObjects, None);
+            for (unsigned int i = 0; i < count; i++) {
+                index.LeafSlots[leaf.Index + i] = objects[i];
+                index.Leaves[objects[i]] = node;
+            }
+        }
+
+        static BoundingBox ComputeBox(const Member& index, unsigned int node)
+        {
+            const auto& current = index.Nodes[node];
+            auto box = BoundingBox{};
+            if (current.Count == Interior) {
+                box.Add(BoxOf(index.Nodes[current.Index]));
+                box.Add(BoxOf(index.Nodes[current.Index + 1]));
+                return box;
+            }
+            for (unsigned int i = 0; i < current.Count; i++)
+                box.Add(index.Boxes[index.LeafSlots[current.Index + i]]);
+            return box;
+        }
+
+        // Refits the node and its ancestors, stopping at the first box that does not change.
+        static void RefitUp(Member& index, unsigned int node)
+        {
+            while (node != None) {
+                const auto box = ComputeBox(index, node);
+                auto& current = index.Nodes[node];
+                if (box.Min == current.Min && box.Max == current.Max)
+                    return;
+                current.Min = box.Min;
+                current.Max = box.Max;
+                node = index.Parents[node];
+            }
+        }
+
+        // Objects are copied together with their boxes for building, so binning and partitioning read memory in order.
+        struct BuildObject {
+            BoundingBox Box;
+            glm::vec3 Center;
+            ObjectId Object;
+        };
+
+        // Splits the objects by the surface area heuristic, evaluated at the borders of bins of equal width along each axis. Returns the split point.
+        static BuildObject* Split(BuildObject* begin, BuildObject* end, const BoundingBox& centers)
+        {
+            constexpr int Bins = 16;
+            struct Bin {
+                BoundingBox Box;
+                unsigned int Count{};
+            };
+
+            auto bestCost = std::numeric_limits<float>::max();
+            int bestAxis = -1;
+            int bestBin = 0;
+            for (int axis = 0; axis < 3; axis++) {
+                const auto extent = centers.Max[axis] - centers.Min[axis];
+                if (extent <= 0.0f)
+                    continue;
+
+                std::array<Bin, Bins> bins{};
+                const auto scale = Bins / extent;
+                for (auto object = begin; object != end; object++) {
+                    const auto bin = std::min(Bins - 1, static_cast<int>((object->Center[axis] - centers.Min[axis]) * scale));
+                    bins[bin].Box.Add(object->Box);
+                    bins[bin].Count++;
+                }
+
+                // Sweep from the right to get the cost of everything after each border, then from the left to add everything before it
+                std::array<float, Bins - 1> rightCosts{};
+                auto right = Bin{};
+                for (int i = Bins - 1; i > 0; i--) {
+                    right.Box.Add(bins[i].Box);
+                    right.Count += bins[i].Count;
+                    rightCosts[i - 1] = SurfaceArea(right.Box) * right.Count;
+                }
+                auto left = Bin{};
+                for (int i = 0; i < Bins - 1; i++) {
+                    left.Box.Add(bins[i].Box);
+                    left.Count += bins[i].Count;
+                    const auto cost = SurfaceArea(left.Box) * left.Count + rightCosts[i];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = i;
+                    }
+                }
+            }
+
+            auto middle = begin + (end - begin) / 2;
+            if (bestAxis == -1)
+                return middle;
+
+            const auto scale = Bins / (centers.Max[bestAxis] - centers.Min[bestAxis]);
+            const auto split = std::partition(begin, end, [&](const BuildObject& object) {
+                return std::min(Bins - 1, static_cast<int>((object.Center[bestAxis] - centers.Min[bestAxis]) * scale)) <= bestBin;
+            });
+            if (split != begin && split != end)
+                return split;
+
+            // All objects fell on one side, which happens when many share a center, so split them by count instead
+            std::nth_element(begin, middle, end, [&](const BuildObject& a, const BuildObject& b) { return a.Center[bestAxis] < b.Center[bestAxis]; });
+            return middle;
+        }
+
+        static void Build(Member& index, const std::vector<ObjectId>& objects)
+        {
+            index.Nodes.clear();
+            index.Parents.clear();
+            index.LeafSlots.clear();
+            if (objects.empty())
+                return;
+
+            std::vector<BuildObject> buildObjects;
+            buildObjects.reserve(objects.size());
+            for (auto object : objects)
+                buildObjects.push_back({ index.Boxes[object], index.Boxes[object].Center(), object });
+
+            // Children are always added after their parent, which Refit relies on
+            struct Task {
+                unsigned int Node;
+                BuildObject* Begin;
+                BuildObject* End;
+            };
+            std::vector<Task> tasks = { { AddNode(index, None), buildObjects.data(), buildObjects.data() + buildObjects.size() } };
+            while (!tasks.empty()) {
+                const auto task = tasks.back();
+                tasks.pop_back();
+
+                auto box = BoundingBox{};
+                auto centers = BoundingBox{};
+                for (auto object = task.Begin; object != task.End; object++) {
+                    box.Add(object->Box);
+                    centers.Add(object->Center);
+                }
+                index.Nodes[task.Node].Min = box.Min;
+                index.Nodes[task.Node].Max = box.Max;
+
+                const auto count = static_cast<unsigned int>(task.End - task.Begin);
+                if (count <= MaxLeafObjects) {
+                    std::array<ObjectId, MaxLeafObjects> leafObjects{};
+                    for (unsigned int i = 0; i < count; i++)
+                        leafObjects[i] = task.Begin[i].Object;
+                    MakeLeaf(index, task.Node, leafObjects.data(), count);
+                    continue;
+                }
+
+                const auto split = Split(task.Begin, task.End, centers);
+                const auto left = AddNode(index, task.Node);
+                AddNode(index, task.Node);
+                index.Nodes[task.Node].Index = left;
+                index.Nodes[task.Node].Count = Interior;
+                tasks.push_back({ left + 1, split, task.End });
+                tasks.push_back({ left, task.Begin, split });
+            }
+        }
+
+        // Finds the leaf that grows the least in surface area from taking the box.
+        static unsigned int ChooseLeaf(const Member& index, const BoundingBox& box)
+        {
+            unsigned int node = 0;
+            while (index.Nodes[node].Count == Interior) {
+                const auto first = index.Nodes[node].Index;
+                auto bestGrowth = std::numeric_limits<float>::max();
+                for (auto child : { first, first + 1 }) {
+                    auto grown = BoxOf(index.Nodes[child]);
+                    const auto area = SurfaceArea(grown);
+                    grown.Add(box);
+                    const auto growth = SurfaceArea(grown) - area;
+                    if (growth < bestGrowth) {
+                        bestGrowth = growth;
+                        node = child;
+                    }
+                }
+            }
+            return node;
+        }
+
+        // Turns a full leaf into an interior node with two leaves, splitting its objects and the new one along the longest axis of their centers.
+        static void SplitLeaf(Member& index, unsigned int leaf, ObjectId object)
+        {
+            std::array<ObjectId, MaxLeafObjects + 1> objects{};
+            const auto firstSlot = index.Nodes[leaf].Index;
+            std::copy_n(index.LeafSlots.begin() + firstSlot, MaxLeafObjects, objects.begin());
+            objects.back() = object;
+
+            auto centers = BoundingBox{};
+            for (auto o : objects)
+                centers.Add(index.Boxes[o].Center());
+            const auto size = centers.Max - centers.Min;
+            const auto axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+            std::sort(objects.begin(), objects.end(), [&](ObjectId a, ObjectId b) { return index.Boxes[a].Center()[axis] < index.Boxes[b].Center()[axis]; });
+
+            // The left child takes over the slots of the leaf
+            const auto left = AddNode(index, leaf);
+            const auto right = AddNode(index, leaf);
+            const auto leftCount = static_cast<unsigned int>(objects.size() / 2);
+            index.Nodes[left].Index = firstSlot;
+            index.Nodes[left].Count = leftCount;
+            for (unsigned int i = 0; i < leftCount; i++) {
+                index.LeafSlots[firstSlot + i] = objects[i];
+                index.Leaves[objects[i]] = left;
+            }
+            std::fill(index.LeafSlots.begin() + firstSlot + leftCount, index.LeafSlots.begin() + firstSlot + MaxLeafObjects, None);
+            MakeLeaf(index, right, objects.data() + leftCount, static_cast<unsigned int>(objects.size()) - leftCount);
+            index.Nodes[leaf].Index = left;
+            index.Nodes[leaf].Count = Interior;
+
+            for (auto child : { left, right }) {
+                const auto box = ComputeBox(index, child);
+                index.Nodes[child].Min = box.Min;
+                index.Nodes[child].Max = box.Max;
+            }
+            RefitUp(index, leaf);
+        }
+
+        // Calls the function for every object in the subtree of the node.
+        template<class Function>
+        static void ForEachObject(const Member& index, unsigned int node, std::vector<unsigned int>& stack, const Function& function)
+        {
+            const auto bottom = stack.size();
+            stack.push_back(node);
+            while (stack.size() > bottom) {
+                const auto& current = index.Nodes[stack.back()];
+                stack.pop_back();
+                if (current.Count == Interior) {
+                    stack.push_back(current.Index);
+                    stack.push_back(current.Index + 1);
+                    continue;
+                }
+                for (unsigned int i = 0; i < current.Count; i++)
+                    function(index.LeafSlots[current.Index + i]);
+            }
+        }
+
+        // Visits the tree from the root, descending into the nodes whose box passes the test and testing every object of the leaves reached.
+        template<class Test, class Function>
+        static void Query(const Member& index, const Test& test, const Function& function)
+        {
+            if (index.Nodes.empty())
+                return;
+
+            std::vector<unsigned int> stack = { 0 };
+            while (!stack.empty()) {
+                const auto& node = index.Nodes[stack.back()];
+                stack.pop_back();
+                if (!test(BoxOf(node)))
+                    continue;
+                if (node.Count == Interior) {
+                    stack.push_back(node.Index);
+                    stack.push_back(node.Index + 1);
+                    continue;
+                }
+                for (unsigned int i = 0; i < node.Count; i++) {
+                    const auto object = index.LeafSlots[node.Index + i];
+                    if (test(index.Boxes[object]))
+                        function(object);
+                }
+            }
+        }
+    };
+
+    SceneIndex::SceneIndex()
+        : m(std::make_shared<SceneIndexMember>())
+    {}
+
+    SceneIndex::ObjectId SceneIndex::Insert(const BoundingBox& worldBox)
+    {
+        ObjectId object{};
+        if (!m->FreeIds.empty()) {
+            object = m->FreeIds.back();
+            m->FreeIds.pop_back();
+        }
+        else {
+            object = static_cast<ObjectId>(m->Boxes.size());
+            m->Boxes.emplace_back();
+            m->Leaves.push_back(None);
+        }
+        m->Boxes[object] = worldBox;
+
+        if (m->Nodes.empty()) {
+            Tree::AddNode(*m, None);
+            Tree::MakeLeaf(*m, 0, &object, 1);
+            Tree::RefitUp(*m, 0);
+            return object;
+        }
+
+        const auto leaf = Tree::ChooseLeaf(*m, worldBox);
+        auto& node = m->Nodes[leaf];
+        if (node.Count == MaxLeafObjects) {
+            Tree::SplitLeaf(*m, leaf, object);
+            return object;
+        }
+        m->LeafSlots[node.Index + node.Count] = object;
+        node.Count++;
+        m->Leaves[object] = leaf;
+        Tree::RefitUp(*m, leaf);
+        return object;
+    }
+
+    void SceneIndex::Remove(ObjectId object)
+    {
+        CHARIS_ASSERT(object < m->Leaves.size() && m->Leaves[object] != None, "Scene index has no object with id ", object, ".");
+
+        // Empty leaves are kept, their empty box never passes a query
+        const auto leaf = m->Leaves[object];
+        auto& node = m->Nodes[leaf];
+        const auto slots = m->LeafSlots.begin() + node.Index;
+        const auto slot = std::find(slots, slots + node.Count, object);
+        *slot = slots[node.Count - 1];
+        slots[node.Count - 1] = None;
+        node.Count--;
+
+        m->Leaves[object] = None;
+        m->Boxes[object] = {};
+        m->FreeIds.push_back(object);
+        Tree::RefitUp(*m, leaf);
+    }
+
+    void SceneIndex::Move(ObjectId object, const BoundingBox& worldBox)
+    {
+        SetBounds(object, worldBox);
+        Tree::RefitUp(*m, m->Leaves[object]);
+    }
+
+    void SceneIndex::SetBounds(ObjectId object, const BoundingBox& worldBox)
+    {
+        CHARIS_ASSERT(object < m->Leaves.size() && m->Leaves[object] != None, "Scene index has no object with id ", object, ".");
+        m->Boxes[object] = worldBox;
+    }
+
+    void SceneIndex::Refit()
+    {
+        // Children come after their parents in the array, so walking it backwards refits every child before its parent
+        for (auto node = m->Nodes.size(); node-- > 0;) {
+            const auto box = Tree::ComputeBox(*m, static_cast<unsigned int>(node));
+            m->Nodes[node].Min = box.Min;
+            m->Nodes[node].Max = box.Max;
+        }
+    }
+
+    void SceneIndex::Rebuild()
+    {
+        std::vector<ObjectId> objects;
+        objects.reserve(Size());
+        for (ObjectId object = 0; object < m->Leaves.size(); object++) {
+            if (m->Leaves[object] != None)
+                objects.push_back(object);
+        }
+        Tree::Build(*m, objects);
+    }
+
+    const BoundingBox& SceneIndex::Bounds(ObjectId object) const
+    {
+        CHARIS_ASSERT(object < m->Leaves.size() && m->Leaves[object] != None, "Scene index has no object with id ", object, ".");
+        return m->Boxes[object];
+    }
+
+    unsigned int SceneIndex::Size() const
+    {
+        return static_cast<unsigned int>(m->Boxes.size() - m->FreeIds.size());
+    }
+
+    void SceneIndex::QueryFrustum(const Frustum& frustum, std::vector<ObjectId>& visible) const
+    {
+        visible.clear();
+        if (!m->Nodes.empty()) {
+            // Everything below a node that is entirely inside is visible without testing it
+            std::vector<unsigned int> stack = { 0 };
+            std::vector<unsigned int> subtree;
+            while (!stack.empty()) {
+                const auto node = stack.back();
+                stack.pop_back();
+                const auto& current = m->Nodes[node];
+                const auto containment = Classify(frustum, Tree::BoxOf(current));
+                if (containment == Containment::Outside)
+                    continue;
+                if (containment == Containment::Inside) {
+                    Tree::ForEachObject(*m, node, subtree, [&](ObjectId object) { visible.push_back(object); });
+                    continue;
+                }
+                if (current.Count == Interior) {
+                    stack.push_back(current.Index);
+                    stack.push_back(current.Index + 1);
+                    continue;
+                }
+                for (unsigned int i = 0; i < current.Count; i++) {
+                    const auto object = m->LeafSlots[current.Index + i];
+                    if (Classify(frustum, m->Boxes[object]) != Containment::Outside)
+                        visible.push_back(object);
+                }
+            }
+        }
+
+        const auto visibleCount = static_cast<unsigned int>(visible.size());
+        PrivateGlobal::Statistics::CountCulling(visibleCount, Size() - visibleCount);
+    }
+
+    void SceneIndex::QueryOverlap(const BoundingBox& box, std::vector<ObjectId>& overlapping) const
+    {
+        overlapping.clear();
+        Tree::Query(*m, [&](const BoundingBox& other) { return Overlaps(box, other); }, [&](ObjectId object) { overlapping.push_back(object); });
+    }
+
+    void SceneIndex::QueryOverlap(const BoundingSphere& sphere, std::vector<ObjectId>& overlapping) const
+    {
+        overlapping.clear();
+        Tree::Query(*m, [&](const BoundingBox& other) { return Overlaps(sphere, other); }, [&](ObjectId object) { overlapping.push_back(object); });
+    }
+
+    std::optional<SceneIndex::RayHit> SceneIndex::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+    {
+        if (m->Nodes.empty())
+            return std::nullopt;
+
+        // Division by zero gives infinities, which the slab test handles
+        const auto inverseDirection = 1.0f / direction;
+        std::optional<RayHit> closest;
+        auto range = maxDistance;
+
+        struct Entry {
+            unsigned int Node;
+            float Distance;
+        };
+        std::vector<Entry> stack;
+        if (const auto distance = EnterDistance(Tree::BoxOf(m->Nodes[0]), origin, inverseDirection, range))
+            stack.push_back({ 0, *distance });
+        while (!stack.empty()) {
+            const auto entry = stack.back();
+            stack.pop_back();
+            if (entry.Distance > range)
+                continue;
+
+            const auto& node = m->Nodes[entry.Node];
+            if (node.Count != Interior) {
+                for (unsigned int i = 0; i < node.Count; i++) {
+                    const auto object = m->LeafSlots[node.Index + i];
+                    const auto distance = EnterDistance(m->Boxes[object], origin, inverseDirection, range);
+                    if (distance && (!closest || *distance < closest->Distance)) {
+                        closest = RayHit{ object, *distance };
+                        range = *distance;
+                    }
+                }
+                continue;
+            }
+
+            // The nearer child goes on top, so it is searched first and shortens the range for the other
+            std::array<Entry, 2> children{};
+            int hits = 0;
+            for (auto child : { node.Index, node.Index + 1 }) {
+                if (const auto distance = EnterDistance(Tree::BoxOf(m->Nodes[child]), origin, inverseDirection, range))
+                    children[hits++] = { child, *distance };
+            }
+            if (hits == 2 && children[1].Distance < children[0].Distance)
+                std::swap(children[0], children[1]);
+            while (hits > 0)
+                stack.push_back(children[--hits]);
+        }
+        return closest;
+    }
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "Bounds.h"
+#include <vector>
+#include <memory>
+#include <optional>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	class Frustum;
+
+	/// <summary>
+	/// A bounding volume hierarchy over the world bounds of many objects, for culling, picking and finding what is near a point without visiting every object.
+	/// The tree is built with the surface area heuristic and stored as a flat array of nodes, with the two children of a node next to each other.
+	/// Insert, Remove and Move update the tree in place and only refit the boxes on the way to the root. The tree gets slower to query
+	/// as objects move far from where they were when it was built, so Rebuild it after large changes, for example when a level has been loaded.
+	/// </summary>
+	class SceneIndex
+	{
+	public:
+		/// <summary>Identifies an object in the index. Ids of removed objects are given to objects inserted later.</summary>
+		using ObjectId = unsigned int;
+
+		SceneIndex();
+
+		/// <summary>Adds an object with a box in world coordinates. Returns its id.</summary>
+		ObjectId Insert(const BoundingBox& worldBox);
+		/// <summary>Removes an object.</summary>
+		void Remove(ObjectId object);
+		/// <summary>Gives an object a new box and refits the boxes above it. To move most objects at once, use SetBounds and Refit instead.</summary>
+		void Move(ObjectId object, const BoundingBox& worldBox);
+		/// <summary>Gives an object a new box without updating the tree. Queries are wrong until the next Refit.</summary>
+		void SetBounds(ObjectId object, const BoundingBox& worldBox);
+		/// <summary>Refits every box of the tree to the current object boxes, in one pass from the leaves up.</summary>
+		void Refit();
+		/// <summary>Builds the tree again from all objects.</summary>
+		void Rebuild();
+
+		/// <summary>Returns the box of an object.</summary>
+		const BoundingBox& Bounds(ObjectId object) const;
+		/// <summary>Returns the number of objects in the index.</summary>
+		unsigned int Size() const;
+
+		/// <summary>
+		/// Finds the objects whose boxes are at least partly inside the frustum, replacing the content of visible.
+		/// Adds the visible and culled counts to Utility::FrameStatistics.
+		/// </summary>
+		void QueryFrustum(const Frustum& frustum, std::vector<ObjectId>& visible) const;
+		/// <summary>Finds the objects whose boxes overlap the box, replacing the content of overlapping.</summary>
+		void QueryOverlap(const BoundingBox& box, std::vector<ObjectId>& overlapping) const;
+		/// <summary>Finds the objects whose boxes overlap the sphere, replacing the content of overlapping. Useful to find the objects a point light reaches.</summary>
+		void QueryOverlap(const BoundingSphere& sphere, std::vector<ObjectId>& overlapping) const;
+
+		struct RayHit {
+			ObjectId Object{};
+			// Distance along the ray to where it enters the box of the object, in lengths of the direction vector
+			float Distance{};
+		};
+		/// <summary>Finds the object whose box the ray enters first, for example to pick the object under the mouse. Returns nothing if the ray misses every box.</summary>
+		/// <param name="origin">Start of the ray, objects behind it are not hit.</param>
+		/// <param name="direction">Direction of the ray, does not need to be normalized.</param>
+		/// <param name="maxDistance">Boxes further along the ray than this are not hit.</param>
+		std::optional<RayHit> Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = std::numeric_limits<float>::max()) const;
+
+		// Objects per leaf, more makes the tree smaller and faster to build but leaves slower to test.
+		static constexpr unsigned int MaxLeafObjects = 4;
+
+	private:
+		struct Node {
+			glm::vec3 Min;
+			// First child for interior nodes, the second child is at Index + 1. First slot of the objects for leaves.
+			unsigned int Index{};
+			glm::vec3 Max;
+			// Number of objects for leaves, Interior for interior nodes.
+			unsigned int Count{};
+		};
+		static constexpr unsigned int Interior = ~0u;
+		static constexpr unsigned int None = ~0u;
+
+		struct SceneIndexMember {
+			std::vector<Node> Nodes;
+			std::vector<unsigned int> Parents;
+			// Every leaf owns MaxLeafObjects slots, of which the first Count are used.
+			std::vector<ObjectId> LeafSlots;
+			std::vector<BoundingBox> Boxes;
+			// Leaf of every object, None for ids that are not in use.
+			std::vector<unsigned int> Leaves;
+			std::vector<ObjectId> FreeIds;
+		};
+		std::shared_ptr<SceneIndexMember> m;
+
+		// Building, inserting into and refitting the tree, see SceneIndex.cpp.
+		struct Tree;
+	};
+
+}
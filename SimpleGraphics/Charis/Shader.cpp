@@ -1,259 +1,931 @@
-#include "Shader.h"
-#include "Utility.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
-
-// Libraries
-#include <glad/glad.h>
-
-enum ShaderType {
-    Program,
-    Vertex,
-    Fragment,
-};
-// utility function for checking shader compilation/linking errors.
-static void CheckCompileErrors(GLuint shader, ShaderType type)
-{
-    int success;
-    const int infoLogLength = 1024;
-    char infoLog[infoLogLength];
-    if (type != ShaderType::Program)
-    {
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            glGetShaderInfoLog(shader, infoLogLength, NULL, infoLog);
-            std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-        }
-    }
-    else
-    {
-        glGetProgramiv(shader, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            glGetProgramInfoLog(shader, infoLogLength, NULL, infoLog);
-            std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-        }
-    }
-}
-
-namespace Charis {
-
-	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader, InputType inputType, unsigned int numberOfDrawableTextures)
-	{
-        m->NumberOfDrawableTextures = numberOfDrawableTextures;
-
-        // 1. retrieve the vertex/fragment source code
-        std::string vertexCode;
-        std::string fragmentCode;
-
-		if (inputType == InCode) {
-			vertexCode = vertexShader;
-			fragmentCode = fragmentShader;
-		}
-		else if (inputType == Filepath) {
-            // retrieve the vertex/fragment source code from filePath
-            std::ifstream vShaderFile;
-            std::ifstream fShaderFile;
-            // ensure ifstream objects can throw exceptions:
-            vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-            fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-            try
-            {
-                // open files
-                vShaderFile.open(vertexShader);
-                fShaderFile.open(fragmentShader);
-                std::stringstream vShaderStream, fShaderStream;
-                // read file's buffer contents into streams
-                vShaderStream << vShaderFile.rdbuf();
-                fShaderStream << fShaderFile.rdbuf();
-                // close file handlers
-                vShaderFile.close();
-                fShaderFile.close();
-                // convert stream into string
-                vertexCode = vShaderStream.str();
-                fragmentCode = fShaderStream.str();
-            }
-            catch (std::ifstream::failure& e)
-            {
-                std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
-            }
-		}
-        const char* vShaderCode = vertexCode.c_str();
-        const char* fShaderCode = fragmentCode.c_str();
-
-        // 2. compile shaders
-        unsigned int vertex, fragment;
-
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        CheckCompileErrors(vertex, ShaderType::Vertex);
-
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        CheckCompileErrors(fragment, ShaderType::Fragment);
-
-        m->ID = glCreateProgram();
-        glAttachShader(m->ID, vertex);
-        glAttachShader(m->ID, fragment);
-        glLinkProgram(m->ID);
-        CheckCompileErrors(m->ID, ShaderType::Program);
-
-        // 3. delete the shaders as they're linked into our program now and no longer necessary
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
-	}
-
-	Shader::~Shader()
-	{
-        if (m.use_count() > 1)
-            return;
-
-		glDeleteProgram(m->ID);
-	}
-
-    void Shader::Draw(const Component& component) const
-    {
-        // Set textures to shader
-        auto textureCounter = std::array{ 0, 0, 0, 0 };
-
-        int count = 0;
-        for (const auto& texture : component.Textures) {
-            auto& typeCount = textureCounter[texture.Type];
-
-            if (typeCount < m->NumberOfDrawableTextures) {
-                typeCount++;
-                const auto shaderUniformName = Texture::ShaderTextureNames[texture.Type] + std::to_string(typeCount);
-                count++;
-                const int textureBinding = 32 - count;
-
-                texture.BindTo(textureBinding);
-                SetTexture(shaderUniformName, textureBinding);
-            }
-        }
-
-        // Perform Draw Operations
-        glUseProgram(m->ID);
-        glBindVertexArray(component.m->VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, component.m->VBO);
-
-        if (component.m->UsingIBO) {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, component.m->IBO);
-            glDrawElements(GL_TRIANGLES, component.m->NumberOfIndices, GL_UNSIGNED_INT, 0);
-        }
-        else {
-            glDrawArrays(GL_TRIANGLES, 0, component.m->NumberOfVertices);
-        }
-    }
-
-    void Shader::Draw(const std::vector<Component>& components) const
-    {
-        for (const auto& component : components) {
-            Draw(component);
-        }
-    }
-
-    void Shader::Draw(const Model& model) const
-    {
-        Draw(model.Components);
-    }
-
-    void Shader::SetBool(const std::string& name, bool value) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform1i(uniLoc, static_cast<int>(value));
-    }
-
-    void Shader::SetInt(const std::string& name, int value) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform1i(uniLoc, value);
-    }
-
-    void Shader::SetFloat(const std::string& name, float value) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform1f(uniLoc, value);
-    }
-
-    void Shader::SetTexture(const std::string& name, unsigned int binding) const
-    {
-        Helper::RuntimeAssert(31 >= binding && binding >= 0, "Texture global state binding index must be in the range [0, 31].");
-        SetInt(name, binding);
-    }
-
-    void Shader::SetVec2(const std::string& name, const glm::vec2& value) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform2fv(uniLoc, 1, &value[0]);
-    }
-    void Shader::SetVec2(const std::string& name, float x, float y) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform2f(uniLoc, x, y);
-    }
-    void Shader::SetVec3(const std::string& name, const glm::vec3& value) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform3fv(uniLoc, 1, &value[0]);
-    }
-    void Shader::SetVec3(const std::string& name, float x, float y, float z) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform3f(uniLoc, x, y, z);
-    }
-    void Shader::SetVec4(const std::string& name, const glm::vec4& value) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform4fv(uniLoc, 1, &value[0]);
-    }
-    void Shader::SetVec4(const std::string& name, float x, float y, float z, float w) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniform4f(uniLoc, x, y, z, w);
-    }
-    void Shader::SetMat2(const std::string& name, const glm::mat2& mat) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniformMatrix2fv(uniLoc, 1, GL_FALSE, &mat[0][0]);
-    }
-    void Shader::SetMat3(const std::string& name, const glm::mat3& mat) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniformMatrix3fv(uniLoc, 1, GL_FALSE, &mat[0][0]);
-    }
-    void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const
-    {
-        glUseProgram(m->ID);
-        auto uniLoc = glGetUniformLocation(m->ID, name.c_str());
-        Helper::RuntimeAssert(uniLoc != -1, "Shader uniform does not exist: " + name);
-        glUniformMatrix4fv(uniLoc, 1, GL_FALSE, &mat[0][0]);        // or use glm::value_ptr(model)
-    }
-
+#include "Shader.h"
+#include "GeometryArena.h"
+#include "Culling.h"
+#include "Utility.h"
+#include "Profiler.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/FrameConstants.hpp"
+#include "Private/ProgramCache.hpp"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+
+// Libraries
+#include <glad/glad.h>
+
+enum ShaderType {
+    Program,
+    Vertex,
+    Fragment,
+};
+static const char* ShaderTypeName(ShaderType type)
+{
+    return type == Vertex ? "Vertex" : type == Fragment ? "Fragment" : "Program";
+}
+// utility function for checking shader compilation/linking errors. Returns true if there were none.
+static bool CheckCompileErrors(GLuint shader, ShaderType type)
+{
+    int success;
+    const int infoLogLength = 1024;
+    char infoLog[infoLogLength];
+    if (type != ShaderType::Program)
+    {
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(shader, infoLogLength, NULL, infoLog);
+            Charis::PrivateGlobal::Diagnose(Charis::Utility::DiagnosticSeverity::Error, std::string("SHADER_COMPILATION_ERROR of type: ") + ShaderTypeName(type) + "\n" + infoLog);
+        }
+    }
+    else
+    {
+        glGetProgramiv(shader, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            glGetProgramInfoLog(shader, infoLogLength, NULL, infoLog);
+            Charis::PrivateGlobal::Diagnose(Charis::Utility::DiagnosticSeverity::Error, std::string("PROGRAM_LINKING_ERROR of type: ") + ShaderTypeName(type) + "\n" + infoLog);
+        }
+    }
+    return success;
+}
+
+static float MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// adds a #define line per define right after the #version line, which must stay first, or at the start if there is none.
+static std::string WithDefines(const std::string& code, const std::vector<std::string>& defines)
+{
+    if (defines.empty())
+        return code;
+    std::string lines;
+    for (const auto& define : defines)
+        lines += "#define " + define + "\n";
+
+    const auto version = code.find("#version");
+    if (version == std::string::npos)
+        return lines + code;
+    const auto lineEnd = code.find('\n', version);
+    if (lineEnd == std::string::npos)
+        return code + "\n" + lines;
+    return code.substr(0, lineEnd + 1) + lines + code.substr(lineEnd + 1);
+}
+
+// creates a program from its cached binary. Returns 0 if there is no cached binary or the driver refuses it.
+static unsigned int LoadCachedProgram(std::uint64_t key, Charis::Shader::BuildTimes& build)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::uint32_t binaryFormat{};
+    std::vector<unsigned char> binary;
+    unsigned int program = 0;
+    if (Charis::PrivateGlobal::ReadProgramCache(key, binaryFormat, binary)) {
+        program = glCreateProgram();
+        Charis::PrivateGL::ProgramBinary(program, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        int success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        // binaries of another format or of an updated driver are refused, which also leaves an error behind
+        if (!success) {
+            while (glGetError() != GL_NO_ERROR) {}
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+    build.CacheMilliseconds += MillisecondsSince(start);
+    build.FromCache = program != 0;
+    return program;
+}
+
+// reads the binary of a linked program back from the driver and writes it to the cache.
+static void CacheProgram(unsigned int program, std::uint64_t key, Charis::Shader::BuildTimes& build)
+{
+    const auto start = std::chrono::steady_clock::now();
+    int length = 0;
+    glGetProgramiv(program, Charis::PrivateGL::PROGRAM_BINARY_LENGTH, &length);
+    if (length > 0) {
+        std::vector<unsigned char> binary(length);
+        GLenum binaryFormat{};
+        Charis::PrivateGL::GetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+        binary.resize(length);
+        if (!binary.empty())
+            Charis::PrivateGlobal::WriteProgramCache(key, binaryFormat, binary);
+    }
+    build.CacheMilliseconds += MillisecondsSince(start);
+}
+
+// reflects all active uniforms of a linked program into a name to location table.
+static std::unordered_map<std::string, int> ReflectUniforms(GLuint program)
+{
+    std::unordered_map<std::string, int> uniformLocations;
+
+    int uniformCount = 0;
+    int maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    std::vector<char> nameBuffer(maxNameLength + 1);
+
+    for (int i = 0; i < uniformCount; i++)
+    {
+        int nameLength = 0;
+        int arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, static_cast<GLsizei>(nameBuffer.size()), &nameLength, &arraySize, &type, nameBuffer.data());
+        auto name = std::string(nameBuffer.data(), nameLength);
+
+        const int location = glGetUniformLocation(program, name.c_str());
+        // uniforms inside uniform blocks have no location
+        if (location == -1)
+            continue;
+        uniformLocations.insert({ name, location });
+
+        // arrays are reported as "name[0]", so also register "name" and every "name[i]" element
+        const auto arraySuffix = name.rfind("[0]");
+        if (arraySuffix == std::string::npos || arraySuffix + 3 != name.size())
+            continue;
+        const auto baseName = name.substr(0, arraySuffix);
+        uniformLocations.insert({ baseName, location });
+        for (int element = 1; element < arraySize; element++) {
+            const auto elementName = baseName + '[' + std::to_string(element) + ']';
+            uniformLocations.insert({ elementName, glGetUniformLocation(program, elementName.c_str()) });
+        }
+    }
+
+    return uniformLocations;
+}
+
+// per-instance vertex attributes used by Shader::DrawInstanced.
+struct InstanceAttributes {
+    glm::mat4 Model;
+    glm::mat3 Normal;
+};
+static_assert(sizeof(InstanceAttributes) == sizeof(glm::mat4) + sizeof(glm::mat3));
+constexpr unsigned int FirstInstanceAttribute = 5;
+// four columns of the model matrix and three of the normal matrix
+constexpr unsigned int InstanceAttributeCount = 7;
+
+// instance buffer and byte offset of an upload.
+struct UploadedInstances {
+    unsigned int VBO;
+    size_t Offset;
+};
+
+// writes the instance attributes after the earlier uploads of this frame into the instance buffer of the current frame in flight, and returns where.
+static UploadedInstances UploadInstances(std::span<const glm::mat4> modelMatrices)
+{
+    using Buffers = Charis::PrivateGlobal::InstanceBuffers;
+    const auto frame = Charis::PrivateGlobal::FrameSync::Current;
+    auto& vbo = Buffers::VBO[frame];
+    auto& capacity = Buffers::Capacity[frame];
+    auto& used = Buffers::Used[frame];
+
+    if (vbo == 0)
+        glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // respecifying the storage orphans what the earlier uploads of this frame still need, and later frames reuse the larger buffer
+    const auto bytes = sizeof(InstanceAttributes) * modelMatrices.size();
+    if (used + bytes > capacity) {
+        capacity = std::max(used + bytes, 2 * capacity);
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        used = 0;
+    }
+    const auto offset = used;
+    used += bytes;
+
+    // the part of the buffer of this frame is only reused once EndFrame waited for the GPU to finish the frame that used it last, so the driver needs no synchronization
+    auto instances = static_cast<InstanceAttributes*>(glMapBufferRange(GL_ARRAY_BUFFER, offset, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (instances == nullptr)
+        Charis::Helper::RuntimeAssert(false, "Failed to map instance buffer.");
+    for (size_t i = 0; i < modelMatrices.size(); i++) {
+        instances[i].Model = modelMatrices[i];
+        instances[i].Normal = glm::transpose(glm::inverse(glm::mat3(modelMatrices[i])));
+    }
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    Charis::PrivateGlobal::Statistics::CountUpload(bytes);
+
+    return { vbo, offset };
+}
+
+// points the per-instance attributes of the currently bound vertex array at the instances from the offset on.
+// The vertex array may be shared with plain draws, so ResetInstanceAttributes must be called after the instanced draw.
+static void SetInstanceAttributes(unsigned int instanceVBO, size_t offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    const auto stride = static_cast<GLsizei>(sizeof(InstanceAttributes));
+    // model matrix, one vec4 column per attribute
+    for (unsigned int column = 0; column < 4; column++) {
+        const auto attribute = FirstInstanceAttribute + column;
+        glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    // normal matrix, one vec3 column per attribute
+    for (unsigned int column = 0; column < 3; column++) {
+        const auto attribute = FirstInstanceAttribute + 4 + column;
+        glVertexAttribPointer(attribute, 3, GL_FLOAT, GL_FALSE, stride, (void*)(offset + sizeof(glm::mat4) + column * sizeof(glm::vec3)));
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+}
+
+// disables the per-instance attributes of the currently bound vertex array again, so later draws of it do not read instance data.
+static void ResetInstanceAttributes()
+{
+    for (unsigned int attribute = FirstInstanceAttribute; attribute < FirstInstanceAttribute + InstanceAttributeCount; attribute++) {
+        glDisableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 0);
+    }
+}
+
+// layout of a draw command in the indirect buffer, as defined by glMultiDrawElementsIndirect.
+struct DrawElementsIndirectCommand {
+    unsigned int Count;
+    unsigned int InstanceCount;
+    unsigned int FirstIndex;
+    int BaseVertex;
+    unsigned int BaseInstance;
+};
+
+namespace Charis {
+
+	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader, InputType inputType, unsigned int numberOfDrawableTextures, const std::vector<std::string>& defines)
+        : Shader(Source{ vertexShader, fragmentShader, inputType, numberOfDrawableTextures, defines }, Deferred{})
+	{
+        FinishBuild();
+	}
+
+    Shader::Shader(const Source& source, Deferred)
+    {
+        m->NumberOfDrawableTextures = source.NumberOfDrawableTextures;
+        m->BuildStart = std::chrono::steady_clock::now();
+
+        // 1. retrieve the vertex/fragment source code
+        std::string vertexCode;
+        std::string fragmentCode;
+
+		if (source.Type == InCode) {
+			vertexCode = source.VertexShader;
+			fragmentCode = source.FragmentShader;
+		}
+		else if (source.Type == Filepath) {
+            // retrieve the vertex/fragment source code from filePath
+            std::ifstream vShaderFile;
+            std::ifstream fShaderFile;
+            // ensure ifstream objects can throw exceptions:
+            vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+            fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+            try
+            {
+                // open files
+                vShaderFile.open(source.VertexShader);
+                fShaderFile.open(source.FragmentShader);
+                std::stringstream vShaderStream, fShaderStream;
+                // read file's buffer contents into streams
+                vShaderStream << vShaderFile.rdbuf();
+                fShaderStream << fShaderFile.rdbuf();
+                // close file handlers
+                vShaderFile.close();
+                fShaderFile.close();
+                // convert stream into string
+                vertexCode = vShaderStream.str();
+                fragmentCode = fShaderStream.str();
+            }
+            catch (std::ifstream::failure& e)
+            {
+                PrivateGlobal::Diagnose(Utility::DiagnosticSeverity::Error, std::string("SHADER::FILE_NOT_SUCCESSFULLY_READ: ") + e.what());
+            }
+		}
+        vertexCode = WithDefines(vertexCode, source.Defines);
+        fragmentCode = WithDefines(fragmentCode, source.Defines);
+
+        // 2. load the linked program from the cache, or start compiling and linking it without waiting for the driver
+        m->CacheProgram = PrivateGlobal::ProgramCacheAvailable();
+        m->CacheKey = m->CacheProgram ? PrivateGlobal::ProgramCacheKey(vertexCode, fragmentCode) : 0;
+        if (m->CacheProgram)
+            m->ID = LoadCachedProgram(m->CacheKey, m->Build);
+        if (m->ID != 0) {
+            m->CacheProgram = false;
+            return;
+        }
+
+        const char* vShaderCode = vertexCode.c_str();
+        const char* fShaderCode = fragmentCode.c_str();
+        const auto compileStart = std::chrono::steady_clock::now();
+        m->PendingVertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(m->PendingVertex, 1, &vShaderCode, NULL);
+        glCompileShader(m->PendingVertex);
+        m->PendingFragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(m->PendingFragment, 1, &fShaderCode, NULL);
+        glCompileShader(m->PendingFragment);
+        m->Build.CompileMilliseconds = MillisecondsSince(compileStart);
+
+        const auto linkStart = std::chrono::steady_clock::now();
+        m->ID = glCreateProgram();
+        // drivers only keep a binary that can be read back if asked to before linking
+        if (m->CacheProgram)
+            PrivateGL::ProgramParameteri(m->ID, PrivateGL::PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glAttachShader(m->ID, m->PendingVertex);
+        glAttachShader(m->ID, m->PendingFragment);
+        glLinkProgram(m->ID);
+        m->Build.LinkMilliseconds = MillisecondsSince(linkStart);
+        m->Ready = false;
+    }
+
+    void Shader::FinishBuild() const
+    {
+        // 3. check the program, which waits for the driver if it is not done yet
+        if (!m->Ready) {
+            const auto compileStart = std::chrono::steady_clock::now();
+            CheckCompileErrors(m->PendingVertex, ShaderType::Vertex);
+            CheckCompileErrors(m->PendingFragment, ShaderType::Fragment);
+            m->Build.CompileMilliseconds += MillisecondsSince(compileStart);
+            const auto linkStart = std::chrono::steady_clock::now();
+            const bool linked = CheckCompileErrors(m->ID, ShaderType::Program);
+            m->Build.LinkMilliseconds += MillisecondsSince(linkStart);
+
+            // the shaders are linked into the program now and no longer necessary
+            glDeleteShader(m->PendingVertex);
+            glDeleteShader(m->PendingFragment);
+            m->PendingVertex = m->PendingFragment = 0;
+            m->Ready = true;
+            if (m->CacheProgram && linked)
+                CacheProgram(m->ID, m->CacheKey, m->Build);
+        }
+
+        m->UniformLocations = ReflectUniforms(m->ID);
+        if (const auto location = m->UniformLocations.find(Component::ShaderPositionDequantizationName); location != m->UniformLocations.end())
+            m->PositionDequantizationLocation = location->second;
+
+        // connect the per frame uniform block, if declared, to the buffer StartFrame fills
+        if (const auto block = glGetUniformBlockIndex(m->ID, FrameConstants::BlockName); block != GL_INVALID_INDEX) {
+            int blockSize = 0;
+            glGetActiveUniformBlockiv(m->ID, block, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+            Helper::RuntimeAssert(blockSize == sizeof(PrivateGlobal::Std140FrameConstants), "Shader FrameConstants block must be declared as in FrameConstants::ShaderSource.");
+            glUniformBlockBinding(m->ID, block, FrameConstants::BindingPoint);
+        }
+
+        // 4. give every drawable texture sampler a fixed binding, counting downwards from 31
+        Helper::RuntimeAssert(m->NumberOfDrawableTextures * Texture::Null <= 32, "Number of drawable textures per type can be at most 6.");
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        int binding = 31;
+        for (int type = 0; type < Texture::Null; type++) {
+            auto& samplerBindings = m->SamplerBindings[type];
+            for (unsigned int i = 1; i <= m->NumberOfDrawableTextures; i++) {
+                const auto name = Texture::ShaderTextureNames[type] + std::to_string(i);
+                const auto location = m->UniformLocations.find(name);
+                if (location == m->UniformLocations.end()) {
+                    samplerBindings.push_back(-1);
+                }
+                else {
+                    glUniform1i(location->second, binding);
+                    samplerBindings.push_back(binding);
+                }
+                binding--;
+            }
+        }
+        m->Build.ReadyMilliseconds = MillisecondsSince(m->BuildStart);
+    }
+
+    std::vector<Shader> Shader::CompileMany(std::span<const Source> sources)
+    {
+        CHARIS_PROFILE_ZONE("Shader::CompileMany");
+        // let the driver use as many threads as it likes, the default may be a single one
+        if (PrivateGL::MaxShaderCompilerThreads)
+            PrivateGL::MaxShaderCompilerThreads(0xFFFFFFFF);
+
+        std::vector<Shader> shaders;
+        shaders.reserve(sources.size());
+        for (const auto& source : sources)
+            shaders.push_back(Shader(source, Deferred{}));
+        // programs from the cache need no waiting
+        for (const auto& shader : shaders) {
+            if (shader.m->PendingVertex == 0)
+                shader.FinishBuild();
+        }
+        return shaders;
+    }
+
+    bool Shader::IsReady() const
+    {
+        if (m->Ready)
+            return true;
+
+        if (PrivateGL::MaxShaderCompilerThreads) {
+            int completed = GL_FALSE;
+            glGetProgramiv(m->ID, PrivateGL::COMPLETION_STATUS, &completed);
+            if (!completed)
+                return false;
+        }
+        // without the extension asking for the status waits for the build, so only one shader a frame may do so
+        else if (PrivateGlobal::ShaderCompilation::WaitedThisFrame) {
+            return false;
+        }
+        PrivateGlobal::ShaderCompilation::WaitedThisFrame = true;
+        FinishBuild();
+        return true;
+    }
+
+    unsigned int Shader::LinkedProgram() const
+    {
+        if (!m->Ready)
+            FinishBuild();
+        return m->ID;
+    }
+
+	void Shader::ShaderMember::DeleteObjects()
+	{
+		PrivateGlobal::GLState::ForgetProgram(ID);
+		glDeleteProgram(ID);
+        if (!Ready) {
+            glDeleteShader(PendingVertex);
+            glDeleteShader(PendingFragment);
+        }
+	}
+
+    Shader::BuildTimes Shader::GetBuildTimes() const
+    {
+        return m->Build;
+    }
+
+    void Shader::Draw(const Component& component) const
+    {
+        Draw(component, m->NumberOfDrawableTextures > 0 ? TextureBindings(component) : TextureBindingList{});
+    }
+
+    void Shader::Draw(const Component& component, const TextureBindingList& textures) const
+    {
+        // Set textures to shader
+        BindTextures(textures);
+
+        // Perform Draw Operations, the element buffer is part of the vertex array state
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        PrivateGlobal::GLState::BindVertexArray(component.m->VAO);
+        SetPositionDequantization(component);
+
+        if (component.m->UsingIBO) {
+            glDrawElementsBaseVertex(GL_TRIANGLES, component.m->NumberOfIndices, PrivateGlobal::IndexType(component.m->IndexSize), PrivateGlobal::IndexOffset(component.m->FirstIndex, component.m->IndexSize), component.m->BaseVertex);
+        }
+        else {
+            glDrawArrays(GL_TRIANGLES, component.m->BaseVertex, component.m->NumberOfVertices);
+        }
+        PrivateGlobal::Statistics::CountDraw(component.Triangles());
+    }
+
+    void Shader::Draw(const std::vector<Component>& components) const
+    {
+        // Runs of components that live in the same arena and use the same textures and dequantization are drawn with one multi-draw.
+        // The textures of the component that ends a run are those of the next run, so the textures of every component are gathered once.
+        if (components.empty())
+            return;
+        auto textures = TextureBindings(components.front());
+        size_t first = 0;
+        while (first < components.size()) {
+            const auto& arena = components[first].m->Arena;
+            size_t last = first + 1;
+            auto next = TextureBindingList{};
+            for (; last < components.size(); last++) {
+                next = TextureBindings(components[last]);
+                if (!arena || components[last].m->Arena != arena || next.TextureIDs != textures.TextureIDs
+                    || components[last].m->PositionDequantization != components[first].m->PositionDequantization)
+                    break;
+            }
+
+            if (last - first == 1)
+                Draw(components[first], textures);
+            else
+                MultiDraw(std::span(components).subspan(first, last - first), textures);
+            textures = next;
+            first = last;
+        }
+    }
+
+    void Shader::Draw(const Model& model) const
+    {
+        Draw(model.Components);
+    }
+
+    void Shader::Draw(const AsyncModel& model) const
+    {
+        if (const auto drawable = model.Drawable())
+            Draw(*drawable);
+    }
+
+    void Shader::Draw(const Component& component, unsigned int level) const
+    {
+        const auto full = component.Triangles();
+        if (level == 0) {
+            Draw(component);
+            PrivateGlobal::Statistics::CountLevelOfDetail(full, 0);
+            return;
+        }
+
+        const auto& range = component.m->Levels.at(level - 1);
+        BindTextures(component);
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        PrivateGlobal::GLState::BindVertexArray(component.m->VAO);
+        SetPositionDequantization(component);
+        glDrawElementsBaseVertex(GL_TRIANGLES, range.NumberOfIndices, PrivateGlobal::IndexType(component.m->IndexSize), PrivateGlobal::IndexOffset(component.m->FirstIndex + range.FirstIndex, component.m->IndexSize), component.m->BaseVertex);
+        PrivateGlobal::Statistics::CountDraw(range.NumberOfIndices / 3);
+        PrivateGlobal::Statistics::CountLevelOfDetail(range.NumberOfIndices / 3, full - range.NumberOfIndices / 3);
+    }
+
+    void Shader::Draw(const Model& model, const glm::mat4& modelToWorld, std::vector<unsigned int>& levels) const
+    {
+        levels.resize(model.Components.size());
+        for (size_t i = 0; i < model.Components.size(); i++) {
+            const auto& component = model.Components[i];
+            levels[i] = component.SelectLevel(modelToWorld, levels[i]);
+            Draw(component, levels[i]);
+        }
+    }
+
+    void Shader::DrawMeshlets(const Component& component, const glm::mat4& modelToWorld, bool cullBackFacing) const
+    {
+        if (component.Meshlets().empty() || !PrivateGlobal::CurrentView::Given) {
+            Draw(component);
+            return;
+        }
+
+        const auto& view = PrivateGlobal::CurrentView::View;
+        static std::vector<IndexRange> ranges;
+        CullMeshlets(component, modelToWorld, view.Projection * view.View, view.CameraPosition, cullBackFacing, ranges);
+        if (ranges.empty())
+            return;
+
+        BindTextures(component);
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        PrivateGlobal::GLState::BindVertexArray(component.m->VAO);
+        SetPositionDequantization(component);
+
+        const auto indexType = PrivateGlobal::IndexType(component.m->IndexSize);
+        size_t triangles = 0;
+        for (const auto& range : ranges)
+            triangles += range.NumberOfIndices / 3;
+        if (ranges.size() == 1) {
+            glDrawElementsBaseVertex(GL_TRIANGLES, ranges.front().NumberOfIndices, indexType, PrivateGlobal::IndexOffset(component.m->FirstIndex + ranges.front().FirstIndex, component.m->IndexSize), component.m->BaseVertex);
+        }
+        else {
+            // The visible ranges as client side arrays, which 3.3 can draw in one call
+            static std::vector<GLsizei> counts;
+            static std::vector<const void*> offsets;
+            static std::vector<GLint> baseVertices;
+            counts.clear();
+            offsets.clear();
+            baseVertices.assign(ranges.size(), component.m->BaseVertex);
+            for (const auto& range : ranges) {
+                counts.push_back(range.NumberOfIndices);
+                offsets.push_back(PrivateGlobal::IndexOffset(component.m->FirstIndex + range.FirstIndex, component.m->IndexSize));
+            }
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts.data(), indexType, offsets.data(), static_cast<GLsizei>(ranges.size()), baseVertices.data());
+        }
+        PrivateGlobal::Statistics::CountDraw(triangles);
+    }
+
+    void Shader::DrawMeshlets(const Model& model, const glm::mat4& modelToWorld, bool cullBackFacing) const
+    {
+        for (const auto& component : model.Components)
+            DrawMeshlets(component, modelToWorld, cullBackFacing);
+    }
+
+    void Shader::DrawInstanced(const Component& component, std::span<const glm::mat4> modelMatrices) const
+    {
+        if (modelMatrices.empty())
+            return;
+
+        const auto instances = UploadInstances(modelMatrices);
+        DrawUploadedInstances(component, instances.VBO, instances.Offset, static_cast<unsigned int>(modelMatrices.size()));
+    }
+
+    void Shader::DrawInstanced(const Model& model, std::span<const glm::mat4> modelMatrices) const
+    {
+        if (modelMatrices.empty())
+            return;
+
+        // All components share the same instances, so upload them once
+        const auto instances = UploadInstances(modelMatrices);
+        for (const auto& component : model.Components) {
+            DrawUploadedInstances(component, instances.VBO, instances.Offset, static_cast<unsigned int>(modelMatrices.size()));
+        }
+    }
+
+    void Shader::MultiDraw(std::span<const Component> components, const TextureBindingList& textures) const
+    {
+        // Set textures to shader, they are the same for all components
+        BindTextures(textures);
+
+        auto& arena = *components.front().m->Arena;
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        PrivateGlobal::GLState::BindVertexArray(arena.VAO);
+        SetPositionDequantization(components.front());
+        const auto drawCount = static_cast<GLsizei>(components.size());
+        size_t triangles = 0;
+        for (const auto& component : components)
+            triangles += component.Triangles();
+
+        if (PrivateGL::MultiDrawElementsIndirect != nullptr) {
+            static std::vector<DrawElementsIndirectCommand> commands;
+            commands.clear();
+            for (const auto& component : components)
+                commands.push_back({ component.m->NumberOfIndices, 1, component.m->FirstIndex, static_cast<int>(component.m->BaseVertex), 0 });
+
+            // Respecifying the storage orphans the commands of the previous multi-draw instead of waiting for the GPU to finish with them
+            if (arena.IndirectBuffer == 0)
+                glGenBuffers(1, &arena.IndirectBuffer);
+            glBindBuffer(PrivateGL::DRAW_INDIRECT_BUFFER, arena.IndirectBuffer);
+            glBufferData(PrivateGL::DRAW_INDIRECT_BUFFER, sizeof(DrawElementsIndirectCommand) * commands.size(), commands.data(), GL_STREAM_DRAW);
+            PrivateGlobal::Statistics::CountUpload(sizeof(DrawElementsIndirectCommand) * commands.size());
+            PrivateGL::MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, drawCount, 0);
+        }
+        else {
+            // OpenGL 3.3 fallback, the same draws as client side arrays
+            static std::vector<GLsizei> counts;
+            static std::vector<const void*> offsets;
+            static std::vector<GLint> baseVertices;
+            counts.clear();
+            offsets.clear();
+            baseVertices.clear();
+            for (const auto& component : components) {
+                counts.push_back(component.m->NumberOfIndices);
+                offsets.push_back(PrivateGlobal::IndexOffset(component.m->FirstIndex, component.m->IndexSize));
+                baseVertices.push_back(component.m->BaseVertex);
+            }
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts.data(), GL_UNSIGNED_INT, offsets.data(), drawCount, baseVertices.data());
+        }
+        PrivateGlobal::Statistics::CountDraw(triangles);
+    }
+
+    void Shader::DrawUploadedInstances(const Component& component, unsigned int instanceVBO, size_t instanceOffset, unsigned int instanceCount) const
+    {
+        // Set textures to shader
+        BindTextures(component);
+
+        // Perform Draw Operations, the instance attributes follow the attributes of the component
+        CHARIS_ASSERT(component.m->NumberOfAttributes <= FirstInstanceAttribute, "Instanced components can have at most ", FirstInstanceAttribute, " vertex attributes, not ", component.m->NumberOfAttributes, ".");
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        PrivateGlobal::GLState::BindVertexArray(component.m->VAO);
+        SetInstanceAttributes(instanceVBO, instanceOffset);
+        SetPositionDequantization(component);
+
+        if (component.m->UsingIBO) {
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, component.m->NumberOfIndices, PrivateGlobal::IndexType(component.m->IndexSize), PrivateGlobal::IndexOffset(component.m->FirstIndex, component.m->IndexSize), instanceCount, component.m->BaseVertex);
+        }
+        else {
+            glDrawArraysInstanced(GL_TRIANGLES, component.m->BaseVertex, component.m->NumberOfVertices, instanceCount);
+        }
+        ResetInstanceAttributes();
+        PrivateGlobal::Statistics::CountDraw(static_cast<size_t>(component.Triangles()) * instanceCount);
+    }
+
+    void Shader::SetPositionDequantization(const Component& component) const
+    {
+        if (m->PositionDequantizationLocation != -1)
+        {
+            glUniformMatrix4fv(m->PositionDequantizationLocation, 1, GL_FALSE, component.m->PositionDequantization.data());
+            PrivateGlobal::Statistics::CountCall();
+        }
+    }
+
+    Shader::TextureBindingList Shader::TextureBindings(const Component& component) const
+    {
+        // Gather the textures of the component into the sampler bindings assigned at link time
+        LinkedProgram();
+        auto textureCounter = std::array<unsigned int, Texture::Null>{};
+        auto bindings = TextureBindingList{};
+        // The whole range reserved for drawable textures is bound, so samplers the component has no texture for do not keep one of an earlier draw
+        if (m->NumberOfDrawableTextures > 0) {
+            bindings.First = 32 - static_cast<int>(m->NumberOfDrawableTextures * Texture::Null);
+            bindings.Last = 31;
+        }
+
+        for (const auto& texture : component.Textures) {
+            if (texture.Type == Texture::Null)
+                continue;
+
+            auto& typeCount = textureCounter[texture.Type];
+            if (typeCount >= m->NumberOfDrawableTextures)
+                continue;
+
+            const int binding = m->SamplerBindings[texture.Type][typeCount];
+            typeCount++;
+            if (binding == -1) {
+                CHARIS_ASSERT(binding != -1, "Shader uniform does not exist: ", Texture::ShaderTextureNames[texture.Type], typeCount);
+                continue;
+            }
+
+            bindings.TextureIDs[binding] = texture.m->ID;
+        }
+
+        return bindings;
+    }
+
+    void Shader::BindTextures(const Component& component) const
+    {
+        if (m->NumberOfDrawableTextures > 0)
+            BindTextures(TextureBindings(component));
+    }
+
+    unsigned int Shader::BindTextures(const TextureBindingList& bindings) const
+    {
+        if (bindings.Last < bindings.First)
+            return 0;
+
+        // Bind the whole range at once, bindings without a texture get unbound
+        const auto count = bindings.Last - bindings.First + 1;
+        return PrivateGlobal::GLState::BindTextures(bindings.First, count, &bindings.TextureIDs[bindings.First]);
+    }
+
+    Shader::Uniform Shader::GetUniform(const std::string& name) const
+    {
+        return { LinkedProgram(), UniformLocation(name) };
+    }
+
+    bool Shader::HasUniform(const std::string& name) const
+    {
+        LinkedProgram();
+        return m->UniformLocations.contains(name);
+    }
+
+    int Shader::UniformLocation(const std::string& name) const
+    {
+        const auto it = m->UniformLocations.find(name);
+        // without checks a missing uniform gets location -1, which GL ignores
+        if (it == m->UniformLocations.end()) {
+            CHARIS_ASSERT(it != m->UniformLocations.end(), "Shader uniform does not exist: ", name);
+            return -1;
+        }
+        return it->second;
+    }
+
+    int Shader::UniformLocation(Uniform uniform) const
+    {
+        CHARIS_ASSERT(uniform.Program == m->ID && uniform.Location != -1, "Shader uniform handle does not belong to this shader.");
+        return uniform.Location;
+    }
+
+    void Shader::SetBool(const std::string& name, bool value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform1i(UniformLocation(name), static_cast<int>(value));
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetInt(const std::string& name, int value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform1i(UniformLocation(name), value);
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetFloat(const std::string& name, float value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform1f(UniformLocation(name), value);
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetTexture(const std::string& name, unsigned int binding) const
+    {
+        CHARIS_ASSERT(binding <= 31, "Texture global state binding index must be in the range [0, 31].");
+        SetInt(name, binding);
+    }
+
+    void Shader::SetVec2(const std::string& name, const glm::vec2& value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform2fv(UniformLocation(name), 1, &value[0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec2(const std::string& name, float x, float y) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform2f(UniformLocation(name), x, y);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec3(const std::string& name, const glm::vec3& value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform3fv(UniformLocation(name), 1, &value[0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec3(const std::string& name, float x, float y, float z) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform3f(UniformLocation(name), x, y, z);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec4(const std::string& name, const glm::vec4& value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform4fv(UniformLocation(name), 1, &value[0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec4(const std::string& name, float x, float y, float z, float w) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform4f(UniformLocation(name), x, y, z, w);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetMat2(const std::string& name, const glm::mat2& mat) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniformMatrix2fv(UniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetMat3(const std::string& name, const glm::mat3& mat) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniformMatrix3fv(UniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniformMatrix4fv(UniformLocation(name), 1, GL_FALSE, &mat[0][0]);        // or use glm::value_ptr(model)
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetBool(Uniform uniform, bool value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform1i(UniformLocation(uniform), static_cast<int>(value));
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetInt(Uniform uniform, int value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform1i(UniformLocation(uniform), value);
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetFloat(Uniform uniform, float value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform1f(UniformLocation(uniform), value);
+        PrivateGlobal::Statistics::CountCall();
+    }
+
+    void Shader::SetTexture(Uniform uniform, unsigned int binding) const
+    {
+        CHARIS_ASSERT(binding <= 31, "Texture global state binding index must be in the range [0, 31].");
+        SetInt(uniform, binding);
+    }
+
+    void Shader::SetVec2(Uniform uniform, const glm::vec2& value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform2fv(UniformLocation(uniform), 1, &value[0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec2(Uniform uniform, float x, float y) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform2f(UniformLocation(uniform), x, y);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec3(Uniform uniform, const glm::vec3& value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform3fv(UniformLocation(uniform), 1, &value[0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec3(Uniform uniform, float x, float y, float z) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform3f(UniformLocation(uniform), x, y, z);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec4(Uniform uniform, const glm::vec4& value) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform4fv(UniformLocation(uniform), 1, &value[0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetVec4(Uniform uniform, float x, float y, float z, float w) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniform4f(UniformLocation(uniform), x, y, z, w);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetMat2(Uniform uniform, const glm::mat2& mat) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniformMatrix2fv(UniformLocation(uniform), 1, GL_FALSE, &mat[0][0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetMat3(Uniform uniform, const glm::mat3& mat) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniformMatrix3fv(UniformLocation(uniform), 1, GL_FALSE, &mat[0][0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+    void Shader::SetMat4(Uniform uniform, const glm::mat4& mat) const
+    {
+        PrivateGlobal::GLState::UseProgram(LinkedProgram());
+        glUniformMatrix4fv(UniformLocation(uniform), 1, GL_FALSE, &mat[0][0]);
+        PrivateGlobal::Statistics::CountCall();
+    }
+
 }
\ No newline at end of file
@@ -1,71 +1,227 @@
-#pragma once
-#include "Component.h"
-#include "Model.h"
-#include <string>
-#include <vector>
-#include <memory>
-
-// Libraries
-#include <glm/glm.hpp>
-
-namespace Charis {
-
-	/// <summary>An easy to use shader with GLM support. Contains methods to draw models and set shader uniform variables.</summary>
-	class Shader
-	{
-	public:
-		enum InputType {
-			// Provides paths to files with shader code to constructor.
-			Filepath,
-			// Shader source code is provided directly as a string to constructor.
-			InCode
-		};
-		/// <summary>
-		/// Constructor for a shader class.
-		/// </summary>
-		/// <param name="vertexShader">Contains either the path to a file with vertex shader source code or the source code directly.</param>
-		/// <param name="fragmentShader">Contains either the path to a file with fragment shader source code or the source code directly.</param>
-		/// <param name="inputType">Decides if arguments are treated as file paths or source code. Default as file path.</param>
-		/// <param name="numberOfDrawableTextures">
-		/// Number of textures, per texture type, that will automatically be bound and used when drawing with this texture. 
-		/// For example, with a limit at 3, the shader is expected to support 3 diffuse textures, 3 specular textures, and so on.
-		/// The naming convention follows {TextureType}Texture_{i}. For example, the 3rd diffuse texture is named DiffuseTexture_3.
-		/// When drawing the texture bindings start at 31 and counts downwards, meaning that for a limit at 3, bindings 0 to 16 
-		/// are safe to use for textures not bound to the model component. A limit at 0 means all texture binding management
-		/// must be manual.
-		/// </param>
-		Shader(const std::string& vertexShader, const std::string& fragmentShader, InputType inputType = Filepath, unsigned int numberOfDrawableTextures = 0);
-		~Shader();
-
-		// Uses this shader to draw a model component.
-		void Draw(const Component& component) const;
-		// Uses this shader to draw a list of model components.
-		void Draw(const std::vector<Component>& components) const;
-		// Use this shader to draw a model.
-		void Draw(const Model& model) const;
-
-		void SetBool(const std::string& name, bool value) const;
-		void SetInt(const std::string& name, int value) const;
-		void SetFloat(const std::string& name, float value) const;
-		void SetTexture(const std::string& name, unsigned int binding) const;
-
-		void SetVec2(const std::string& name, const glm::vec2& value) const;
-		void SetVec2(const std::string& name, float x, float y) const;
-		void SetVec3(const std::string& name, const glm::vec3& value) const;
-		void SetVec3(const std::string& name, float x, float y, float z) const;
-		void SetVec4(const std::string& name, const glm::vec4& value) const;
-		void SetVec4(const std::string& name, float x, float y, float z, float w) const;
-		void SetMat2(const std::string& name, const glm::mat2& mat) const;
-		void SetMat3(const std::string& name, const glm::mat3& mat) const;
-		void SetMat4(const std::string& name, const glm::mat4& mat) const;
-
-		
-	private:
-		struct ShaderMember {
-			unsigned int ID{};
-			unsigned int NumberOfDrawableTextures{};
-		};
-		std::shared_ptr<ShaderMember> m = std::make_shared<ShaderMember>();
-	};
-
+#pragma once
+#include "Component.h"
+#include "Model.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <span>
+#include <chrono>
+#include <cstdint>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	/// <summary>An easy to use shader with GLM support. Contains methods to draw models and set shader uniform variables.</summary>
+	class Shader
+	{
+	public:
+		enum InputType {
+			// Provides paths to files with shader code to constructor.
+			Filepath,
+			// Shader source code is provided directly as a string to constructor.
+			InCode
+		};
+		/// <summary>
+		/// Constructor for a shader class. The linked program is kept in the program cache, see Utility::SetProgramCacheDirectory,
+		/// so later constructions of the same shader, also in later runs, load it from there instead of compiling it.
+		/// </summary>
+		/// <param name="vertexShader">Contains either the path to a file with vertex shader source code or the source code directly.</param>
+		/// <param name="fragmentShader">Contains either the path to a file with fragment shader source code or the source code directly.</param>
+		/// <param name="inputType">Decides if arguments are treated as file paths or source code. Default as file path.</param>
+		/// <param name="numberOfDrawableTextures">
+		/// Number of textures, per texture type, that will automatically be bound and used when drawing with this texture. 
+		/// For example, with a limit at 3, the shader is expected to support 3 diffuse textures, 3 specular textures, and so on.
+		/// The naming convention follows {TextureType}Texture_{i}. For example, the 3rd diffuse texture is named DiffuseTexture_3.
+		/// Each sampler gets a fixed binding when the shader is linked, starting at 31 and counting downwards, meaning that for a limit at 3, 
+		/// bindings 0 to 16 are safe to use for textures not bound to the model component. The limit can be at most 6.
+		/// A limit at 0 means all texture binding management must be manual.
+		/// </param>
+		/// <param name="defines">
+		/// Preprocessor definitions like "SHADOWS" or "LIGHTS 4", added as #define lines right after the #version line of both shaders, for building variants of one source.
+		/// </param>
+		Shader(const std::string& vertexShader, const std::string& fragmentShader, InputType inputType = Filepath, unsigned int numberOfDrawableTextures = 0, const std::vector<std::string>& defines = {});
+
+		/// <summary>Everything the constructor takes, for building many shaders at once with CompileMany.</summary>
+		struct Source {
+			std::string VertexShader;
+			std::string FragmentShader;
+			InputType Type = Filepath;
+			unsigned int NumberOfDrawableTextures{};
+			std::vector<std::string> Defines;
+		};
+		/// <summary>
+		/// Starts building every shader without waiting for the driver, which then compiles them in parallel where it supports KHR_parallel_shader_compile.
+		/// Check IsReady every frame and draw with a fallback shader until it returns true. Using a shader that is not ready waits for it to finish.
+		/// </summary>
+		/// <param name="sources">Shaders to build. Shaders found in the program cache are ready right away.</param>
+		static std::vector<Shader> CompileMany(std::span<const Source> sources);
+		/// <summary>
+		/// Checks if the driver has finished building the shader, and finishes it if so. Without KHR_parallel_shader_compile the driver cannot be asked
+		/// without waiting, so then at most one shader per frame waits and becomes ready.
+		/// </summary>
+		bool IsReady() const;
+
+		/// <summary>Time the construction of this shader spent getting a linked program from the driver.</summary>
+		struct BuildTimes {
+			// Compiling the vertex and fragment shaders and linking them, 0 when the program came from the cache
+			float CompileMilliseconds{};
+			float LinkMilliseconds{};
+			// Reading and loading the cached binary, or reading it back from the driver and writing it for the next start
+			float CacheMilliseconds{};
+			bool FromCache{};
+			// From the start of the construction until the shader was ready to use, including any frames in between for CompileMany
+			float ReadyMilliseconds{};
+		};
+		BuildTimes GetBuildTimes() const;
+
+		/// <summary>
+		/// A resolved shader uniform. Get it once with GetUniform and pass it to the SetX overloads in hot loops, 
+		/// which then skip both the name lookup and the driver query.
+		/// </summary>
+		struct Uniform {
+			unsigned int Program{};
+			int Location = -1;
+		};
+		/// <summary>
+		/// Looks up an active uniform of this shader. If the uniform does not exist it aborts with a message at CHARIS_CHECK_CHEAP and above,
+		/// and at CHARIS_CHECK_OFF it returns location -1, which the SetX overloads pass on to GL and GL ignores.
+		/// </summary>
+		/// <param name="name">Name of the uniform as written in the shader, for example "dirLight.ambient" or "pointLights[2].position".</param>
+		Uniform GetUniform(const std::string& name) const;
+		/// <summary>Checks if the shader has an active uniform with the given name.</summary>
+		bool HasUniform(const std::string& name) const;
+
+		// Uses this shader to draw a model component.
+		void Draw(const Component& component) const;
+		// Uses this shader to draw a list of model components. Neighbouring components from the same GeometryArena with the same textures are drawn with a single multi-draw call.
+		void Draw(const std::vector<Component>& components) const;
+		// Use this shader to draw a model. A model loaded into a GeometryArena is drawn with a single multi-draw call per set of textures.
+		void Draw(const Model& model) const;
+		// Use this shader to draw a model that is loaded in the background. Draws its placeholder, or nothing, until the model is ready.
+		void Draw(const AsyncModel& model) const;
+		// Uses this shader to draw a level of detail of a model component, see Component::SelectLevel. Level 0 is the full component.
+		void Draw(const Component& component, unsigned int level) const;
+		/// <summary>
+		/// Uses this shader to draw a model with a level of detail per component, picked by Component::SelectLevel for the view of the last StartFrame.
+		/// The transform is only used to pick the levels, the shader still needs its own model matrix uniform.
+		/// </summary>
+		/// <param name="model">Model to draw.</param>
+		/// <param name="modelToWorld">Transform of the model into world space.</param>
+		/// <param name="levels">Level of every component, kept by the caller from frame to frame for each drawn copy of the model. Resized to the number of components.</param>
+		void Draw(const Model& model, const glm::mat4& modelToWorld, std::vector<unsigned int>& levels) const;
+		/// <summary>
+		/// Uses this shader to draw only the meshlets of a component that CullMeshlets keeps for the view of the last StartFrame,
+		/// with a single multi-draw call over the visible index ranges. Components without meshlets, or frames without a view, are drawn whole.
+		/// The transform is only used for culling, the shader still needs its own model matrix uniform.
+		/// </summary>
+		/// <param name="component">Component to draw.</param>
+		/// <param name="modelToWorld">Transform of the component into world space.</param>
+		/// <param name="cullBackFacing">Also drops meshlets that face away from the camera. Only use it with Utility::SetBackFaceCulling on, otherwise their back sides go missing.</param>
+		void DrawMeshlets(const Component& component, const glm::mat4& modelToWorld, bool cullBackFacing = false) const;
+		/// <summary>Uses this shader to draw the visible meshlets of every component of a model, see DrawMeshlets for components.</summary>
+		void DrawMeshlets(const Model& model, const glm::mat4& modelToWorld, bool cullBackFacing = false) const;
+
+		/// <summary>
+		/// Uses this shader to draw many copies of a model component in a single draw call, one per model matrix.
+		/// Per-instance attributes are provided to the vertex shader at the locations following the model file attributes:
+		/// mat4 model matrix at locations 5-8, and mat3 normal matrix (transposed inverse of the model matrix) at locations 9-11.
+		/// The component can have at most 5 vertex attributes of its own, and its vertex array is left without instance attributes afterwards.
+		/// </summary>
+		/// <param name="component">Component to draw.</param>
+		/// <param name="modelMatrices">Model-to-world matrix of every instance.</param>
+		void DrawInstanced(const Component& component, std::span<const glm::mat4> modelMatrices) const;
+		/// <summary>
+		/// Uses this shader to draw many copies of a model, with one draw call per model component.
+		/// See DrawInstanced for components for the expected per-instance vertex shader attributes.
+		/// </summary>
+		/// <param name="model">Model to draw.</param>
+		/// <param name="modelMatrices">Model-to-world matrix of every instance.</param>
+		void DrawInstanced(const Model& model, std::span<const glm::mat4> modelMatrices) const;
+
+		void SetBool(const std::string& name, bool value) const;
+		void SetInt(const std::string& name, int value) const;
+		void SetFloat(const std::string& name, float value) const;
+		void SetTexture(const std::string& name, unsigned int binding) const;
+
+		void SetVec2(const std::string& name, const glm::vec2& value) const;
+		void SetVec2(const std::string& name, float x, float y) const;
+		void SetVec3(const std::string& name, const glm::vec3& value) const;
+		void SetVec3(const std::string& name, float x, float y, float z) const;
+		void SetVec4(const std::string& name, const glm::vec4& value) const;
+		void SetVec4(const std::string& name, float x, float y, float z, float w) const;
+		void SetMat2(const std::string& name, const glm::mat2& mat) const;
+		void SetMat3(const std::string& name, const glm::mat3& mat) const;
+		void SetMat4(const std::string& name, const glm::mat4& mat) const;
+
+		void SetBool(Uniform uniform, bool value) const;
+		void SetInt(Uniform uniform, int value) const;
+		void SetFloat(Uniform uniform, float value) const;
+		void SetTexture(Uniform uniform, unsigned int binding) const;
+
+		void SetVec2(Uniform uniform, const glm::vec2& value) const;
+		void SetVec2(Uniform uniform, float x, float y) const;
+		void SetVec3(Uniform uniform, const glm::vec3& value) const;
+		void SetVec3(Uniform uniform, float x, float y, float z) const;
+		void SetVec4(Uniform uniform, const glm::vec4& value) const;
+		void SetVec4(Uniform uniform, float x, float y, float z, float w) const;
+		void SetMat2(Uniform uniform, const glm::mat2& mat) const;
+		void SetMat3(Uniform uniform, const glm::mat3& mat) const;
+		void SetMat4(Uniform uniform, const glm::mat4& mat) const;
+
+		friend class RenderQueue;
+	private:
+		// Texture names per binding for the drawable textures of a component. [First, Last] is the range of bindings reserved for drawable textures
+		// by the shader, empty if it has none, and bindings in it without a texture are 0.
+		struct TextureBindingList {
+			std::array<unsigned int, 32> TextureIDs{};
+			int First = 32;
+			int Last = -1;
+		};
+		TextureBindingList TextureBindings(const Component& component) const;
+		void BindTextures(const Component& component) const;
+		// Returns the number of bindings that changed.
+		unsigned int BindTextures(const TextureBindingList& bindings) const;
+		// Draws a component with textures already gathered by TextureBindings.
+		void Draw(const Component& component, const TextureBindingList& textures) const;
+		// Sets the dequantization of the component if the shader declares Component::ShaderPositionDequantizationName. Needs the program in use.
+		void SetPositionDequantization(const Component& component) const;
+		void MultiDraw(std::span<const Component> components, const TextureBindingList& textures) const;
+		void DrawUploadedInstances(const Component& component, unsigned int instanceVBO, size_t instanceOffset, unsigned int instanceCount) const;
+		int UniformLocation(const std::string& name) const;
+		int UniformLocation(Uniform uniform) const;
+		// Starts the build, which FinishBuild completes. Submits the compile and link without asking the driver for their status.
+		struct Deferred {};
+		Shader(const Source& source, Deferred);
+		// Waits for the driver if necessary, then checks the program for errors and reflects its uniforms.
+		void FinishBuild() const;
+		// The program, finished first if it is still being built.
+		unsigned int LinkedProgram() const;
+
+		struct ShaderMember {
+			unsigned int ID{};
+			unsigned int NumberOfDrawableTextures{};
+			BuildTimes Build{};
+			// All active uniforms of the linked program, reflected once after linking.
+			std::unordered_map<std::string, int> UniformLocations;
+			// Texture binding of every drawable sampler, per texture type and index. -1 if the sampler is not used by the shader.
+			std::array<std::vector<int>, Texture::Null> SamplerBindings;
+			// Location of the position dequantization matrix, -1 if the shader does not use it.
+			int PositionDequantizationLocation = -1;
+			// Build state of shaders from CompileMany, the shaders are deleted once the program is finished.
+			bool Ready = true;
+			unsigned int PendingVertex{};
+			unsigned int PendingFragment{};
+			bool CacheProgram{};
+			std::uint64_t CacheKey{};
+			std::chrono::steady_clock::time_point BuildStart;
+
+			// Deletes the program, and the shaders of a build that never finished, see ResourceRegistry::Pool.
+			void DeleteObjects();
+		};
+		Resource<ShaderMember> m = Resource<ShaderMember>::Make();
+	};
+
 }
\ No newline at end of file
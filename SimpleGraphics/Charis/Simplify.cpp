@@ -0,0 +1,279 @@
+#include "Private/Simplify.hpp"
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <cmath>
+
+namespace {
+    using Charis::PrivateGlobal::VertexAttributes;
+
+    // How much a change of unit length in the normal or texture coordinates counts, relative to moving the surface by the size of the mesh
+    constexpr double AttributeWeight = 0.0005;
+    // Cosine of the largest angle a collapse may turn a triangle by
+    constexpr double MinTurnCosine = 0.25;
+
+    // Weighted sum of squared distances to a set of planes, as the symmetric matrix of the quadratic form over (x, y, z, 1).
+    // Evaluates to the weighted mean, so errors stay distances in model units however many planes a vertex has gathered.
+    struct Quadric {
+        std::array<double, 10> A{};
+        double Weight{};
+
+        void AddPlane(const glm::dvec3& normal, double distance, double weight)
+        {
+            const double n[4] = { normal.x, normal.y, normal.z, distance };
+            int k = 0;
+            for (int i = 0; i < 4; i++) {
+                for (int j = i; j < 4; j++)
+                    A[k++] += weight * n[i] * n[j];
+            }
+            Weight += weight;
+        }
+
+        void Add(const Quadric& other)
+        {
+            for (size_t i = 0; i < A.size(); i++)
+                A[i] += other.A[i];
+            Weight += other.Weight;
+        }
+
+        double Evaluate(const glm::dvec3& p) const
+        {
+            const double v[4] = { p.x, p.y, p.z, 1.0 };
+            double sum = 0.0;
+            int k = 0;
+            for (int i = 0; i < 4; i++) {
+                for (int j = i; j < 4; j++)
+                    sum += (i == j ? 1.0 : 2.0) * A[k++] * v[i] * v[j];
+            }
+            return Weight > 0.0 ? std::max(sum / Weight, 0.0) : 0.0;
+        }
+    };
+
+    // Hashes the bits of a fixed number of floats, so vertices are only merged if they are exactly the same.
+    template<size_t N>
+    struct FloatsHash {
+        size_t operator()(const std::array<float, N>& values) const
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (auto value : values) {
+                std::uint32_t bits{};
+                std::memcpy(&bits, &value, sizeof(bits));
+                hash = (hash ^ bits) * 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+    template<size_t N>
+    struct FloatsEqual {
+        bool operator()(const std::array<float, N>& a, const std::array<float, N>& b) const { return std::memcmp(a.data(), b.data(), sizeof(float) * N) == 0; }
+    };
+
+    struct Collapse {
+        unsigned int From;
+        unsigned int To;
+        double Cost;
+    };
+
+}
+
+namespace Charis {
+
+    namespace PrivateGlobal {
+
+        std::vector<unsigned int> SimplifyMesh(std::span<const VertexAttributes> vertices, std::span<const unsigned int> indices, size_t targetIndexCount, float maxError, float& error)
+        {
+            error = 0.0f;
+            const auto vertexCount = static_cast<unsigned int>(vertices.size());
+
+            // Model files often store every corner of every triangle as its own vertex, so identical vertices are merged first
+            std::vector<unsigned int> remap(vertexCount);
+            std::vector<unsigned int> positionIds(vertexCount);
+            std::vector<unsigned int> verticesAtPosition;
+            {
+                std::unordered_map<std::array<float, 8>, unsigned int, FloatsHash<8>, FloatsEqual<8>> uniqueVertices;
+                std::unordered_map<std::array<float, 3>, unsigned int, FloatsHash<3>, FloatsEqual<3>> uniquePositions;
+                uniqueVertices.reserve(vertexCount);
+                uniquePositions.reserve(vertexCount);
+                for (unsigned int v = 0; v < vertexCount; v++) {
+                    const auto& vertex = vertices[v];
+                    const auto key = std::array<float, 8>{ vertex.Position.x, vertex.Position.y, vertex.Position.z, vertex.Normal.x, vertex.Normal.y, vertex.Normal.z, vertex.TexCoords.x, vertex.TexCoords.y };
+                    const auto [unique, added] = uniqueVertices.insert({ key, v });
+                    remap[v] = unique->second;
+                    if (!added)
+                        continue;
+
+                    const auto [position, newPosition] = uniquePositions.insert({ { vertex.Position.x, vertex.Position.y, vertex.Position.z }, static_cast<unsigned int>(verticesAtPosition.size()) });
+                    if (newPosition)
+                        verticesAtPosition.push_back(0);
+                    positionIds[v] = position->second;
+                    verticesAtPosition[position->second]++;
+                }
+            }
+
+            std::vector<unsigned int> result(indices.size());
+            for (size_t i = 0; i < indices.size(); i++)
+                result[i] = remap[indices[i]];
+
+            // Lock seams, and open borders, which are edges that only one triangle uses in either direction
+            std::vector<bool> locked(vertexCount, false);
+            for (unsigned int v = 0; v < vertexCount; v++)
+                locked[v] = remap[v] == v && verticesAtPosition[positionIds[v]] > 1;
+            {
+                std::unordered_map<std::uint64_t, unsigned int> edgeUses;
+                edgeUses.reserve(result.size());
+                const auto edgeKey = [&](unsigned int a, unsigned int b) {
+                    const auto pa = positionIds[a];
+                    const auto pb = positionIds[b];
+                    return (static_cast<std::uint64_t>(std::min(pa, pb)) << 32) | std::max(pa, pb);
+                };
+                for (size_t t = 0; t < result.size(); t += 3) {
+                    for (int e = 0; e < 3; e++)
+                        edgeUses[edgeKey(result[t + e], result[t + (e + 1) % 3])]++;
+                }
+                for (size_t t = 0; t < result.size(); t += 3) {
+                    for (int e = 0; e < 3; e++) {
+                        const auto a = result[t + e];
+                        const auto b = result[t + (e + 1) % 3];
+                        if (edgeUses[edgeKey(a, b)] == 1)
+                            locked[a] = locked[b] = true;
+                    }
+                }
+            }
+
+            // Every vertex starts with the planes of its triangles, weighted by their area
+            const auto positionOf = [&](unsigned int v) { return glm::dvec3(vertices[v].Position); };
+            std::vector<Quadric> quadrics(vertexCount);
+            auto bounds = glm::dvec3(0.0);
+            {
+                auto lower = glm::dvec3(std::numeric_limits<double>::max());
+                auto upper = glm::dvec3(std::numeric_limits<double>::lowest());
+                for (size_t t = 0; t < result.size(); t += 3) {
+                    const auto p0 = positionOf(result[t]);
+                    const auto p1 = positionOf(result[t + 1]);
+                    const auto p2 = positionOf(result[t + 2]);
+                    const auto cross = glm::cross(p1 - p0, p2 - p0);
+                    const auto area = glm::length(cross);
+                    lower = glm::min(lower, glm::min(p0, glm::min(p1, p2)));
+                    upper = glm::max(upper, glm::max(p0, glm::max(p1, p2)));
+                    if (area == 0.0)
+                        continue;
+                    const auto normal = cross / area;
+                    for (int corner = 0; corner < 3; corner++)
+                        quadrics[result[t + corner]].AddPlane(normal, -glm::dot(normal, p0), 0.5 * area);
+                }
+                bounds = upper - lower;
+            }
+            const auto scale = glm::length(bounds);
+            const auto attributeScale = AttributeWeight * scale * scale;
+            const auto maxCost = static_cast<double>(maxError) * maxError;
+            double largestCost = 0.0;
+
+            const auto collapseCost = [&](unsigned int from, unsigned int to) {
+                auto quadric = quadrics[from];
+                quadric.Add(quadrics[to]);
+                const auto normalChange = glm::length(vertices[from].Normal - vertices[to].Normal);
+                const auto texCoordChange = glm::length(vertices[from].TexCoords - vertices[to].TexCoords);
+                return quadric.Evaluate(positionOf(to)) + attributeScale * (normalChange * normalChange + texCoordChange * texCoordChange);
+            };
+
+            // Collapses run in passes. Every pass collapses the cheapest edges whose surroundings no other collapse of the pass touches,
+            // so the costs and flip tests of a pass stay valid without updating them after every collapse
+            std::vector<unsigned int> triangleStarts(vertexCount + 1);
+            std::vector<unsigned int> vertexTriangles;
+            std::vector<Collapse> collapses;
+            std::vector<bool> touched(vertexCount);
+            std::vector<unsigned int> collapseTo(vertexCount);
+            while (result.size() > targetIndexCount) {
+                // Triangles around every vertex
+                std::fill(triangleStarts.begin(), triangleStarts.end(), 0);
+                for (auto v : result)
+                    triangleStarts[v + 1]++;
+                std::partial_sum(triangleStarts.begin(), triangleStarts.end(), triangleStarts.begin());
+                vertexTriangles.resize(result.size());
+                auto fill = std::vector<unsigned int>(triangleStarts.begin(), triangleStarts.end() - 1);
+                for (size_t i = 0; i < result.size(); i++)
+                    vertexTriangles[fill[result[i]]++] = static_cast<unsigned int>(i / 3);
+
+                collapses.clear();
+                for (size_t t = 0; t < result.size(); t += 3) {
+                    for (int e = 0; e < 3; e++) {
+                        const auto a = result[t + e];
+                        const auto b = result[t + (e + 1) % 3];
+                        if (!locked[a])
+                            collapses.push_back({ a, b, collapseCost(a, b) });
+                        if (!locked[b])
+                            collapses.push_back({ b, a, collapseCost(b, a) });
+                    }
+                }
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.Cost < y.Cost; });
+
+                std::fill(touched.begin(), touched.end(), false);
+                std::iota(collapseTo.begin(), collapseTo.end(), 0u);
+                size_t removedIndices = 0;
+                size_t performed = 0;
+                for (const auto& collapse : collapses) {
+                    if (collapse.Cost > maxCost || result.size() - removedIndices <= targetIndexCount)
+                        break;
+                    const auto from = collapse.From;
+                    const auto to = collapse.To;
+                    if (touched[from] || touched[to])
+                        continue;
+
+                    // Moving the vertex must not turn any of its other triangles over, or nearly so, since several passes could add up to a turn
+                    bool flips = false;
+                    unsigned int sharedTriangles = 0;
+                    for (auto i = triangleStarts[from]; i < triangleStarts[from + 1] && !flips; i++) {
+                        const auto t = 3 * static_cast<size_t>(vertexTriangles[i]);
+                        const auto corner = result[t] == from ? 0 : (result[t + 1] == from ? 1 : 2);
+                        const auto x = result[t + (corner + 1) % 3];
+                        const auto y = result[t + (corner + 2) % 3];
+                        if (x == to || y == to) {
+                            sharedTriangles++;
+                            continue;
+                        }
+                        const auto before = glm::cross(positionOf(x) - positionOf(from), positionOf(y) - positionOf(from));
+                        const auto after = glm::cross(positionOf(x) - positionOf(to), positionOf(y) - positionOf(to));
+                        flips = glm::dot(before, after) <= MinTurnCosine * glm::length(before) * glm::length(after);
+                    }
+                    if (flips)
+                        continue;
+
+                    collapseTo[from] = to;
+                    for (auto i = triangleStarts[from]; i < triangleStarts[from + 1]; i++) {
+                        const auto t = 3 * static_cast<size_t>(vertexTriangles[i]);
+                        touched[result[t]] = touched[result[t + 1]] = touched[result[t + 2]] = true;
+                    }
+                    quadrics[to].Add(quadrics[from]);
+                    largestCost = std::max(largestCost, collapse.Cost);
+                    removedIndices += 3 * static_cast<size_t>(sharedTriangles);
+                    performed++;
+                }
+                if (performed == 0)
+                    break;
+
+                // Move the collapsed vertices and drop the triangles that became lines
+                size_t kept = 0;
+                for (size_t t = 0; t < result.size(); t += 3) {
+                    const auto a = collapseTo[result[t]];
+                    const auto b = collapseTo[result[t + 1]];
+                    const auto c = collapseTo[result[t + 2]];
+                    if (a == b || b == c || c == a)
+                        continue;
+                    result[kept++] = a;
+                    result[kept++] = b;
+                    result[kept++] = c;
+                }
+                result.resize(kept);
+            }
+
+            error = static_cast<float>(std::sqrt(largestCost));
+            return result;
+        }
+
+    }
+
+}
@@ -0,0 +1,152 @@
+#include "StreamBuffer.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include <utility>
+#include <algorithm>
+
+// Libraries
+#include <glad/glad.h>
+
+namespace {
+    using namespace Charis;
+
+    // Part of the buffer owned by the current frame. Orphaning gets fresh storage every frame instead, so it only needs one part.
+    size_t FrameBase(const StreamBufferMember& member)
+    {
+        return member.Method == StreamBuffer::PersistentMapping ? member.BytesPerFrame * PrivateGlobal::FrameSync::Current : 0;
+    }
+}
+
+namespace Charis {
+
+    StreamBuffer::Allocation::Allocation(Allocation&& other) noexcept
+        : m_Owner(std::exchange(other.m_Owner, nullptr)), m_Data(std::exchange(other.m_Data, nullptr)), m_Buffer(std::exchange(other.m_Buffer, 0)), 
+        m_Offset(other.m_Offset), m_Size(std::exchange(other.m_Size, 0))
+    {}
+
+    StreamBuffer::Allocation& StreamBuffer::Allocation::operator=(Allocation&& other) noexcept
+    {
+        if (this != &other) {
+            Finish();
+            m_Owner = std::exchange(other.m_Owner, nullptr);
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Buffer = std::exchange(other.m_Buffer, 0);
+            m_Offset = other.m_Offset;
+            m_Size = std::exchange(other.m_Size, 0);
+        }
+        return *this;
+    }
+
+    StreamBuffer::Allocation::~Allocation()
+    {
+        Finish();
+    }
+
+    void StreamBuffer::Allocation::Finish()
+    {
+        if (m_Owner == nullptr)
+            return;
+
+        // Coherent mappings need nothing, the writes are seen by every command issued after them
+        if (m_Owner->Method == Orphaning && m_Size > 0) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, m_Offset, m_Size, m_Data);
+            PrivateGlobal::Statistics::CountCall();
+        }
+        PrivateGlobal::Statistics::CountUpload(m_Size);
+        m_Owner = nullptr;
+        m_Data = nullptr;
+    }
+
+    void StreamBuffer::Allocation::BindUniformBlock(unsigned int bindingPoint)
+    {
+        CHARIS_ASSERT(m_Buffer != 0 && m_Size > 0, "Can not bind an empty allocation.");
+        Finish();
+        glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, m_Buffer, m_Offset, m_Size);
+    }
+
+    StreamBuffer::StreamBuffer(size_t bytesPerFrame, Method method)
+    {
+        Helper::RuntimeAssert(bytesPerFrame > 0, "StreamBuffer must have room for at least one byte per frame.");
+        m->BytesPerFrame = bytesPerFrame;
+        m->Method = PrivateGL::BufferStorage != nullptr ? method : Orphaning;
+        m->Frame = PrivateGlobal::FrameSync::Frame;
+
+        glGenBuffers(1, &m->Buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m->Buffer);
+        if (m->Method == PersistentMapping) {
+            const auto bytes = bytesPerFrame * PrivateGlobal::FrameSync::MaxFramesInFlight;
+            const GLbitfield flags = GL_MAP_WRITE_BIT | PrivateGL::MAP_PERSISTENT_BIT | PrivateGL::MAP_COHERENT_BIT;
+            PrivateGL::BufferStorage(GL_COPY_WRITE_BUFFER, bytes, nullptr, flags);
+            m->Mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, bytes, flags));
+            Helper::RuntimeAssert(m->Mapped != nullptr, "Failed to map stream buffer.");
+        }
+        else {
+            glBufferData(GL_COPY_WRITE_BUFFER, bytesPerFrame, nullptr, GL_STREAM_DRAW);
+            m->Staging.resize(bytesPerFrame);
+        }
+    }
+
+    StreamBuffer::Allocation StreamBuffer::Allocate(size_t bytes, size_t alignment)
+    {
+        CHARIS_ASSERT(alignment > 0, "Alignment must be at least 1.");
+        // EndFrame waited for the GPU to finish the last frame that used this part of the buffer, so the allocations of that frame are free again
+        if (m->Frame != PrivateGlobal::FrameSync::Frame) {
+            m->Frame = PrivateGlobal::FrameSync::Frame;
+            m->Used = 0;
+            if (m->Method == Orphaning) {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, m->Buffer);
+                glBufferData(GL_COPY_WRITE_BUFFER, m->BytesPerFrame, nullptr, GL_STREAM_DRAW);
+                PrivateGlobal::Statistics::CountCall();
+            }
+        }
+
+        // The offset is aligned within the whole buffer, since that is what binding a range of it checks
+        const auto base = FrameBase(*m);
+        const auto offset = (base + m->Used + alignment - 1) / alignment * alignment;
+        // Checked whatever the CHARIS_CHECK_LEVEL, since the allocation would reach past the end of the buffer
+        if (offset + bytes > base + m->BytesPerFrame)
+            Helper::RuntimeAssert(false, "StreamBuffer is out of space for this frame, create it with more bytes per frame.");
+        m->Used = offset + bytes - base;
+
+        auto allocation = Allocation{};
+        allocation.m_Owner = &*m;
+        allocation.m_Buffer = m->Buffer;
+        allocation.m_Data = m->Method == PersistentMapping ? m->Mapped + offset : m->Staging.data() + offset;
+        allocation.m_Offset = offset;
+        allocation.m_Size = bytes;
+        return allocation;
+    }
+
+    StreamBuffer::Allocation StreamBuffer::AllocateUniform(size_t bytes)
+    {
+        static const auto alignment = [] {
+            auto value = GLint{};
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value);
+            return static_cast<size_t>(std::max(value, 1));
+        }();
+        return Allocate(bytes, alignment);
+    }
+
+    size_t StreamBuffer::BytesPerFrame() const
+    {
+        return m->BytesPerFrame;
+    }
+
+    size_t StreamBuffer::BytesUsed() const
+    {
+        return m->Frame == PrivateGlobal::FrameSync::Frame ? m->Used : 0;
+    }
+
+    StreamBuffer::Method StreamBuffer::UsedMethod() const
+    {
+        return m->Method;
+    }
+
+    void StreamBufferMember::DeleteObjects()
+    {
+        // Deleting a mapped buffer unmaps it
+        glDeleteBuffers(1, &Buffer);
+    }
+
+}
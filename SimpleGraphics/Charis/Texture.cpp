@@ -1,50 +1,230 @@
-#include "Texture.h"
-#include "Utility.h"
-#include "External/stb_image.h"
-
-// Libraries
-#include <glad/glad.h>
-
-namespace Charis {
-
-	Texture::Texture(const std::string& pathToImage, TextureType type) : Type(type)
-	{
-        glGenTextures(1, &m->ID);
-        glBindTexture(GL_TEXTURE_2D, m->ID);
-
-        // set the texture wrapping parameters, (GL_REPEAT is default wrapping method)
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        // set texture filtering parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // load image, create texture and generate mipmaps
-        int width, height, nrChannels;
-        const int desiredNrChannels = 4;
-        unsigned char* data = stbi_load(pathToImage.data(), &width, &height, &nrChannels, desiredNrChannels);
-        Helper::RuntimeAssert(data, "Failed to load texture: " + pathToImage);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        stbi_image_free(data);
-	}
-
-	Texture::~Texture()
-	{
-        if (m.use_count() > 1)
-            return;
-
-		glDeleteTextures(1, &m->ID);
-	}
-
-    void Texture::BindTo(unsigned int binding) const
-    {
-        Helper::RuntimeAssert(31 >= binding && binding >= 0, "Texture global state binding index must be in the range [0, 31].");
-        int bindingCode = binding + GL_TEXTURE0; // 0x84C0
-        glActiveTexture(bindingCode);
-        glBindTexture(GL_TEXTURE_2D, m->ID);
-    }
-
-}
-
-
+#include "Texture.h"
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/DecodedImage.hpp"
+#include "External/stb_image.h"
+#include <chrono>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include <utility>
+
+// Libraries
+#include <glad/glad.h>
+
+// receives the timings of every texture loaded from file, see Texture::SetLoadTimingHook.
+static std::function<void(const Charis::Texture::LoadTiming&)> LoadTimingHook;
+
+static float MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static Charis::DecodedImage DecodeFile(const std::string& path)
+{
+    auto image = Charis::DecodedImage();
+    image.Decode(path);
+    return image;
+}
+
+// source rows or columns averaged into one row or column of the next mip level: two, or three for the last one of an odd size, so that none is dropped.
+struct MipTaps { int First; int Count; };
+static MipTaps TapsOf(int mipTexel, int mipSize, int size)
+{
+    if (size == 1)
+        return { 0, 1 };
+    return { 2 * mipTexel, mipTexel == mipSize - 1 && size % 2 == 1 ? 3 : 2 };
+}
+
+// creates a texture from tightly packed 8 bit pixels and leaves it bound to the active texture unit.
+// levels holds the full size image followed by any number of its mip levels, missing mip levels are generated by GL.
+static unsigned int CreateTexture(int width, int height, int channels, std::span<const unsigned char* const> levels)
+{
+    unsigned int id{};
+    glGenTextures(1, &id);
+    Charis::PrivateGlobal::GLState::BindTexture(Charis::PrivateGlobal::GLState::ActiveTexture, id);
+
+    // set the texture wrapping parameters, (GL_REPEAT is default wrapping method)
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    // set texture filtering parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // grey and grey-alpha images are read as such by shaders instead of as red and red-green
+    if (channels == 1) {
+        const GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    else if (channels == 2) {
+        const GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_GREEN };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+
+    // rows are tightly packed whatever the number of channels
+    const GLenum formats[] = { GL_RED, GL_RG, GL_RGB, GL_RGBA };
+    const GLenum sizedFormats[] = { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
+    const auto format = formats[channels - 1];
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // immutable storage for the whole mip chain if available, otherwise specify level by level
+    const auto levelCount = static_cast<int>(std::bit_width(static_cast<unsigned int>(std::max(width, height))));
+    if (Charis::PrivateGL::TexStorage2D != nullptr)
+        Charis::PrivateGL::TexStorage2D(GL_TEXTURE_2D, levelCount, sizedFormats[channels - 1], width, height);
+
+    for (int level = 0; level < static_cast<int>(levels.size()); level++) {
+        const auto levelWidth = std::max(1, width >> level);
+        const auto levelHeight = std::max(1, height >> level);
+        if (Charis::PrivateGL::TexStorage2D != nullptr)
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, levelWidth, levelHeight, format, GL_UNSIGNED_BYTE, levels[level]);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, sizedFormats[channels - 1], levelWidth, levelHeight, 0, format, GL_UNSIGNED_BYTE, levels[level]);
+        Charis::PrivateGlobal::Statistics::CountUpload(static_cast<size_t>(levelWidth) * levelHeight * channels);
+    }
+    if (static_cast<int>(levels.size()) < levelCount)
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+    return id;
+}
+
+namespace Charis {
+
+	// load image, create texture and let GL generate mipmaps, which is faster than the CPU for a single texture.
+	// Delegating to the move constructor takes over the resource of the created texture instead of making one of its own first.
+	Texture::Texture(const std::string& pathToImage, TextureType type) : Texture(DecodeFile(pathToImage).CreateTexture(type))
+	{}
+
+	Texture::Texture(const unsigned char* pixels, int width, int height, int channels, TextureType type) : Type(type)
+	{
+        Helper::RuntimeAssert(channels >= 1 && channels <= 4, "Texture must have 1 to 4 channels.");
+        const unsigned char* levels[] = { pixels };
+        m->ID = CreateTexture(width, height, channels, levels);
+	}
+
+	Texture::Texture(const DecodedImage& image, TextureType type) : Type(type)
+	{
+        std::vector<const unsigned char*> levels = { image.Pixels };
+        for (const auto& mip : image.Mips)
+            levels.push_back(mip.data());
+        m->ID = CreateTexture(image.Width, image.Height, image.Channels, levels);
+	}
+
+	void Texture::SetLoadTimingHook(std::function<void(const LoadTiming&)> hook)
+	{
+        LoadTimingHook = std::move(hook);
+	}
+
+	void Texture::TextureMember::DeleteObjects()
+	{
+		PrivateGlobal::GLState::ForgetTexture(ID);
+		glDeleteTextures(1, &ID);
+	}
+
+    void Texture::BindTo(unsigned int binding) const
+    {
+        CHARIS_ASSERT(binding <= 31, "Texture global state binding index must be in the range [0, 31].");
+        PrivateGlobal::GLState::BindTexture(binding, m->ID);
+    }
+
+    DecodedImage::DecodedImage(DecodedImage&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    DecodedImage& DecodedImage::operator=(DecodedImage&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        stbi_image_free(Pixels);
+        Path = std::move(other.Path);
+        Width = other.Width;
+        Height = other.Height;
+        Channels = other.Channels;
+        Pixels = std::exchange(other.Pixels, nullptr);
+        Mips = std::move(other.Mips);
+        DecodeMilliseconds = other.DecodeMilliseconds;
+        MipMilliseconds = other.MipMilliseconds;
+        return *this;
+    }
+
+    DecodedImage::~DecodedImage()
+    {
+        stbi_image_free(Pixels);
+    }
+
+    void DecodedImage::Decode(const std::string& path)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Path = path;
+        // keep the channels of the file, single channel maps stay a quarter of the size of RGBA
+        Pixels = stbi_load(path.data(), &Width, &Height, &Channels, 0);
+        if (!Pixels)
+            Helper::RuntimeAssert(false, "Failed to load texture: " + path);
+        DecodeMilliseconds = MillisecondsSince(start);
+    }
+
+    void DecodedImage::GenerateMips()
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Mips.clear();
+
+        auto source = static_cast<const unsigned char*>(Pixels);
+        int width = Width;
+        int height = Height;
+        while (width > 1 || height > 1) {
+            const auto mipWidth = std::max(1, width / 2);
+            const auto mipHeight = std::max(1, height / 2);
+            auto& mip = Mips.emplace_back(static_cast<size_t>(mipWidth) * mipHeight * Channels);
+
+            // box filter, an odd last row or column is folded into the last texel of the mip, which then averages three instead of two
+            for (int y = 0; y < mipHeight; y++) {
+                const auto rows = TapsOf(y, mipHeight, height);
+                for (int x = 0; x < mipWidth; x++) {
+                    const auto columns = TapsOf(x, mipWidth, width);
+                    const auto taps = rows.Count * columns.Count;
+                    for (int c = 0; c < Channels; c++) {
+                        int sum = 0;
+                        for (int row = rows.First; row < rows.First + rows.Count; row++)
+                            for (int column = columns.First; column < columns.First + columns.Count; column++)
+                                sum += source[(row * width + column) * Channels + c];
+                        mip[(y * mipWidth + x) * Channels + c] = static_cast<unsigned char>((sum + taps / 2) / taps);
+                    }
+                }
+            }
+
+            source = mip.data();
+            width = mipWidth;
+            height = mipHeight;
+        }
+        MipMilliseconds = MillisecondsSince(start);
+    }
+
+    size_t DecodedImage::Bytes() const
+    {
+        size_t bytes = static_cast<size_t>(Width) * Height * Channels;
+        for (const auto& mip : Mips)
+            bytes += mip.size();
+        return bytes;
+    }
+
+    Texture DecodedImage::CreateTexture(Texture::TextureType type) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto texture = Texture(*this, type);
+        const auto uploadMilliseconds = MillisecondsSince(start);
+
+        if (LoadTimingHook) {
+            LoadTimingHook({
+                .Path = Path,
+                .Width = Width,
+                .Height = Height,
+                .Channels = Channels,
+                .DecodeMilliseconds = DecodeMilliseconds,
+                .MipMilliseconds = MipMilliseconds,
+                .UploadMilliseconds = uploadMilliseconds
+            });
+        }
+        return texture;
+    }
+
+}
\ No newline at end of file
@@ -1,50 +1,83 @@
-#pragma once
-#include <string>
-#include <memory>
-#include <array>
-
-namespace Charis {
-
-	/// <summary>
-	/// A texture is a 2D image that can be used in shaders.
-	/// To use it in a shader it must first be bound to one of 32 global state textures, and then give the shader the global state. 
-	/// </summary>
-	class Texture
-	{
-	public:
-		enum TextureType {
-			Diffuse = 0,
-			Specular = 1,
-			Normal = 2,
-			Height = 3,
-			Ambient = 4,
-			Null
-		};
-		static constexpr std::array<const char*, Null> ShaderTextureNames { 
-			"DiffuseTexture_", 
-			"SpecularTexture_", 
-			"NormalTexture_", 
-			"HeightTexture_", 
-			"AmbientTexture_" 
-		};
-		TextureType Type;
-
-		/// <summary>Constructor for a texture.</summary>
-		/// <param name="pathToImage">File path to image to load into texture.</param>
-		/// <param name="type">Type of texture it is. Null textures require manual handling and will not be automatically added to shaders when drawing model components.</param>
-		Texture(const std::string& pathToImage, TextureType type = Null);
-		~Texture();
-
-		/// <summary>
-		/// This function binds the texture to one of the 32 global texture states. Shaders access textures from the global states so this is a requirement for shaders.
-		/// </summary>
-		/// <param name="binding">Value must be in [0, 31] range. The global state binding index that should be used to access this texture.</param>
-		void BindTo(unsigned int binding) const;
-
-	private:
-		struct TextureMember {
-			unsigned int ID{};
-		};
-		std::shared_ptr<TextureMember> m = std::make_shared<TextureMember>();
-	};
-}
+#pragma once
+#include "Resource.h"
+#include <string>
+#include <array>
+#include <functional>
+
+namespace Charis {
+
+	struct DecodedImage;
+
+	/// <summary>
+	/// A texture is a 2D image that can be used in shaders.
+	/// To use it in a shader it must first be bound to one of 32 global state textures, and then give the shader the global state. 
+	/// </summary>
+	class Texture
+	{
+	public:
+		enum TextureType {
+			Diffuse = 0,
+			Specular = 1,
+			Normal = 2,
+			Height = 3,
+			Ambient = 4,
+			Null
+		};
+		static constexpr std::array<const char*, Null> ShaderTextureNames { 
+			"DiffuseTexture_", 
+			"SpecularTexture_", 
+			"NormalTexture_", 
+			"HeightTexture_", 
+			"AmbientTexture_" 
+		};
+		TextureType Type;
+
+		/// <summary>Constructor for a texture.</summary>
+		/// <param name="pathToImage">File path to image to load into texture. The texture keeps the number of channels of the image.</param>
+		/// <param name="type">Type of texture it is. Null textures require manual handling and will not be automatically added to shaders when drawing model components.</param>
+		Texture(const std::string& pathToImage, TextureType type = Null);
+		/// <summary>Constructor for a texture from an image in memory.</summary>
+		/// <param name="pixels">Pointer to the pixels, row by row with 8 bits per channel, starting at the bottom left.</param>
+		/// <param name="width">Width of the image in pixels.</param>
+		/// <param name="height">Height of the image in pixels.</param>
+		/// <param name="channels">Number of channels per pixel, in the range [1, 4].</param>
+		/// <param name="type">Type of texture it is. Null textures require manual handling and will not be automatically added to shaders when drawing model components.</param>
+		Texture(const unsigned char* pixels, int width, int height, int channels, TextureType type = Null);
+
+		/// <summary>
+		/// This function binds the texture to one of the 32 global texture states. Shaders access textures from the global states so this is a requirement for shaders.
+		/// </summary>
+		/// <param name="binding">Value must be in [0, 31] range. The global state binding index that should be used to access this texture.</param>
+		void BindTo(unsigned int binding) const;
+
+		// Time spent loading one texture from file, see SetLoadTimingHook.
+		struct LoadTiming {
+			std::string Path;
+			int Width{};
+			int Height{};
+			int Channels{};
+			float DecodeMilliseconds{};
+			// Zero if the mip levels were generated by GL.
+			float MipMilliseconds{};
+			float UploadMilliseconds{};
+		};
+		/// <summary>
+		/// Sets a function that receives the timings of every texture loaded from file, called on the main thread once the texture is uploaded.
+		/// Decoding and mip generation may have run on a worker thread. Pass an empty function to remove the hook.
+		/// </summary>
+		static void SetLoadTimingHook(std::function<void(const LoadTiming&)> hook);
+
+		friend class Shader;
+		friend struct DecodedImage;
+	private:
+		Texture(const DecodedImage& image, TextureType type);
+
+		struct TextureMember {
+			unsigned int ID{};
+
+			// Deletes the texture, see ResourceRegistry::Pool.
+			void DeleteObjects();
+		};
+		Resource<TextureMember> m = Resource<TextureMember>::Make();
+	};
+}
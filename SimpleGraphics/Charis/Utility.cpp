@@ -1,91 +1,147 @@
-#include "Utility.h"
-#include "Private/CharisGlobals.hpp"
-#include <iostream>
-#include <stdlib.h>
-
-// Libraries
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-namespace Charis {
-
-	namespace Helper {
-
-		void RuntimeAssert(bool condition, const std::string& errorMessage)
-		{
-			if (!condition) {
-				std::cout << errorMessage << std::endl;
-				abort();
-			}
-		}
-
-	}
-
-	namespace Utility {
-
-		void SetCursorBehavior(CursorBehavior behavior)
-		{
-			switch (behavior) {
-			case CursorBehavior::Normal:
-				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-				break;
-			case CursorBehavior::Lock:
-				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_CAPTURED);
-				break;
-			case CursorBehavior::Hide:
-				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
-				break;
-			case CursorBehavior::LockAndHide:
-				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-				break;
-			}
-		}
-
-		WindowDimensions GetWindowDimensions()
-		{
-			return { PrivateGlobal::Window::Width, PrivateGlobal::Window::Height };
-		}
-
-		void CloseWindow()
-		{
-			glfwSetWindowShouldClose(PrivateGlobal::Window, true);
-		}
-
-		void SetWindowBackground(const std::array<float, 3>& RGB)
-		{
-			PrivateGlobal::BackgroundRGB = RGB;
-		}
-
-		float GetTime()
-		{
-			return static_cast<float>(glfwGetTime());
-		}
-
-	}
-
-	namespace Input {
-
-		Position CursorPosition()
-		{
-			return { PrivateGlobal::Mouse::X, PrivateGlobal::Mouse::Y };
-		}
-
-		float MouseWheel()
-		{
-			return PrivateGlobal::Mouse::Wheel;
-		}
-
-		bool KeyState(Key key, Trigger trigger)
-		{
-			return glfwGetKey(PrivateGlobal::Window, key) == trigger;
-		}
-
-		bool MouseButtonState(Mouse button, Trigger trigger)
-		{
-			return glfwGetMouseButton(PrivateGlobal::Window, button) == trigger;
-		}
-
-	}
-
-}
-
+#include "Utility.h"
+#include "Private/CharisGlobals.hpp"
+#include "Private/AsyncLoading.hpp"
+#include "Private/ProgramCache.hpp"
+#include <iostream>
+#include <stdlib.h>
+
+// Libraries
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace Charis {
+
+	namespace PrivateGlobal {
+
+		void Diagnose(Utility::DiagnosticSeverity severity, const std::string& message)
+		{
+			if (Diagnostics::Handler) {
+				Diagnostics::Handler(severity, message);
+				return;
+			}
+			const char* prefix = severity == Utility::DiagnosticSeverity::Error ? "Error: " : severity == Utility::DiagnosticSeverity::Warning ? "Warning: " : "";
+			std::cerr << prefix << message << std::endl;
+		}
+
+	}
+
+	namespace Helper {
+
+		void RuntimeAssert(bool condition, const std::string& errorMessage)
+		{
+			if (!condition) {
+				PrivateGlobal::Diagnose(Utility::DiagnosticSeverity::Error, errorMessage);
+				abort();
+			}
+		}
+
+		void AssertionFailed(const char* condition, const char* file, int line, const std::string& message)
+		{
+			PrivateGlobal::Diagnose(Utility::DiagnosticSeverity::Error, message + " (" + condition + " failed at " + file + ":" + std::to_string(line) + ")");
+			abort();
+		}
+
+	}
+
+	namespace Utility {
+
+		void SetCursorBehavior(CursorBehavior behavior)
+		{
+			switch (behavior) {
+			case CursorBehavior::Normal:
+				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+				break;
+			case CursorBehavior::Lock:
+				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_CAPTURED);
+				break;
+			case CursorBehavior::Hide:
+				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+				break;
+			case CursorBehavior::LockAndHide:
+				glfwSetInputMode(PrivateGlobal::Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+				break;
+			}
+		}
+
+		WindowDimensions GetWindowDimensions()
+		{
+			return { PrivateGlobal::Window::Width, PrivateGlobal::Window::Height };
+		}
+
+		void CloseWindow()
+		{
+			glfwSetWindowShouldClose(PrivateGlobal::Window, true);
+		}
+
+		void SetWindowBackground(const std::array<float, 3>& RGB)
+		{
+			PrivateGlobal::BackgroundRGB = RGB;
+		}
+
+		void SetUploadBudget(unsigned int bytesPerFrame, float millisecondsPerFrame)
+		{
+			PrivateGlobal::UploadQueue::BudgetBytes = bytesPerFrame;
+			PrivateGlobal::UploadQueue::BudgetMilliseconds = millisecondsPerFrame;
+		}
+
+		void SetBackFaceCulling(bool enabled)
+		{
+			PrivateGlobal::GLState::SetCullFace(enabled);
+		}
+
+		void SetLevelOfDetailSelection(float pixelError, float hysteresis)
+		{
+			Helper::RuntimeAssert(pixelError > 0.0f, "Pixel error must be positive.");
+			Helper::RuntimeAssert(hysteresis >= 0.0f && hysteresis < 1.0f, "Hysteresis must be in [0, 1).");
+			PrivateGlobal::LevelOfDetailSelection::PixelError = pixelError;
+			PrivateGlobal::LevelOfDetailSelection::Hysteresis = hysteresis;
+		}
+
+		void SetProgramCacheDirectory(const std::string& directory)
+		{
+			PrivateGlobal::ProgramCacheSettings::Directory = directory;
+		}
+
+		FrameStatistics GetFrameStatistics()
+		{
+			return PrivateGlobal::Statistics::LastFrame;
+		}
+
+		float GetTime()
+		{
+			return static_cast<float>(glfwGetTime());
+		}
+
+		void SetDiagnosticHandler(DiagnosticHandler handler)
+		{
+			PrivateGlobal::Diagnostics::Handler = std::move(handler);
+		}
+
+	}
+
+	namespace Input {
+
+		Position CursorPosition()
+		{
+			return { PrivateGlobal::Mouse::X, PrivateGlobal::Mouse::Y };
+		}
+
+		float MouseWheel()
+		{
+			return PrivateGlobal::Mouse::Wheel;
+		}
+
+		bool KeyState(Key key, Trigger trigger)
+		{
+			return glfwGetKey(PrivateGlobal::Window, key) == trigger;
+		}
+
+		bool MouseButtonState(Mouse button, Trigger trigger)
+		{
+			return glfwGetMouseButton(PrivateGlobal::Window, button) == trigger;
+		}
+
+	}
+
+}
+
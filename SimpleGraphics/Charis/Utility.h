@@ -1,130 +1,243 @@
-#pragma once
-#include <string>
-#include <array>
-
-namespace Charis {
-
-	namespace Helper {
-
-		/// <summary>Asserts that a condition is true at runtime and aborts the program if it is not.</summary>
-		/// <param name="condition">Condition that must be true for program to keep running.</param>
-		/// <param name="errorMessage">Error message that is printed if condition is false.</param>
-		void RuntimeAssert(bool condition, const std::string& errorMessage);
-
-	}
-
-	namespace Utility {
-
-		// Used for SetCursorBehavior function.
-		enum CursorBehavior {
-			// Normal and default behavior. Can move freely inside and outside of window.
-			Normal,
-			// Locks the cursor to the window.
-			Lock,
-			// Hides the cursor while inside the window.
-			Hide,
-			// Cursor is locked to window and invisible.
-			LockAndHide
-		};
-		// Sets how the cursor should be managed by the window.
-		void SetCursorBehavior(CursorBehavior behavior);
-
-		struct WindowDimensions { unsigned int Width; unsigned int Height; };
-		// Get window dimensions
-		WindowDimensions GetWindowDimensions();
-
-		// Closes the window.
-		void CloseWindow();
-
-		/// <summary>Sets the background color of the window.</summary>
-		/// <param name="RGB">RGB color values ranging from 0.0 to 1.0.</param>
-		void SetWindowBackground(const std::array<float, 3>& RGB);
-
-		/// <summary>Returns the time in seconds since initialization.</summary>
-		float GetTime();
-	}
-
-	namespace Input {
-
-		struct Position {
-			float X{};
-			float Y{};
-		};
-		// Gets the X and Y coordinates of the cursor.
-		Position CursorPosition();
-		// Gets the position of the mouse wheel.
-		float MouseWheel();
-
-		// Must match GLFW implementation
-		enum Trigger {
-			Released = 0,
-			Pressed = 1,
-		};
-		// Must match GLFW implementation
-		enum Key {
-			KB_0 = 48,
-			KB_1 = 49,
-			KB_2 = 50,
-			KB_3 = 51,
-			KB_4 = 52,
-			KB_5 = 53,
-			KB_6 = 54,
-			KB_7 = 55,
-			KB_8 = 56,
-			KB_9 = 57,
-			A = 65,
-			B = 66,
-			C = 67,
-			D = 68,
-			E = 69,
-			F = 70,
-			G = 71,
-			H = 72,
-			I = 73,
-			J = 74,
-			K = 75,
-			L = 76,
-			M = 77,
-			N = 78,
-			O = 79,
-			P = 80,
-			Q = 81,
-			R = 82,
-			S = 83,
-			T = 84,
-			U = 85,
-			V = 86,
-			W = 87,
-			X = 88,
-			Y = 89,
-			Z = 90,
-			Space = 32,
-			Escape = 256,
-			Enter = 257,
-			Tab = 258,
-			Backspace = 259,
-			ArrowRight = 262,
-			ArrowLeft = 263,
-			ArrowDown = 264,
-			ArrowUp = 265,
-			LeftShift = 340,
-			LeftControl = 341
-		};
-		// Must match GLFW implementation
-		enum Mouse {
-			MB_1 = 0,
-			MB_2 = 1,
-			MB_3 = 2,
-			MB_4 = 3,
-			MB_5 = 4,
-			MB_6 = 5,
-			MB_7 = 6,
-			MB_8 = 7,
-		};
-
-		bool KeyState(Key key, Trigger trigger);
-
-		bool MouseButtonState(Mouse button, Trigger trigger);
-	}
-
-}
\ No newline at end of file
+#pragma once
+#include <string>
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <functional>
+
+// Levels of CHARIS_CHECK_LEVEL, which decides which CHARIS_ASSERT checks are compiled in and how much GL debug output is reported.
+// Off: no checks. Cheap (default): argument checks, and GL debug messages of medium and high severity.
+// Paranoid: also checks that walk whole buffers, the GL state shadow against glGet*, and low severity GL debug messages from a synchronous debug context.
+#define CHARIS_CHECK_OFF 0
+#define CHARIS_CHECK_CHEAP 1
+#define CHARIS_CHECK_PARANOID 2
+#ifndef CHARIS_CHECK_LEVEL
+#define CHARIS_CHECK_LEVEL CHARIS_CHECK_CHEAP
+#endif
+
+namespace Charis {
+
+	namespace Helper {
+
+		/// <summary>
+		/// Asserts that a condition is true at runtime and aborts the program if it is not. Always checked, whatever the CHARIS_CHECK_LEVEL.
+		/// Prefer CHARIS_ASSERT on hot paths, since the message is built before the condition is checked.
+		/// </summary>
+		/// <param name="condition">Condition that must be true for program to keep running.</param>
+		/// <param name="errorMessage">Error message that is printed if condition is false.</param>
+		void RuntimeAssert(bool condition, const std::string& errorMessage);
+
+		// Reports a failed CHARIS_ASSERT and aborts.
+		[[noreturn]] void AssertionFailed(const char* condition, const char* file, int line, const std::string& message);
+		// Streams the message arguments of a failed CHARIS_ASSERT into its message, which only happens once it has failed.
+		template<class... Arguments>
+		[[noreturn]] void AssertionFailed(const char* condition, const char* file, int line, const Arguments&... arguments)
+		{
+			std::ostringstream message;
+			(message << ... << arguments);
+			AssertionFailed(condition, file, line, message.str());
+		}
+
+	}
+
+	namespace Utility {
+
+		// Used for SetCursorBehavior function.
+		enum CursorBehavior {
+			// Normal and default behavior. Can move freely inside and outside of window.
+			Normal,
+			// Locks the cursor to the window.
+			Lock,
+			// Hides the cursor while inside the window.
+			Hide,
+			// Cursor is locked to window and invisible.
+			LockAndHide
+		};
+		// Sets how the cursor should be managed by the window.
+		void SetCursorBehavior(CursorBehavior behavior);
+
+		struct WindowDimensions { unsigned int Width; unsigned int Height; };
+		// Get window dimensions
+		WindowDimensions GetWindowDimensions();
+
+		// Closes the window.
+		void CloseWindow();
+
+		/// <summary>Sets the background color of the window.</summary>
+		/// <param name="RGB">RGB color values ranging from 0.0 to 1.0.</param>
+		void SetWindowBackground(const std::array<float, 3>& RGB);
+
+		/// <summary>
+		/// Sets how much GL work of background model loading StartFrame may do per frame, see LoadModelAsync.
+		/// Uploads stop for the frame when either budget is used up, but at least one upload is made per frame.
+		/// </summary>
+		/// <param name="bytesPerFrame">Bytes of textures and vertices to upload per frame.</param>
+		/// <param name="millisecondsPerFrame">Time to spend on uploads per frame.</param>
+		void SetUploadBudget(unsigned int bytesPerFrame, float millisecondsPerFrame);
+
+		/// <summary>
+		/// Sets whether triangles facing away from the camera are dropped by the GPU, with counter-clockwise triangles facing the camera.
+		/// Off by default. Needed for Shader::DrawMeshlets to drop back facing meshlets without changing the image.
+		/// </summary>
+		void SetBackFaceCulling(bool enabled);
+
+		/// <summary>Sets how Component::SelectLevel picks levels of detail.</summary>
+		/// <param name="pixelError">Largest error of a level, in pixels on screen. Larger values pick coarser levels sooner.</param>
+		/// <param name="hysteresis">Fraction of the pixel error that a coarser level must stay below before it replaces a finer one, in [0, 1).</param>
+		void SetLevelOfDetailSelection(float pixelError = 1.0f, float hysteresis = 0.25f);
+
+		/// <summary>
+		/// Sets the directory where linked shader programs are cached, by default "CharisProgramCache" in the working directory.
+		/// It is created when the first program is cached. An empty path turns the cache off. See Shader::GetBuildTimes for what the cache saves.
+		/// </summary>
+		void SetProgramCacheDirectory(const std::string& directory);
+
+		/// <summary>
+		/// Counts of the GL work Charis submitted during a frame, from the end of the previous frame to EndFrame.
+		/// GL calls are the state changes, uniform updates, draws and uploads that reach the driver, state changes skipped by Charis are not counted.
+		/// </summary>
+		struct FrameStatistics {
+			unsigned int DrawCalls{};
+			unsigned int GLCalls{};
+			size_t UploadBytes{};
+			// Triangles of every draw call, counting every instance
+			size_t TrianglesDrawn{};
+			// Program, vertex array and texture bindings that changed
+			unsigned int Binds{};
+			// Boxes tested by FrustumCuller::Cull
+			unsigned int ObjectsVisible{};
+			unsigned int ObjectsCulled{};
+			// Triangles drawn by Shader::Draw with a level of detail, and how many more the full components would have drawn
+			unsigned int LodTrianglesDrawn{};
+			unsigned int LodTrianglesSaved{};
+			// Meshlets tested by CullMeshlets, and the triangles of the culled ones
+			unsigned int MeshletsVisible{};
+			unsigned int MeshletsCulled{};
+			unsigned int MeshletTrianglesCulled{};
+			// Occluder triangles rasterized by OcclusionCuller::Rasterize and the time it took, and boxes its tests found hidden
+			unsigned int OccluderTriangles{};
+			float OcclusionMilliseconds{};
+			unsigned int ObjectsOccluded{};
+			// Time EndFrame waited on the fence of an earlier frame for the GPU to catch up, see SetFramePacing
+			float GpuWaitMilliseconds{};
+			// Time spent presenting, which includes waiting for the vertical blank, and sleeping down to the target frame rate
+			float CpuWaitMilliseconds{};
+		};
+		// Returns the counts of the last finished frame.
+		FrameStatistics GetFrameStatistics();
+
+		/// <summary>Returns the time in seconds since initialization.</summary>
+		float GetTime();
+
+		enum class DiagnosticSeverity {
+			Notification,
+			Warning,
+			Error
+		};
+		using DiagnosticHandler = std::function<void(DiagnosticSeverity severity, const std::string& message)>;
+		/// <summary>
+		/// Sets where Charis reports GL debug messages, shader compile and link errors, and failed assertions, which are printed to std::cerr by default.
+		/// Failed assertions still abort after the handler returns. Errors of models loaded in the background are reported from the loading threads. 
+		/// An empty handler restores the default.
+		/// </summary>
+		void SetDiagnosticHandler(DiagnosticHandler handler);
+	}
+
+	namespace Input {
+
+		struct Position {
+			float X{};
+			float Y{};
+		};
+		// Gets the X and Y coordinates of the cursor.
+		Position CursorPosition();
+		// Gets the position of the mouse wheel.
+		float MouseWheel();
+
+		// Must match GLFW implementation
+		enum Trigger {
+			Released = 0,
+			Pressed = 1,
+		};
+		// Must match GLFW implementation
+		enum Key {
+			KB_0 = 48,
+			KB_1 = 49,
+			KB_2 = 50,
+			KB_3 = 51,
+			KB_4 = 52,
+			KB_5 = 53,
+			KB_6 = 54,
+			KB_7 = 55,
+			KB_8 = 56,
+			KB_9 = 57,
+			A = 65,
+			B = 66,
+			C = 67,
+			D = 68,
+			E = 69,
+			F = 70,
+			G = 71,
+			H = 72,
+			I = 73,
+			J = 74,
+			K = 75,
+			L = 76,
+			M = 77,
+			N = 78,
+			O = 79,
+			P = 80,
+			Q = 81,
+			R = 82,
+			S = 83,
+			T = 84,
+			U = 85,
+			V = 86,
+			W = 87,
+			X = 88,
+			Y = 89,
+			Z = 90,
+			Space = 32,
+			Escape = 256,
+			Enter = 257,
+			Tab = 258,
+			Backspace = 259,
+			ArrowRight = 262,
+			ArrowLeft = 263,
+			ArrowDown = 264,
+			ArrowUp = 265,
+			LeftShift = 340,
+			LeftControl = 341
+		};
+		// Must match GLFW implementation
+		enum Mouse {
+			MB_1 = 0,
+			MB_2 = 1,
+			MB_3 = 2,
+			MB_4 = 3,
+			MB_5 = 4,
+			MB_6 = 5,
+			MB_7 = 6,
+			MB_8 = 7,
+		};
+
+		bool KeyState(Key key, Trigger trigger);
+
+		bool MouseButtonState(Mouse button, Trigger trigger);
+	}
+
+}
+
+#if CHARIS_CHECK_LEVEL >= CHARIS_CHECK_CHEAP
+// Aborts with the message if the condition is false. The message arguments are streamed into the message only when the condition fails,
+// so they cost nothing on success: CHARIS_ASSERT(index < size, "No box at index ", index, ".");
+#define CHARIS_ASSERT(condition, ...) do { if (!(condition)) ::Charis::Helper::AssertionFailed(#condition, __FILE__, __LINE__, __VA_ARGS__); } while (false)
+#else
+#define CHARIS_ASSERT(condition, ...) do { (void)sizeof(!(condition)); } while (false)
+#endif
+#if CHARIS_CHECK_LEVEL >= CHARIS_CHECK_PARANOID
+// As CHARIS_ASSERT, for checks too expensive for the cheap level.
+#define CHARIS_ASSERT_PARANOID(condition, ...) CHARIS_ASSERT(condition, __VA_ARGS__)
+#else
+#define CHARIS_ASSERT_PARANOID(condition, ...) do { (void)sizeof(!(condition)); } while (false)
+#endif
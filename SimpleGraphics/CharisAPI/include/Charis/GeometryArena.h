@@ -0,0 +1,83 @@
+#pragma once
+#include "Component.h"
+#include <vector>
+#include <map>
+
+namespace Charis {
+
+	/// <summary>
+	/// Shared vertex and index buffers for many components with the same vertex attribute layout.
+	/// Components created in an arena share one vertex array, which lets the shader draw a whole list of them
+	/// (for example every component of a model) with one multi-draw call instead of one draw call per component.
+	/// </summary>
+	class GeometryArena
+	{
+	public:
+		/// <summary>Constructor for a GeometryArena.</summary>
+		/// <param name="floatsPerAttributePerVertex">Vertex attribute layout of every component in the arena, see Component.
+		/// Use Model::FloatsPerFileAttribute for arenas that models are loaded into.</param>
+		/// <param name="initialVertexCapacity">Number of vertices the arena has room for before it has to grow.</param>
+		/// <param name="initialIndexCapacity">Number of indices the arena has room for before it has to grow.</param>
+		GeometryArena(const std::vector<unsigned int>& floatsPerAttributePerVertex, unsigned int initialVertexCapacity = 1 << 16, unsigned int initialIndexCapacity = 1 << 18);
+
+		/// <summary>
+		/// Creates a component whose vertices and indices live in this arena.
+		/// The space is given back to the arena by the EndFrame after the last copy of the component is destroyed.
+		/// </summary>
+		/// <param name="vertexAttributes">Pointer to an array that contains all vertices and vertex attributes, in the layout of the arena.</param>
+		/// <param name="numberOfVertexAttributes">Number of vertex attributes (floats) in the array.</param>
+		/// <param name="indices">Pointer to an array containing indices to vertices, where every three indices make up a triangle.</param>
+		/// <param name="numberOfIndices">Number of indices in the array.</param>
+		Component CreateComponent(const float* vertexAttributes, unsigned int numberOfVertexAttributes, const unsigned int* indices, unsigned int numberOfIndices);
+
+		/// <summary>
+		/// Moves all components to the front of the arena buffers so freed space becomes one block again.
+		/// This happens automatically when an allocation does not fit in any free block, but can be called at a convenient time, like a level change.
+		/// </summary>
+		void Compact();
+
+		struct Usage {
+			unsigned int VertexCapacity{};
+			unsigned int VerticesUsed{};
+			unsigned int IndexCapacity{};
+			unsigned int IndicesUsed{};
+			// Number of free blocks in the vertex and index buffers. More than one each means the arena is fragmented.
+			unsigned int FreeBlocks{};
+		};
+		/// <summary>Returns how much of the arena is in use.</summary>
+		Usage CurrentUsage() const;
+
+		friend class Component;
+		friend class Model;
+		friend class AsyncModel;
+	private:
+		static void Release(Component::ModelComponentMember& component);
+
+		Resource<GeometryArenaMember> m = Resource<GeometryArenaMember>::Make();
+	};
+
+	// Shared by the arena and all of its components, which keeps the buffers alive until the last of them is gone.
+	// The buffers are then deleted at the next frame boundary, see ResourceRegistry::Pool.
+	struct GeometryArenaMember {
+		unsigned int VAO{};
+		unsigned int VBO{};
+		unsigned int IBO{};
+		// Draw commands of the current multi-draw, see Shader::Draw.
+		unsigned int IndirectBuffer{};
+
+		std::vector<unsigned int> FloatsPerAttributePerVertex;
+		unsigned int FloatsPerVertex{};
+		unsigned int VertexCapacity{};
+		unsigned int IndexCapacity{};
+
+		// Free blocks of the vertex and index buffers, as offset to size.
+		std::map<unsigned int, unsigned int> FreeVertices;
+		std::map<unsigned int, unsigned int> FreeIndices;
+		// Every component living in the arena, so compaction can update their offsets.
+		std::vector<Component::ModelComponentMember*> Residents;
+
+		// Deletes the vertex array and buffers, see ResourceRegistry::Pool.
+		void DeleteObjects();
+	};
+
+}
\ No newline at end of file
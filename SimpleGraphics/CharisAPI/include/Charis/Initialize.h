@@ -1,26 +1,88 @@
-#pragma once
-#include <string>
-
-namespace Charis {
-
-	/// <summary>
-	/// Performs all background work necessary to start using Charis. Don't forget to call the CleanUp function before closing the program.
-	/// </summary>
-	/// <param name="width">Width of window in pixels.</param>
-	/// <param name="height">Height of window in pixels.</param>
-	/// <param name="name">Name of the application and window header.</param>
-	void Initialize(unsigned int width = 800, unsigned int height = 600, const std::string& name = "Charis Engine Application");
-
-	/// <summary>Performs necessary background work for frame to start. Do not forget to also end the frame. </summary>
-	void StartFrame();
-
-	/// <summary>Ends the frame. </summary>
-	void EndFrame();
-
-	/// <summary>Checks if the window should be open or is closed. Use this as the condition for the while loop of the engine.</summary>
-	/// <returns>True if the window should be open.</returns>
-	bool WindowIsOpen();
-
-	/// <summary>Clears up background processes. Call this function before exiting program.</summary>
-	void CleanUp();
+#pragma once
+#include <string>
+#include <functional>
+#include "Camera.h"
+#include "FrameConstants.h"
+
+namespace Charis {
+
+	enum ContextMode {
+		// A visible window with a native OpenGL context.
+		Windowed,
+		// No window or display. An offscreen EGL context (EGL_MESA_platform_surfaceless), rendering into a framebuffer object of the requested size.
+		HeadlessEGL,
+		// No window or display. An offscreen OSMesa context, rendering into a framebuffer object of the requested size.
+		HeadlessOSMesa
+	};
+
+	/// <summary>
+	/// Performs all background work necessary to start using Charis. Don't forget to call the CleanUp function before closing the program.
+	/// Headless modes need a GLFW built with the null platform and a Mesa driver, which uses llvmpipe on machines without a GPU. 
+	/// They only require OpenGL 3.3 and keep the frame functions working as usual, while the window stays open until Utility::CloseWindow.
+	/// </summary>
+	/// <param name="width">Width of window, or offscreen frame, in pixels.</param>
+	/// <param name="height">Height of window, or offscreen frame, in pixels.</param>
+	/// <param name="name">Name of the application and window header.</param>
+	/// <param name="mode">Type of context to create.</param>
+	void Initialize(unsigned int width = 800, unsigned int height = 600, const std::string& name = "Charis Engine Application", ContextMode mode = Windowed);
+
+	/// <summary>Performs necessary background work for frame to start. Do not forget to also end the frame. </summary>
+	void StartFrame();
+	/// <summary>Starts the frame like StartFrame, and fills the FrameConstants uniform block from the camera and lights.</summary>
+	/// <param name="camera">Camera to view the frame from.</param>
+	/// <param name="lights">Lights of the frame.</param>
+	void StartFrame(const Camera& camera, const FrameLights& lights = {});
+	/// <summary>Starts the frame like StartFrame, and fills the FrameConstants uniform block from the view and lights.</summary>
+	/// <param name="view">View and projection matrices, and camera position, of the frame.</param>
+	/// <param name="lights">Lights of the frame.</param>
+	void StartFrame(const FrameView& view, const FrameLights& lights = {});
+
+	/// <summary>Ends the frame. Presents it, and paces the next frame as set with SetFramePacing.</summary>
+	void EndFrame();
+
+	enum class PresentMode {
+		// Presents as soon as the frame is done, which may tear.
+		Immediate,
+		// Waits for the vertical blank of the display before presenting.
+		VSync,
+		// Waits for the vertical blank unless the frame missed it, then presents right away instead of waiting for the next one.
+		// Falls back to VSync where the driver does not support late swaps (EXT_swap_control_tear).
+		AdaptiveSync
+	};
+	/// <summary>How EndFrame paces frames, see SetFramePacing.</summary>
+	struct FramePacing {
+		PresentMode Mode = PresentMode::Immediate;
+		/// <summary>
+		/// Frames the CPU may be ahead of the GPU, 1 to 4. More hides stalls of either, fewer shortens the time from input to display.
+		/// EndFrame waits on a fence of the frame this many frames back, so the buffers Charis writes every frame are never written while the GPU reads them.
+		/// </summary>
+		unsigned int FramesInFlight = 2;
+		// Frame rate to sleep down to, 0 for no limit. Works with every mode, also on top of VSync for a rate below the refresh rate.
+		float TargetFPS = 0.0f;
+		/// <summary>
+		/// Sleeps for the target frame rate and polls input at the start of the next frame instead of the end of this one,
+		/// so the input a frame is built from is as recent as possible.
+		/// </summary>
+		bool LateInputSampling = false;
+	};
+	/// <summary>
+	/// Sets how frames are presented and paced. Waits for the GPU to finish all frames in flight. Utility::GetFrameStatistics reports the time 
+	/// every frame waited for the GPU and for presentation and the target frame rate. Headless contexts only use the frames in flight and target frame rate.
+	/// </summary>
+	void SetFramePacing(const FramePacing& pacing);
+
+	/// <summary>
+	/// Receives every finished frame in EndFrame, as tightly packed RGBA8 rows ordered bottom to top. 
+	/// The pixels are only valid during the call. Reading back stalls until the GPU has finished the frame.
+	/// </summary>
+	using FrameReadback = std::function<void(const unsigned char* pixels, unsigned int width, unsigned int height)>;
+	/// <summary>Sets the function that receives every finished frame, works with all context modes. An empty function turns readback off.</summary>
+	void SetFrameReadback(FrameReadback readback);
+
+	/// <summary>Checks if the window should be open or is closed. Use this as the condition for the while loop of the engine.</summary>
+	/// <returns>True if the window should be open.</returns>
+	bool WindowIsOpen();
+
+	/// <summary>Clears up background processes. Call this function before exiting program.</summary>
+	void CleanUp();
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "Shader.h"
+#include "Component.h"
+#include "Model.h"
+#include <vector>
+#include <cstdint>
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace Charis {
+
+	/// <summary>
+	/// Collects draws during a frame and submits them at the end of the frame sorted by shader, component, textures and depth, 
+	/// so that draws sharing state are submitted together and redundant binds are skipped.
+	/// Shaders and components submitted to the queue must stay alive until the queue has ended the frame.
+	/// </summary>
+	class RenderQueue
+	{
+	public:
+		/// <summary>Counters of the work done by the last EndFrame.</summary>
+		struct Statistics {
+			unsigned int Draws{};
+			unsigned int ProgramSwitches{};
+			unsigned int VertexArraySwitches{};
+			unsigned int TextureBinds{};
+		};
+
+		/// <summary>Adds a draw of a model component to the queue.</summary>
+		/// <param name="shader">Shader to draw the component with.</param>
+		/// <param name="component">Component to draw.</param>
+		/// <param name="modelUniform">Uniform of the shader that receives the model matrix of this draw.</param>
+		/// <param name="modelMatrix">Model matrix of this draw.</param>
+		/// <param name="depth">Distance from the camera. Draws sharing shader, component and textures are submitted nearest first.</param>
+		void Submit(const Shader& shader, const Component& component, Shader::Uniform modelUniform, const glm::mat4& modelMatrix, float depth = 0.0f);
+		/// <summary>Adds a draw of every component of a model to the queue.</summary>
+		/// <param name="shader">Shader to draw the model with.</param>
+		/// <param name="model">Model to draw.</param>
+		/// <param name="modelUniform">Uniform of the shader that receives the model matrix of this draw.</param>
+		/// <param name="modelMatrix">Model matrix of this draw.</param>
+		/// <param name="depth">Distance from the camera. Draws sharing shader, component and textures are submitted nearest first.</param>
+		void Submit(const Shader& shader, const Model& model, Shader::Uniform modelUniform, const glm::mat4& modelMatrix, float depth = 0.0f);
+
+		/// <summary>Sorts and draws everything submitted since the last call, then empties the queue. Call it before Charis::EndFrame.</summary>
+		void EndFrame();
+
+		/// <summary>Returns the counters of the last EndFrame.</summary>
+		const Statistics& FrameStatistics() const { return m_Statistics; }
+
+	private:
+		struct Submission {
+			const Shader* ShaderToUse;
+			const Component* ComponentToDraw;
+			int ModelLocation;
+			glm::mat4 ModelMatrix;
+		};
+		std::vector<Submission> m_Submissions;
+		std::vector<uint64_t> m_Keys;
+		std::vector<uint32_t> m_Order;
+		std::vector<uint32_t> m_SortScratch;
+		Statistics m_Statistics{};
+	};
+
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include "Utility.h"
+#include <atomic>
+#include <array>
+#include <vector>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include <utility>
+
+namespace Charis {
+
+	/// <summary>
+	/// Names a slot of a resource pool in 32 bits: the index of the slot, and the generation the slot was in when the handle was made.
+	/// A slot moves on to the next generation when its resource is destroyed, which the paranoid checks use to catch a Resource reaching a slot
+	/// it no longer holds a reference on. 0 is the null handle.
+	/// </summary>
+	struct ResourceHandle {
+		static constexpr unsigned int IndexBits = 20;
+		static constexpr unsigned int GenerationBits = 32 - IndexBits;
+		static constexpr std::uint32_t MaxIndex = (1u << IndexBits) - 1;
+		static constexpr std::uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+
+		std::uint32_t Value{};
+
+		static ResourceHandle Make(std::uint32_t index, std::uint32_t generation) { return { (generation << IndexBits) | index }; }
+		std::uint32_t Index() const { return Value & MaxIndex; }
+		std::uint32_t Generation() const { return Value >> IndexBits; }
+		bool IsNull() const { return Value == 0; }
+		bool operator==(const ResourceHandle&) const = default;
+	};
+
+	namespace ResourceRegistry {
+
+		// Destroys the resource in a slot of a pool. The GL objects are only deleted if the context they were made in is still there.
+		using DestroyFunction = void (*)(std::uint32_t index, bool deleteObjects);
+		/// <summary>
+		/// Queues a released resource for destruction at the next frame boundary. Called by the pools, from any thread.
+		/// EndFrame and CleanUp destroy the queued resources on the thread of the GL context.
+		/// </summary>
+		void DeferDestruction(DestroyFunction destroy, std::uint32_t index);
+
+		/// <summary>
+		/// Pooled slots for the members of one resource type, found by handle. Slots live in chunks that never move, so finding one needs no lock,
+		/// and members may point at each other. Every slot counts the Resource handles referring to it, and the last to let go queues the
+		/// member for destruction. The member type deletes its GL objects in DeleteObjects.
+		/// A chunk is published before the handle of any slot in it exists, and a thread only has a handle once it is synchronized with
+		/// the thread that created it, so the chunk pointers are read relaxed.
+		/// </summary>
+		template<class Member>
+		class Pool {
+		public:
+			static constexpr std::uint32_t SlotsPerChunk = 1024;
+			static constexpr std::uint32_t MaxChunks = (ResourceHandle::MaxIndex + 1) / SlotsPerChunk;
+
+			static ResourceHandle Create()
+			{
+				std::lock_guard lock(Mutex);
+				auto index = std::uint32_t{};
+				if (!FreeSlots.empty()) {
+					index = FreeSlots.back();
+					FreeSlots.pop_back();
+				}
+				else {
+					// Index 0 is never handed out, so no handle to a live resource is null
+					index = ++Slots;
+					Helper::RuntimeAssert(index <= ResourceHandle::MaxIndex, "Too many resources of one type are alive at once.");
+					auto& chunk = Chunks[index / SlotsPerChunk];
+					if (chunk.load(std::memory_order_relaxed) == nullptr)
+						chunk.store(new Slot[SlotsPerChunk], std::memory_order_release);
+				}
+				auto& slot = SlotAt(index);
+				slot.Value.emplace();
+				slot.References.store(1, std::memory_order_relaxed);
+				return ResourceHandle::Make(index, slot.Generation.load(std::memory_order_relaxed));
+			}
+
+			// The handle holds a reference, which keeps the resource from being destroyed, so only the paranoid checks look at the generation.
+			static Member& Get(ResourceHandle handle)
+			{
+				auto& slot = SlotAt(handle.Index());
+				CHARIS_ASSERT_PARANOID(!handle.IsNull() && slot.Generation.load(std::memory_order_relaxed) == handle.Generation(), "Resource handle refers to a destroyed resource.");
+				return *slot.Value;
+			}
+
+			static void Retain(ResourceHandle handle)
+			{
+				if (!handle.IsNull())
+					SlotAt(handle.Index()).References.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			static void Release(ResourceHandle handle)
+			{
+				if (!handle.IsNull() && SlotAt(handle.Index()).References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					DeferDestruction(&Destroy, handle.Index());
+			}
+
+		private:
+			struct Slot {
+				std::optional<Member> Value;
+				std::atomic<std::uint32_t> References{};
+				// Only changed under the mutex, but read without it by Get
+				std::atomic<std::uint32_t> Generation = 1;
+			};
+
+			static Slot& SlotAt(std::uint32_t index)
+			{
+				return Chunks[index / SlotsPerChunk].load(std::memory_order_relaxed)[index % SlotsPerChunk];
+			}
+
+			static void Destroy(std::uint32_t index, bool deleteObjects)
+			{
+				auto& slot = SlotAt(index);
+				if (deleteObjects)
+					slot.Value->DeleteObjects();
+				slot.Value.reset();
+
+				std::lock_guard lock(Mutex);
+				const auto generation = slot.Generation.load(std::memory_order_relaxed);
+				slot.Generation.store(generation == ResourceHandle::MaxGeneration ? 1 : generation + 1, std::memory_order_relaxed);
+				FreeSlots.push_back(index);
+			}
+
+			// The chunks are never freed, resources released after the last CleanUp are never destroyed anyway
+			inline static std::array<std::atomic<Slot*>, MaxChunks> Chunks{};
+			inline static std::mutex Mutex;
+			inline static std::vector<std::uint32_t> FreeSlots;
+			inline static std::uint32_t Slots{};
+		};
+
+	}
+
+	/// <summary>
+	/// Shares the member of a resource like Component, Texture or Shader between its copies. It holds the 32 bit handle of the member,
+	/// copying it counts one more reference on the slot with an atomic increment, as copying a std::shared_ptr does.
+	/// The last copy to go queues the member for destruction at the next frame boundary, which makes destroying resources safe from any thread.
+	/// Reaching the member is one lookup of the slot, the reference it holds keeps the slot from being reused.
+	/// </summary>
+	template<class Member>
+	class Resource {
+	public:
+		Resource() = default;
+		Resource(const Resource& other) : m_Handle(other.m_Handle) { ResourceRegistry::Pool<Member>::Retain(m_Handle); }
+		Resource(Resource&& other) noexcept : m_Handle(std::exchange(other.m_Handle, ResourceHandle{})) {}
+		Resource& operator=(const Resource& other)
+		{
+			ResourceRegistry::Pool<Member>::Retain(other.m_Handle);
+			ResourceRegistry::Pool<Member>::Release(m_Handle);
+			m_Handle = other.m_Handle;
+			return *this;
+		}
+		Resource& operator=(Resource&& other) noexcept
+		{
+			if (this != &other) {
+				ResourceRegistry::Pool<Member>::Release(m_Handle);
+				m_Handle = std::exchange(other.m_Handle, ResourceHandle{});
+			}
+			return *this;
+		}
+		~Resource() { ResourceRegistry::Pool<Member>::Release(m_Handle); }
+
+		// Creates a member in a free slot.
+		static Resource Make()
+		{
+			auto resource = Resource{};
+			resource.m_Handle = ResourceRegistry::Pool<Member>::Create();
+			return resource;
+		}
+
+		explicit operator bool() const { return !m_Handle.IsNull(); }
+		bool operator==(const Resource& other) const { return m_Handle == other.m_Handle; }
+		Member* operator->() const { return &ResourceRegistry::Pool<Member>::Get(m_Handle); }
+		Member& operator*() const { return ResourceRegistry::Pool<Member>::Get(m_Handle); }
+
+	private:
+		ResourceHandle m_Handle;
+	};
+
+}
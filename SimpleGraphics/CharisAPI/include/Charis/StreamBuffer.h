@@ -0,0 +1,105 @@
+#pragma once
+#include "Resource.h"
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace Charis {
+
+	struct StreamBufferMember;
+
+	/// <summary>
+	/// A buffer for data the CPU writes anew every frame, like animated vertices or per frame uniforms. Allocations are handed out one after the other
+	/// and all of them are given back at once by the next EndFrame, so allocating costs no more than moving an offset.
+	/// Every frame in flight (see SetFramePacing) has its own part of the buffer, which the CPU only writes again once EndFrame has waited for the GPU
+	/// to finish the frame that used it last. With OpenGL 4.4 the buffer stays mapped for its whole life and allocations are written straight into it.
+	/// </summary>
+	class StreamBuffer
+	{
+	public:
+		enum Method {
+			// Immutable storage mapped once, persistent and coherent. Needs OpenGL 4.4 or ARB_buffer_storage, otherwise Orphaning is used.
+			PersistentMapping,
+			// Allocations are written to memory of the CPU, and copied with glBufferSubData into storage that is orphaned with glBufferData every frame.
+			Orphaning
+		};
+
+		/// <summary>
+		/// A range of the buffer, valid until the end of the frame it was allocated in. Only one handle owns it, so it can be moved but not copied.
+		/// The GPU sees what was written once the allocation is finished, so finish it (or let it go out of scope) before drawing with it.
+		/// </summary>
+		class Allocation
+		{
+		public:
+			Allocation() = default;
+			Allocation(Allocation&& other) noexcept;
+			Allocation& operator=(Allocation&& other) noexcept;
+			Allocation(const Allocation&) = delete;
+			Allocation& operator=(const Allocation&) = delete;
+			~Allocation();
+
+			/// <summary>Returns the memory to write to. Reading from it may be slow, since it can be memory the GPU reads from.</summary>
+			void* Data() const { return m_Data; }
+			size_t Size() const { return m_Size; }
+			/// <summary>Returns the memory as elements of a type. The allocation must have the alignment of the type.</summary>
+			template<class T>
+			std::span<T> As() const { return { static_cast<T*>(m_Data), m_Size / sizeof(T) }; }
+
+			/// <summary>Makes what was written visible to the GPU. Writing afterwards is not allowed.</summary>
+			void Finish();
+			/// <summary>Binds the allocation to a uniform block binding point, which shaders select with layout(std140, binding = n). Finishes it first.</summary>
+			void BindUniformBlock(unsigned int bindingPoint);
+
+			friend class StreamBuffer;
+			friend class DynamicComponent;
+		private:
+			// Set until the allocation is finished
+			StreamBufferMember* m_Owner = nullptr;
+			void* m_Data = nullptr;
+			unsigned int m_Buffer{};
+			size_t m_Offset{};
+			size_t m_Size{};
+		};
+
+		/// <summary>Constructor for a StreamBuffer.</summary>
+		/// <param name="bytesPerFrame">Bytes that can be allocated every frame. The buffer is as large as this times the largest number of frames in flight.</param>
+		/// <param name="method">How the data reaches the GPU.</param>
+		StreamBuffer(size_t bytesPerFrame, Method method = PersistentMapping);
+
+		/// <summary>Allocates a range for this frame. Fails if the frame has allocated more than the bytes per frame.</summary>
+		/// <param name="bytes">Size of the range.</param>
+		/// <param name="alignment">The offset of the range into the buffer is a multiple of this, which does not need to be a power of two.</param>
+		Allocation Allocate(size_t bytes, size_t alignment = 16);
+		/// <summary>Allocates a range that can be bound as a uniform block, aligned as GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT requires.</summary>
+		Allocation AllocateUniform(size_t bytes);
+
+		size_t BytesPerFrame() const;
+		/// <summary>Returns the bytes allocated this frame, including the padding for alignment.</summary>
+		size_t BytesUsed() const;
+		/// <summary>Returns the method in use, which is Orphaning if PersistentMapping was asked for without driver support.</summary>
+		Method UsedMethod() const;
+
+		friend class DynamicComponent;
+	private:
+		Resource<StreamBufferMember> m = Resource<StreamBufferMember>::Make();
+	};
+
+	// Shared by the stream buffer and the components drawing from it, which keeps the buffer alive until the last of them is gone.
+	// The buffer is then deleted at the next frame boundary, see ResourceRegistry::Pool.
+	struct StreamBufferMember {
+		unsigned int Buffer{};
+		StreamBuffer::Method Method = StreamBuffer::PersistentMapping;
+		size_t BytesPerFrame{};
+		// Whole buffer as mapped for PersistentMapping, and the copy of the current frame for Orphaning
+		unsigned char* Mapped{};
+		std::vector<unsigned char> Staging;
+
+		// Frame the allocations of Used were made in, see PrivateGlobal::FrameSync::Frame
+		std::uint64_t Frame{};
+		size_t Used{};
+
+		// Deletes the buffer, see ResourceRegistry::Pool.
+		void DeleteObjects();
+	};
+
+}
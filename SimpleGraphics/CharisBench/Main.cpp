@@ -0,0 +1,196 @@
+#include "Scenes.h"
+#include "Report.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Profiler.h"
+
+namespace {
+
+    struct Options {
+        BenchSettings Settings;
+        Charis::ContextMode Context = Charis::HeadlessEGL;
+        std::string ContextName = "egl";
+        unsigned int Width = 1280;
+        unsigned int Height = 720;
+        unsigned int WarmupFrames = 30;
+        unsigned int Frames = 300;
+        bool Synchronized = false;
+        unsigned int FramesInFlight = 2;
+        std::vector<std::string> Scenes;
+        std::string Output;
+        std::string Trace;
+    };
+
+    void PrintUsage() {
+        std::cerr << "Usage: CharisBench [options]\n"
+            << "  --context egl|osmesa|window  Context to render with (default egl)\n"
+            << "  --size <width>x<height>      Frame size (default 1280x720)\n"
+            << "  --frames <n>                 Measured frames per scene (default 300)\n"
+            << "  --warmup <n>                 Frames per scene before measuring (default 30)\n"
+            << "  --scene <name>               Scene to run, may be repeated (default all)\n"
+            << "  --sync                       Read every frame back, so frame times include the GPU\n"
+            << "  --frames-in-flight <n>       Frames the CPU may run ahead of the GPU, 1 to 4 (default 2)\n"
+            << "  --assets <directory>         Directory with the TestProject Models and Shaders (default ../TestProject)\n"
+            << "  --backpacks <n> --components <n> --uniform-draws <n> --materials <n> --field <n>  Scene sizes\n"
+            << "  --out <file>                 Write the JSON report to a file instead of stdout\n"
+            << "  --trace <file>               Write a Chrome trace of the measured frames, with zones if Charis is built with CHARIS_PROFILE\n"
+            << "Scenes:\n";
+        for (const auto& scene : Scenes())
+            std::cerr << "  " << scene.Name << ": " << scene.Description << "\n";
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string option = argv[i];
+            if (option == "--sync") {
+                options.Synchronized = true;
+                continue;
+            }
+            if (i + 1 >= argc)
+                return false;
+
+            const std::string value = argv[++i];
+            if (option == "--context") {
+                if (value == "egl") options.Context = Charis::HeadlessEGL;
+                else if (value == "osmesa") options.Context = Charis::HeadlessOSMesa;
+                else if (value == "window") options.Context = Charis::Windowed;
+                else return false;
+                options.ContextName = value;
+            }
+            else if (option == "--size") {
+                const auto x = value.find('x');
+                if (x == std::string::npos)
+                    return false;
+                options.Width = std::stoul(value.substr(0, x));
+                options.Height = std::stoul(value.substr(x + 1));
+            }
+            else if (option == "--frames") options.Frames = std::stoul(value);
+            else if (option == "--warmup") options.WarmupFrames = std::stoul(value);
+            else if (option == "--frames-in-flight") options.FramesInFlight = std::stoul(value);
+            else if (option == "--scene") options.Scenes.push_back(value);
+            else if (option == "--assets") options.Settings.AssetDirectory = value;
+            else if (option == "--backpacks") options.Settings.Backpacks = std::stoul(value);
+            else if (option == "--components") options.Settings.SmallComponents = std::stoul(value);
+            else if (option == "--uniform-draws") options.Settings.UniformDraws = std::stoul(value);
+            else if (option == "--materials") options.Settings.Materials = std::stoul(value);
+            else if (option == "--field") options.Settings.FieldBackpacks = std::stoul(value);
+            else if (option == "--out") options.Output = value;
+            else if (option == "--trace") options.Trace = value;
+            else return false;
+        }
+        return options.Frames > 0 && options.FramesInFlight >= 1 && options.FramesInFlight <= 4;
+    }
+
+    double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    SceneResult RunScene(const Scene& scene, const Options& options) {
+        auto result = SceneResult{};
+        result.Name = scene.Name;
+
+        const auto setupStart = std::chrono::steady_clock::now();
+        auto drawFrame = scene.Create(options.Settings);
+        result.SetupMilliseconds = MillisecondsSince(setupStart);
+
+        const auto totalFrames = options.WarmupFrames + options.Frames;
+        for (unsigned int frame = 0; frame < totalFrames; frame++) {
+            if (!options.Trace.empty())
+                Charis::Profiler::SetEnabled(frame >= options.WarmupFrames);
+            const auto frameStart = std::chrono::steady_clock::now();
+            Charis::StartFrame(BenchView(), BenchLights());
+            drawFrame(frame);
+            Charis::EndFrame();
+            const auto milliseconds = MillisecondsSince(frameStart);
+            const auto statistics = Charis::Utility::GetFrameStatistics();
+
+            if (frame == 0) {
+                result.FirstFrameMilliseconds = milliseconds;
+                result.FirstFrameUploadBytes = statistics.UploadBytes;
+            }
+            if (frame < options.WarmupFrames)
+                continue;
+            result.FrameMilliseconds.push_back(milliseconds);
+            result.DrawCalls.push_back(statistics.DrawCalls);
+            result.GLCalls.push_back(statistics.GLCalls);
+            result.UploadBytes.push_back(statistics.UploadBytes);
+            result.TrianglesDrawn.push_back(statistics.TrianglesDrawn);
+            result.Binds.push_back(statistics.Binds);
+            result.ObjectsVisible.push_back(statistics.ObjectsVisible);
+            result.ObjectsCulled.push_back(statistics.ObjectsCulled);
+            result.LodTrianglesDrawn.push_back(statistics.LodTrianglesDrawn);
+            result.LodTrianglesSaved.push_back(statistics.LodTrianglesSaved);
+            result.MeshletsVisible.push_back(statistics.MeshletsVisible);
+            result.MeshletsCulled.push_back(statistics.MeshletsCulled);
+            result.MeshletTrianglesCulled.push_back(statistics.MeshletTrianglesCulled);
+            result.ObjectsOccluded.push_back(statistics.ObjectsOccluded);
+            result.OcclusionMilliseconds.push_back(statistics.OcclusionMilliseconds);
+            result.CpuWaitMilliseconds.push_back(statistics.CpuWaitMilliseconds);
+            result.GpuWaitMilliseconds.push_back(statistics.GpuWaitMilliseconds);
+        }
+        return result;
+    }
+
+}
+
+// Runs scripted scenes for a fixed number of frames and reports frame times and GL work as JSON.
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    for (const auto& name : options.Scenes) {
+        if (std::none_of(Scenes().begin(), Scenes().end(), [&](const Scene& scene) { return scene.Name == name; })) {
+            std::cerr << "Unknown scene: " << name << "\n";
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    Charis::Initialize(options.Width, options.Height, "CharisBench", options.Context);
+    Charis::Utility::SetWindowBackground({ 0.1f, 0.1f, 0.1f });
+    // Presenting right away keeps the frame times about the work of the scenes, not the refresh rate of a window
+    auto pacing = Charis::FramePacing{};
+    pacing.FramesInFlight = options.FramesInFlight;
+    Charis::SetFramePacing(pacing);
+    // Reading the frame back waits for the GPU, the pixels themselves are not needed
+    if (options.Synchronized)
+        Charis::SetFrameReadback([](const unsigned char*, unsigned int, unsigned int) {});
+
+    auto report = BenchReport{};
+    report.Context = options.ContextName;
+    report.Width = options.Width;
+    report.Height = options.Height;
+    report.WarmupFrames = options.WarmupFrames;
+    report.MeasuredFrames = options.Frames;
+    report.Synchronized = options.Synchronized;
+    report.FramesInFlight = options.FramesInFlight;
+    for (const auto& scene : Scenes()) {
+        if (!options.Scenes.empty() && std::find(options.Scenes.begin(), options.Scenes.end(), scene.Name) == options.Scenes.end())
+            continue;
+        std::cerr << "Running " << scene.Name << "..." << std::endl;
+        report.Scenes.push_back(RunScene(scene, options));
+    }
+
+    if (!options.Trace.empty() && !Charis::Profiler::ExportChromeTrace(options.Trace))
+        std::cerr << "Could not write the trace to " << options.Trace << "\n";
+    Charis::CleanUp();
+
+    if (options.Output.empty()) {
+        WriteJson(std::cout, report);
+    }
+    else {
+        std::ofstream file(options.Output);
+        WriteJson(file, report);
+    }
+    return 0;
+}
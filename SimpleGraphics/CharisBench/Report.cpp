@@ -0,0 +1,116 @@
+#include "Report.h"
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+#include <cmath>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+    // Nearest rank percentile of sorted values.
+    double Percentile(const std::vector<double>& sorted, double percent) {
+        if (sorted.empty())
+            return 0.0;
+        const auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    template<class T>
+    double Mean(const std::vector<T>& values) {
+        if (values.empty())
+            return 0.0;
+        return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    }
+
+    std::string Quoted(const std::string& text) {
+        std::string quoted = "\"";
+        for (const char c : text) {
+            if (c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    void WriteScene(std::ostream& stream, const SceneResult& scene) {
+        auto sorted = scene.FrameMilliseconds;
+        std::sort(sorted.begin(), sorted.end());
+
+        stream << "    {\n";
+        stream << "      \"name\": " << Quoted(scene.Name) << ",\n";
+        stream << "      \"setup_ms\": " << scene.SetupMilliseconds << ",\n";
+        stream << "      \"first_frame_ms\": " << scene.FirstFrameMilliseconds << ",\n";
+        stream << "      \"first_frame_upload_bytes\": " << scene.FirstFrameUploadBytes << ",\n";
+        stream << "      \"frame_ms\": {\n";
+        stream << "        \"mean\": " << Mean(scene.FrameMilliseconds) << ",\n";
+        stream << "        \"p50\": " << Percentile(sorted, 50.0) << ",\n";
+        stream << "        \"p95\": " << Percentile(sorted, 95.0) << ",\n";
+        stream << "        \"p99\": " << Percentile(sorted, 99.0) << ",\n";
+        stream << "        \"max\": " << (sorted.empty() ? 0.0 : sorted.back()) << "\n";
+        stream << "      },\n";
+        stream << "      \"draw_calls_per_frame\": " << Mean(scene.DrawCalls) << ",\n";
+        stream << "      \"gl_calls_per_frame\": " << Mean(scene.GLCalls) << ",\n";
+        stream << "      \"upload_bytes_per_frame\": " << Mean(scene.UploadBytes) << ",\n";
+        stream << "      \"triangles_per_frame\": " << Mean(scene.TrianglesDrawn) << ",\n";
+        stream << "      \"binds_per_frame\": " << Mean(scene.Binds) << ",\n";
+        stream << "      \"objects_visible_per_frame\": " << Mean(scene.ObjectsVisible) << ",\n";
+        stream << "      \"objects_culled_per_frame\": " << Mean(scene.ObjectsCulled) << ",\n";
+        stream << "      \"lod_triangles_drawn_per_frame\": " << Mean(scene.LodTrianglesDrawn) << ",\n";
+        stream << "      \"lod_triangles_saved_per_frame\": " << Mean(scene.LodTrianglesSaved) << ",\n";
+        stream << "      \"meshlets_visible_per_frame\": " << Mean(scene.MeshletsVisible) << ",\n";
+        stream << "      \"meshlets_culled_per_frame\": " << Mean(scene.MeshletsCulled) << ",\n";
+        stream << "      \"meshlet_triangles_culled_per_frame\": " << Mean(scene.MeshletTrianglesCulled) << ",\n";
+        stream << "      \"objects_occluded_per_frame\": " << Mean(scene.ObjectsOccluded) << ",\n";
+        stream << "      \"occlusion_ms_per_frame\": " << Mean(scene.OcclusionMilliseconds) << ",\n";
+        stream << "      \"cpu_wait_ms_per_frame\": " << Mean(scene.CpuWaitMilliseconds) << ",\n";
+        stream << "      \"gpu_wait_ms_per_frame\": " << Mean(scene.GpuWaitMilliseconds) << "\n";
+        stream << "    }";
+    }
+
+}
+
+size_t PeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+void WriteJson(std::ostream& stream, const BenchReport& report) {
+    stream << std::fixed << std::setprecision(4);
+    stream << "{\n";
+    stream << "  \"context\": " << Quoted(report.Context) << ",\n";
+    stream << "  \"width\": " << report.Width << ",\n";
+    stream << "  \"height\": " << report.Height << ",\n";
+    stream << "  \"warmup_frames\": " << report.WarmupFrames << ",\n";
+    stream << "  \"measured_frames\": " << report.MeasuredFrames << ",\n";
+    stream << "  \"synchronized\": " << (report.Synchronized ? "true" : "false") << ",\n";
+    stream << "  \"frames_in_flight\": " << report.FramesInFlight << ",\n";
+    stream << "  \"peak_rss_bytes\": " << PeakResidentBytes() << ",\n";
+    stream << "  \"scenes\": [\n";
+    for (size_t i = 0; i < report.Scenes.size(); i++) {
+        WriteScene(stream, report.Scenes[i]);
+        stream << (i + 1 < report.Scenes.size() ? ",\n" : "\n");
+    }
+    stream << "  ]\n";
+    stream << "}" << std::endl;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ostream>
+
+// Measurements of one scene, one entry per measured frame.
+struct SceneResult {
+    std::string Name;
+    double SetupMilliseconds{};
+    // Counts of the first frame, which include the uploads made while setting the scene up
+    double FirstFrameMilliseconds{};
+    size_t FirstFrameUploadBytes{};
+    std::vector<double> FrameMilliseconds;
+    std::vector<unsigned int> DrawCalls;
+    std::vector<unsigned int> GLCalls;
+    std::vector<size_t> UploadBytes;
+    std::vector<size_t> TrianglesDrawn;
+    std::vector<unsigned int> Binds;
+    std::vector<unsigned int> ObjectsVisible;
+    std::vector<unsigned int> ObjectsCulled;
+    std::vector<unsigned int> LodTrianglesDrawn;
+    std::vector<unsigned int> LodTrianglesSaved;
+    std::vector<unsigned int> MeshletsVisible;
+    std::vector<unsigned int> MeshletsCulled;
+    std::vector<unsigned int> MeshletTrianglesCulled;
+    std::vector<unsigned int> ObjectsOccluded;
+    std::vector<float> OcclusionMilliseconds;
+    std::vector<float> CpuWaitMilliseconds;
+    std::vector<float> GpuWaitMilliseconds;
+};
+
+struct BenchReport {
+    std::string Context;
+    unsigned int Width{};
+    unsigned int Height{};
+    unsigned int WarmupFrames{};
+    unsigned int MeasuredFrames{};
+    bool Synchronized{};
+    unsigned int FramesInFlight{};
+    std::vector<SceneResult> Scenes;
+};
+
+// Largest resident set of the process so far, in bytes. 0 if the platform does not report it.
+size_t PeakResidentBytes();
+
+// Writes the report as JSON, with frame time percentiles and per frame averages of the counters for every scene.
+void WriteJson(std::ostream& stream, const BenchReport& report);
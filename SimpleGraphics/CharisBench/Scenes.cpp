@@ -0,0 +1,457 @@
+#include "Scenes.h"
+#include <memory>
+#include <array>
+#include <cstdint>
+
+// Charis
+#include "Charis/Shader.h"
+#include "Charis/Model.h"
+#include "Charis/Component.h"
+#include "Charis/Texture.h"
+#include "Charis/Culling.h"
+#include "Charis/Occlusion.h"
+#include "Charis/Utility.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    const char* LitVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+out vec3 normal;
+uniform mat4 model;
+uniform mat4 viewProjection;
+void main()
+{
+    gl_Position = viewProjection * model * vec4(inVertex, 1.0);
+    normal = mat3(model) * inNormal;
+}
+)";
+
+    const char* LitFragmentShader = R"(
+#version 330 core
+in vec3 normal;
+out vec4 fragColor;
+uniform vec3 color;
+void main()
+{
+    float light = 0.3 + 0.7 * max(dot(normalize(normal), normalize(vec3(1.0, 1.0, 1.0))), 0.0);
+    fragColor = vec4(color * light, 1.0);
+}
+)";
+
+    // Every uniform is used, so none of them is optimized away
+    const char* ChurnVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+out vec3 normal;
+uniform mat4 model;
+uniform mat4 viewProjection;
+uniform vec2 offset;
+uniform float scale;
+void main()
+{
+    gl_Position = viewProjection * model * vec4(scale * inVertex + vec3(offset, 0.0), 1.0);
+    normal = mat3(model) * inNormal;
+}
+)";
+
+    const char* ChurnFragmentShader = R"(
+#version 330 core
+in vec3 normal;
+out vec4 fragColor;
+uniform vec3 color;
+uniform vec4 tint;
+uniform vec3 lightDirection;
+uniform float time;
+void main()
+{
+    float light = 0.3 + 0.7 * max(dot(normalize(normal), normalize(lightDirection)), 0.0);
+    fragColor = vec4(color * light, 1.0) * tint + vec4(0.01 * fract(time));
+}
+)";
+
+    const char* MaterialVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inTexCoords;
+out vec3 normal;
+out vec2 texCoords;
+uniform mat4 model;
+uniform mat4 viewProjection;
+void main()
+{
+    gl_Position = viewProjection * model * vec4(inVertex, 1.0);
+    normal = mat3(model) * inNormal;
+    texCoords = inTexCoords;
+}
+)";
+
+    const char* MaterialFragmentShader = R"(
+#version 330 core
+in vec3 normal;
+in vec2 texCoords;
+out vec4 fragColor;
+uniform sampler2D DiffuseTexture_1;
+uniform sampler2D SpecularTexture_1;
+uniform sampler2D NormalTexture_1;
+uniform sampler2D HeightTexture_1;
+void main()
+{
+    vec3 bump = texture(NormalTexture_1, texCoords).rgb * 2.0 - 1.0;
+    float light = max(dot(normalize(normal + 0.2 * bump), normalize(vec3(1.0, 1.0, 1.0))), 0.0);
+    vec3 diffuse = texture(DiffuseTexture_1, texCoords).rgb * (0.3 + 0.7 * light);
+    float specular = texture(SpecularTexture_1, texCoords).r * pow(light, 16.0);
+    fragColor = vec4((diffuse + specular) * texture(HeightTexture_1, texCoords).r, 1.0);
+}
+)";
+
+    // Same camera as the frame constants, for the inline shaders that take the full transform.
+    glm::mat4 ViewProjection() {
+        const auto view = BenchView();
+        return view.Projection * view.View;
+    }
+
+    // Position of item i of count in a square grid centered on the origin.
+    glm::vec3 GridPosition(unsigned int i, unsigned int count, float spacing) {
+        const auto side = static_cast<unsigned int>(glm::ceil(glm::sqrt(static_cast<float>(count))));
+        const auto x = static_cast<float>(i % side) - 0.5f * (side - 1);
+        const auto z = static_cast<float>(i / side) - 0.5f * (side - 1);
+        return spacing * glm::vec3(x, 0.0f, -z);
+    }
+
+    // Unit cube with normals, 24 vertices and 36 indices.
+    Charis::Component CreateCube() {
+        std::vector<float> vertices;
+        std::vector<Charis::TriangleIndices> indices;
+        for (int axis = 0; axis < 3; axis++) {
+            for (float side : { -1.0f, 1.0f }) {
+                auto normal = glm::vec3(0.0f);
+                normal[axis] = side;
+                const auto u = glm::vec3(normal.y, normal.z, normal.x);
+                const auto v = glm::cross(normal, u);
+                const auto first = static_cast<unsigned int>(vertices.size() / 6);
+                for (const auto& corner : { -u - v, u - v, u + v, -u + v }) {
+                    const auto position = 0.5f * (normal + corner);
+                    vertices.insert(vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z });
+                }
+                indices.push_back({ first, first + 1, first + 2 });
+                indices.push_back({ first, first + 2, first + 3 });
+            }
+        }
+        return Charis::Component(vertices, indices, { 3, 3 });
+    }
+
+    // Unit quad in the xy plane with normals and texture coordinates.
+    Charis::Component CreateQuad() {
+        const std::vector<float> vertices = {
+            -0.5f, -0.5f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 0.0f,
+             0.5f, -0.5f, 0.0f,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f,
+             0.5f,  0.5f, 0.0f,  0.0f, 0.0f, 1.0f,  1.0f, 1.0f,
+            -0.5f,  0.5f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 1.0f
+        };
+        return Charis::Component(vertices, { { 0, 1, 2 }, { 0, 2, 3 } }, { 3, 3, 2 });
+    }
+
+    // Procedural texture that is different for every seed, generated with a small integer hash so it never depends on the platform.
+    Charis::Texture CreateTexture(unsigned int seed, Charis::Texture::TextureType type) {
+        constexpr int size = 64;
+        std::vector<unsigned char> pixels(4 * size * size);
+        std::uint32_t state = 2166136261u ^ seed;
+        for (auto& pixel : pixels) {
+            state = (state ^ (state >> 15)) * 2246822519u;
+            state ^= state >> 13;
+            pixel = static_cast<unsigned char>(state);
+        }
+        return Charis::Texture(pixels.data(), size, size, 4, type);
+    }
+
+    SceneFrame Backpacks(const BenchSettings& settings) {
+        struct Resources {
+            Charis::Model Backpack;
+            Charis::Shader Shader;
+        };
+        auto resources = std::make_shared<Resources>(Resources{
+            Charis::Model(settings.AssetDirectory + "/Models/backpack/backpack.obj"),
+            Charis::Shader(settings.AssetDirectory + "/Shaders/hello_backpack.vert", settings.AssetDirectory + "/Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1)
+        });
+        const auto model = resources->Shader.GetUniform("model");
+        const auto count = settings.Backpacks;
+        return [resources, model, count](unsigned int frame) {
+            const auto& shader = resources->Shader;
+            for (unsigned int i = 0; i < count; i++) {
+                const auto angle = 0.01f * frame + 0.5f * i;
+                const auto transform = glm::rotate(glm::translate(glm::mat4(1.0f), GridPosition(i, count, 4.0f)), angle, glm::vec3(0.0f, 1.0f, 0.0f));
+                shader.SetMat4(model, glm::scale(transform, glm::vec3(0.5f)));
+                shader.Draw(resources->Backpack);
+            }
+        };
+    }
+
+    SceneFrame SmallComponents(const BenchSettings& settings) {
+        struct Resources {
+            std::vector<Charis::Component> Cubes;
+            Charis::Shader Shader;
+        };
+        auto resources = std::make_shared<Resources>(Resources{ {}, Charis::Shader(LitVertexShader, LitFragmentShader, Charis::Shader::InCode) });
+        // Separate components, so every draw switches vertex arrays
+        for (unsigned int i = 0; i < settings.SmallComponents; i++)
+            resources->Cubes.push_back(CreateCube());
+
+        const auto& shader = resources->Shader;
+        shader.SetMat4("viewProjection", ViewProjection());
+        shader.SetVec3("color", { 0.8f, 0.5f, 0.3f });
+        const auto model = shader.GetUniform("model");
+        return [resources, model](unsigned int frame) {
+            const auto& cubes = resources->Cubes;
+            for (unsigned int i = 0; i < cubes.size(); i++) {
+                const auto transform = glm::rotate(glm::translate(glm::mat4(1.0f), GridPosition(i, static_cast<unsigned int>(cubes.size()), 0.6f)), 0.02f * frame, glm::vec3(1.0f, 1.0f, 0.0f));
+                resources->Shader.SetMat4(model, glm::scale(transform, glm::vec3(0.3f)));
+                resources->Shader.Draw(cubes[i]);
+            }
+        };
+    }
+
+    SceneFrame UniformChurn(const BenchSettings& settings) {
+        struct Resources {
+            Charis::Component Cube;
+            Charis::Shader Shader;
+        };
+        auto resources = std::make_shared<Resources>(Resources{ CreateCube(), Charis::Shader(ChurnVertexShader, ChurnFragmentShader, Charis::Shader::InCode) });
+        resources->Shader.SetMat4("viewProjection", ViewProjection());
+
+        const auto draws = settings.UniformDraws;
+        return [resources, draws](unsigned int frame) {
+            // Set by name on purpose, this is the path most user code takes
+            const auto& shader = resources->Shader;
+            for (unsigned int i = 0; i < draws; i++) {
+                const auto t = 0.001f * (frame * draws + i);
+                shader.SetMat4("model", glm::translate(glm::mat4(1.0f), GridPosition(i, draws, 0.8f)));
+                shader.SetVec2("offset", glm::cos(t), glm::sin(t));
+                shader.SetFloat("scale", 0.2f + 0.1f * glm::sin(3.0f * t));
+                shader.SetVec3("color", { glm::fract(t), 0.5f, 1.0f - glm::fract(t) });
+                shader.SetVec4("tint", { 1.0f, 0.9f, 0.8f, 1.0f });
+                shader.SetVec3("lightDirection", { glm::sin(t), 1.0f, glm::cos(t) });
+                shader.SetFloat("time", t);
+                shader.Draw(resources->Cube);
+            }
+        };
+    }
+
+    SceneFrame TexturedMaterials(const BenchSettings& settings) {
+        struct Resources {
+            std::vector<Charis::Component> Quads;
+            Charis::Shader Shader;
+        };
+        auto resources = std::make_shared<Resources>(Resources{ {}, Charis::Shader(MaterialVertexShader, MaterialFragmentShader, Charis::Shader::InCode, 1) });
+        // One quad mesh shared by all materials, each with its own four textures
+        const auto quad = CreateQuad();
+        for (unsigned int i = 0; i < settings.Materials; i++) {
+            auto material = quad;
+            for (auto type : { Charis::Texture::Diffuse, Charis::Texture::Specular, Charis::Texture::Normal, Charis::Texture::Height })
+                material.Textures.push_back(CreateTexture(4 * i + type, type));
+            resources->Quads.push_back(material);
+        }
+
+        const auto& shader = resources->Shader;
+        shader.SetMat4("viewProjection", ViewProjection());
+        const auto model = shader.GetUniform("model");
+        return [resources, model](unsigned int frame) {
+            const auto& quads = resources->Quads;
+            for (unsigned int i = 0; i < quads.size(); i++) {
+                const auto transform = glm::rotate(glm::translate(glm::mat4(1.0f), GridPosition(i, static_cast<unsigned int>(quads.size()), 1.2f)), 0.01f * frame, glm::vec3(0.0f, 1.0f, 0.0f));
+                resources->Shader.SetMat4(model, transform);
+                resources->Shader.Draw(quads[i]);
+            }
+        };
+    }
+
+
+    SceneFrame OpenField(const BenchSettings& settings) {
+        struct Resources {
+            Charis::Model Backpack;
+            Charis::Shader Shader;
+            Charis::FrustumCuller Culler;
+            std::vector<glm::mat4> Transforms;
+        };
+        auto resources = std::make_shared<Resources>(Resources{
+            .Backpack = Charis::Model(settings.AssetDirectory + "/Models/backpack/backpack.obj"),
+            .Shader = Charis::Shader(settings.AssetDirectory + "/Shaders/hello_backpack.vert", settings.AssetDirectory + "/Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1),
+            .Culler = {},
+            .Transforms = {}
+        });
+        // The field does not move, so the boxes are transformed once and every frame only tests them
+        const auto bounds = resources->Backpack.LocalBounds();
+        for (unsigned int i = 0; i < settings.FieldBackpacks; i++) {
+            const auto transform = glm::scale(glm::translate(glm::mat4(1.0f), GridPosition(i, settings.FieldBackpacks, 6.0f)), glm::vec3(0.5f));
+            resources->Transforms.push_back(transform);
+            resources->Culler.Add(bounds, transform);
+        }
+
+        const auto model = resources->Shader.GetUniform("model");
+        const auto view = BenchView();
+        const auto frustum = Charis::Frustum(view.Projection * view.View);
+        return [resources, model, frustum](unsigned int) {
+            for (auto i : resources->Culler.Cull(frustum)) {
+                resources->Shader.SetMat4(model, resources->Transforms[i]);
+                resources->Shader.Draw(resources->Backpack);
+            }
+        };
+    }
+
+    SceneFrame LodField(const BenchSettings& settings) {
+        struct Resources {
+            Charis::Model Backpack;
+            Charis::Shader Shader;
+            Charis::FrustumCuller Culler;
+            std::vector<glm::mat4> Transforms;
+            std::vector<std::vector<unsigned int>> Levels;
+        };
+        auto resources = std::make_shared<Resources>(Resources{
+            .Backpack = Charis::Model(settings.AssetDirectory + "/Models/backpack/backpack.obj", { .Lods = Charis::Model::LodSettings{} }),
+            .Shader = Charis::Shader(settings.AssetDirectory + "/Shaders/hello_backpack.vert", settings.AssetDirectory + "/Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1),
+            .Culler = {},
+            .Transforms = {},
+            .Levels = {}
+        });
+        // The same field as open_field, with the levels of every backpack kept from frame to frame
+        const auto bounds = resources->Backpack.LocalBounds();
+        for (unsigned int i = 0; i < settings.FieldBackpacks; i++) {
+            const auto transform = glm::scale(glm::translate(glm::mat4(1.0f), GridPosition(i, settings.FieldBackpacks, 6.0f)), glm::vec3(0.5f));
+            resources->Transforms.push_back(transform);
+            resources->Culler.Add(bounds, transform);
+        }
+        resources->Levels.resize(settings.FieldBackpacks);
+
+        const auto model = resources->Shader.GetUniform("model");
+        const auto view = BenchView();
+        const auto frustum = Charis::Frustum(view.Projection * view.View);
+        return [resources, model, frustum](unsigned int) {
+            for (auto i : resources->Culler.Cull(frustum)) {
+                resources->Shader.SetMat4(model, resources->Transforms[i]);
+                resources->Shader.Draw(resources->Backpack, resources->Transforms[i], resources->Levels[i]);
+            }
+        };
+    }
+
+
+    SceneFrame OccludedField(const BenchSettings& settings) {
+        struct Resources {
+            Charis::Model Backpack;
+            Charis::Shader Shader;
+            Charis::Component Wall;
+            Charis::Shader WallShader;
+            Charis::FrustumCuller Culler;
+            Charis::OcclusionCuller Occlusion;
+            std::vector<glm::mat4> Transforms;
+            std::vector<Charis::BoundingBox> Boxes;
+            std::vector<Charis::OcclusionCuller::Instance> Walls;
+        };
+        auto resources = std::make_shared<Resources>(Resources{
+            .Backpack = Charis::Model(settings.AssetDirectory + "/Models/backpack/backpack.obj"),
+            .Shader = Charis::Shader(settings.AssetDirectory + "/Shaders/hello_backpack.vert", settings.AssetDirectory + "/Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1),
+            .Wall = CreateCube(),
+            .WallShader = Charis::Shader(LitVertexShader, LitFragmentShader, Charis::Shader::InCode),
+            .Culler = {},
+            .Occlusion = {},
+            .Transforms = {},
+            .Boxes = {},
+            .Walls = {}
+        });
+        // The open field, crossed by rows of walls that hide most of the backpacks behind them
+        const auto bounds = resources->Backpack.LocalBounds();
+        for (unsigned int i = 0; i < settings.FieldBackpacks; i++) {
+            const auto transform = glm::scale(glm::translate(glm::mat4(1.0f), GridPosition(i, settings.FieldBackpacks, 6.0f)), glm::vec3(0.5f));
+            resources->Transforms.push_back(transform);
+            resources->Boxes.push_back(bounds.Transformed(transform));
+            resources->Culler.Add(bounds, transform);
+        }
+        const auto wall = resources->Occlusion.AddOccluder(Charis::BoundingBox{ glm::vec3(-0.5f), glm::vec3(0.5f) });
+        const auto fieldSize = 6.0f * glm::ceil(glm::sqrt(static_cast<float>(settings.FieldBackpacks)));
+        for (float z = 10.0f; z > -0.5f * fieldSize; z -= 24.0f)
+            resources->Walls.push_back({ wall, glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 4.0f, z)), glm::vec3(fieldSize, 8.0f, 1.0f)) });
+
+        resources->WallShader.SetMat4("viewProjection", ViewProjection());
+        resources->WallShader.SetVec3("color", { 0.6f, 0.6f, 0.6f });
+        const auto model = resources->Shader.GetUniform("model");
+        const auto view = BenchView();
+        const auto viewProjection = view.Projection * view.View;
+        const auto frustum = Charis::Frustum(viewProjection);
+        return [resources, model, frustum, viewProjection](unsigned int) {
+            for (const auto& wall : resources->Walls) {
+                resources->WallShader.SetMat4("model", wall.Transform);
+                resources->WallShader.Draw(resources->Wall);
+            }
+            // The walls would move in a real level, so the buffer is rasterized every frame
+            resources->Occlusion.Rasterize(viewProjection, resources->Walls);
+            for (auto i : resources->Occlusion.Cull(resources->Boxes, resources->Culler.Cull(frustum))) {
+                resources->Shader.SetMat4(model, resources->Transforms[i]);
+                resources->Shader.Draw(resources->Backpack);
+            }
+        };
+    }
+
+    SceneFrame MeshletBackpacks(const BenchSettings& settings) {
+        struct Resources {
+            Charis::Model Backpack;
+            Charis::Shader Shader;
+        };
+        auto resources = std::make_shared<Resources>(Resources{
+            Charis::Model(settings.AssetDirectory + "/Models/backpack/backpack.obj", { .Clustering = Charis::Model::Meshlets }),
+            Charis::Shader(settings.AssetDirectory + "/Shaders/hello_backpack.vert", settings.AssetDirectory + "/Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1)
+        });
+        const auto model = resources->Shader.GetUniform("model");
+        const auto count = settings.Backpacks;
+        // Large rotating backpacks spread past the edges of the screen, so many are only partly in view and half of every one faces away
+        return [resources, model, count](unsigned int frame) {
+            const auto& shader = resources->Shader;
+            Charis::Utility::SetBackFaceCulling(true);
+            for (unsigned int i = 0; i < count; i++) {
+                const auto angle = 0.01f * frame + 0.5f * i;
+                const auto transform = glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), GridPosition(i, count, 8.0f)), angle, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.5f));
+                shader.SetMat4(model, transform);
+                shader.DrawMeshlets(resources->Backpack, transform, true);
+            }
+            Charis::Utility::SetBackFaceCulling(false);
+        };
+    }
+
+}
+
+const std::vector<Scene>& Scenes() {
+    static const std::vector<Scene> scenes = {
+        { "backpacks", "Many copies of the backpack model, one draw per model component", Backpacks },
+        { "small_components", "Thousands of tiny components, each with its own vertex array", SmallComponents },
+        { "uniform_churn", "One cube drawn many times with seven uniforms set by name before every draw", UniformChurn },
+        { "textured_materials", "Quads with four unique textures each, so every draw binds new textures", TexturedMaterials },
+        { "open_field", "Backpacks spread far around the camera, frustum culled so only the visible ones are drawn", OpenField },
+        { "lod_field", "The open field with generated levels of detail, picked per backpack by its size on screen", LodField },
+        { "meshlet_backpacks", "Large backpacks split into meshlets, drawing only the meshlets in view and facing the camera", MeshletBackpacks },
+        { "occluded_field", "The open field behind rows of walls, with the backpacks hidden by the walls culled on the CPU", OccludedField }
+    };
+    return scenes;
+}
+
+Charis::FrameView BenchView() {
+    auto view = Charis::FrameView{};
+    view.CameraPosition = { 0.0f, 10.0f, 30.0f };
+    view.View = glm::lookAt(view.CameraPosition, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    view.Projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    return view;
+}
+
+Charis::FrameLights BenchLights() {
+    auto lights = Charis::FrameLights{};
+    lights.Directional.Direction = { 1.0f, 1.0f, 0.0f };
+    lights.Directional.Ambient = glm::vec3(0.4f);
+    lights.Directional.Diffuse = glm::vec3(0.7f);
+    lights.Directional.Specular = glm::vec3(0.7f);
+    return lights;
+}
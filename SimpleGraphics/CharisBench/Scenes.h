@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include "Charis/FrameConstants.h"
+
+// Settings shared by all scenes, see the command line options in Main.cpp.
+struct BenchSettings {
+    // Directory with the Models and Shaders folders of the TestProject.
+    std::string AssetDirectory = "../TestProject";
+    unsigned int Backpacks = 64;
+    unsigned int SmallComponents = 4096;
+    unsigned int UniformDraws = 2000;
+    unsigned int Materials = 512;
+    unsigned int FieldBackpacks = 4096;
+};
+
+// Draws one frame of a scene. Only depends on the frame index, so every run draws exactly the same frames.
+using SceneFrame = std::function<void(unsigned int frame)>;
+
+// A scripted scene. Create loads everything the scene needs and returns its frame function, which owns those resources.
+struct Scene {
+    std::string Name;
+    std::string Description;
+    std::function<SceneFrame(const BenchSettings&)> Create;
+};
+
+// All scenes, in the order they run.
+const std::vector<Scene>& Scenes();
+
+// Fixed camera looking down the negative z axis and a single directional light, set through the frame constants at the start of every frame.
+Charis::FrameView BenchView();
+Charis::FrameLights BenchLights();
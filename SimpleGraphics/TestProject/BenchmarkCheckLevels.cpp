@@ -0,0 +1,82 @@
+#include "BenchmarkCheckLevels.h"
+#include <iostream>
+#include <chrono>
+#include <functional>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Texture.h"
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace {
+
+    const char* VertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+uniform mat4 model;
+void main()
+{
+    gl_Position = model * vec4(inVertex, 1.0);
+}
+)";
+    const char* FragmentShader = R"(
+#version 330 core
+out vec4 fragColor;
+void main()
+{
+    fragColor = vec4(1.0);
+}
+)";
+
+    // Runs the function a number of times and returns the number of calls per microsecond.
+    double CallsPerMicrosecond(unsigned int calls, const std::function<void(unsigned int i)>& function) {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < calls; i++)
+            function(i);
+        const auto end = std::chrono::steady_clock::now();
+        return calls / std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    const char* LevelName(int level) {
+        return level == CHARIS_CHECK_OFF ? "off" : level == CHARIS_CHECK_CHEAP ? "cheap" : "paranoid";
+    }
+
+}
+
+// Measures SetMat4 and Texture::BindTo throughput with the checks of the current CHARIS_CHECK_LEVEL.
+// The level is fixed at build time, so build Charis and the TestProject with /D CHARIS_CHECK_LEVEL=0, 1 and 2 in turn and compare the runs.
+void BenchmarkCheckLevels() {
+    Charis::Initialize(800, 600, "Benchmark Check Levels");
+
+    const auto shader = Charis::Shader(VertexShader, FragmentShader, Charis::Shader::InCode);
+    const auto modelUniform = shader.GetUniform("model");
+    const unsigned char white[4] = { 255, 255, 255, 255 };
+    const auto texture = Charis::Texture(white, 1, 1, 4);
+
+    const unsigned int calls = 1'000'000;
+    auto matrix = glm::mat4(1.0f);
+
+    const auto mat4ByName = CallsPerMicrosecond(calls, [&](unsigned int i) {
+        matrix[3][0] = static_cast<float>(i);
+        shader.SetMat4("model", matrix);
+    });
+    const auto mat4ByHandle = CallsPerMicrosecond(calls, [&](unsigned int i) {
+        matrix[3][0] = static_cast<float>(i);
+        shader.SetMat4(modelUniform, matrix);
+    });
+    // Alternating bindings, so every call reaches the driver
+    const auto bindTo = CallsPerMicrosecond(calls, [&](unsigned int i) {
+        texture.BindTo(i & 1);
+    });
+
+    std::cout << "Throughput with CHARIS_CHECK_LEVEL " << LevelName(CHARIS_CHECK_LEVEL) << " over " << calls << " calls (calls per microsecond)\n";
+    std::cout << "  SetMat4 by name:   " << mat4ByName << "\n";
+    std::cout << "  SetMat4 by handle: " << mat4ByHandle << "\n";
+    std::cout << "  Texture::BindTo:   " << bindTo << std::endl;
+
+    Charis::CleanUp();
+}
@@ -0,0 +1,85 @@
+#include "BenchmarkDraw.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <array>
+#include <functional>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Model.h"
+#include "Charis/Texture.h"
+
+// Libraries
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+namespace {
+
+    // Runs the function a number of times inside a single frame and returns the average CPU time per call in microseconds.
+    double MicrosecondsPerCall(unsigned int calls, const std::function<void()>& function) {
+        Charis::StartFrame();
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < calls; i++)
+            function();
+        const auto end = std::chrono::steady_clock::now();
+        Charis::EndFrame();
+        return std::chrono::duration<double, std::micro>(end - start).count() / calls;
+    }
+
+    // The draw path Charis used before sampler bindings were assigned at link time: build every sampler name, bind the texture,
+    // then make the program current and ask the driver for the sampler location on every draw, as SetTexture did at the time.
+    void DrawWithNamedSamplers(const Charis::Shader& shader, unsigned int program, const Charis::Model& model) {
+        for (const auto& component : model.Components) {
+            auto textureCounter = std::array<unsigned int, Charis::Texture::Null>{};
+            int count = 0;
+            for (const auto& texture : component.Textures) {
+                auto& typeCount = textureCounter[texture.Type];
+                if (typeCount < 1) {
+                    typeCount++;
+                    const auto shaderUniformName = Charis::Texture::ShaderTextureNames[texture.Type] + std::to_string(typeCount);
+                    count++;
+                    const int textureBinding = 32 - count;
+
+                    texture.BindTo(textureBinding);
+                    glUseProgram(program);
+                    glUniform1i(glGetUniformLocation(program, shaderUniformName.c_str()), textureBinding);
+                }
+            }
+            shader.Draw(component);
+        }
+    }
+
+}
+
+// Draws the backpack model many times and compares the CPU cost per draw of named sampler lookups against link time sampler bindings.
+void BenchmarkDraw() {
+    Charis::Initialize(800, 600, "Benchmark Draw");
+
+    const auto backpackModel = Charis::Model("Models/backpack/backpack.obj");
+    // No drawable textures, so that Draw leaves all texture work to DrawWithNamedSamplers
+    const auto namedSamplerShader = Charis::Shader("Shaders/hello_backpack.vert", "Shaders/hello_backpack.frag", Charis::Shader::Filepath, 0);
+    const auto linkedSamplerShader = Charis::Shader("Shaders/hello_backpack.vert", "Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1);
+
+    for (const auto& shader : { namedSamplerShader, linkedSamplerShader }) {
+        shader.SetMat4("model", glm::translate(glm::mat4(1.0f), { 0.0f, 0.0f, -5.0f }));
+    }
+
+    // SetMat4 leaves the program of the shader current, which is the only way to learn its name from outside Charis
+    namedSamplerShader.SetMat4("model", glm::translate(glm::mat4(1.0f), { 0.0f, 0.0f, -5.0f }));
+    GLint namedSamplerProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &namedSamplerProgram);
+
+    const unsigned int draws = 10'000;
+    const auto before = MicrosecondsPerCall(draws, [&]() { DrawWithNamedSamplers(namedSamplerShader, static_cast<unsigned int>(namedSamplerProgram), backpackModel); });
+    const auto after = MicrosecondsPerCall(draws, [&]() { linkedSamplerShader.Draw(backpackModel); });
+
+    std::cout << "Backpack draw cost over " << draws << " draws (CPU us per draw)\n";
+    std::cout << "  Named sampler lookups:      " << before << "\n";
+    std::cout << "  Link time sampler bindings: " << after << std::endl;
+
+    Charis::CleanUp();
+}
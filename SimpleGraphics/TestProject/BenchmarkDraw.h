@@ -0,0 +1,3 @@
+#pragma once
+
+void BenchmarkDraw();
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "BenchmarkFrameConstants.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <functional>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Component.h"
+#include "Charis/FrameConstants.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    // Camera and light as plain uniforms, set on every shader every frame
+    const char* UniformVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+void main()
+{
+    gl_Position = projection * view * model * vec4(inVertex, 1.0);
+}
+)";
+    const char* UniformFragmentShader = R"(
+#version 330 core
+out vec4 fragColor;
+struct DirectionalLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+uniform vec3 cameraPos;
+uniform DirectionalLight dirLight;
+void main()
+{
+    vec3 light = dirLight.ambient + dirLight.diffuse * max(dirLight.direction.y, 0.0) + dirLight.specular * 0.01 * length(cameraPos);
+    fragColor = vec4(light, 1.0);
+}
+)";
+
+    // The same shading with camera and light read from the FrameConstants block, which is filled once per frame
+    const std::string BlockVertexShader = std::string("#version 330 core\n") + Charis::FrameConstants::ShaderSource + R"(
+layout (location = 0) in vec3 inVertex;
+uniform mat4 model;
+void main()
+{
+    gl_Position = viewProjection * model * vec4(inVertex, 1.0);
+}
+)";
+    const std::string BlockFragmentShader = std::string("#version 330 core\n") + Charis::FrameConstants::ShaderSource + R"(
+out vec4 fragColor;
+void main()
+{
+    vec3 light = dirLight.ambient + dirLight.diffuse * max(dirLight.direction.y, 0.0) + dirLight.specular * 0.01 * length(cameraPos);
+    fragColor = vec4(light, 1.0);
+}
+)";
+
+    // Runs the frame function for a number of frames and returns the average CPU time per frame in milliseconds, including StartFrame.
+    double MillisecondsPerFrame(unsigned int frames, const std::function<void()>& startFrame, const std::function<void()>& function) {
+        double total = 0.0;
+        for (unsigned int i = 0; i < frames; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            startFrame();
+            function();
+            const auto end = std::chrono::steady_clock::now();
+            Charis::EndFrame();
+            total += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        return total / frames;
+    }
+
+}
+
+// Draws one triangle with each of 1 to 64 shaders, once setting camera and light uniforms on every shader and once through the FrameConstants block.
+void BenchmarkFrameConstants() {
+    Charis::Initialize(800, 600, "Benchmark Frame Constants");
+
+    const float vertices[] = {
+        -0.5f, -0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+         0.0f,  0.5f, 0.0f
+    };
+    const auto triangle = Charis::Component(vertices, 9, { 3 });
+
+    auto view = Charis::FrameView{};
+    view.CameraPosition = { 0.0f, 0.0f, 3.0f };
+    view.View = glm::lookAt(view.CameraPosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    view.Projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+    auto lights = Charis::FrameLights{};
+    lights.Directional.Direction = { 1.0f, 1.0f, 0.0f };
+    lights.Directional.Ambient = glm::vec3(0.4f);
+    lights.Directional.Diffuse = glm::vec3(0.7f);
+    lights.Directional.Specular = glm::vec3(0.7f);
+    const auto& light = lights.Directional;
+
+    const unsigned int frames = 100;
+    const auto model = glm::mat4(1.0f);
+
+    std::cout << "Camera and light cost (CPU ms per frame)\n";
+    for (unsigned int count = 1; count <= 64; count *= 4) {
+        std::vector<Charis::Shader> uniformShaders;
+        std::vector<Charis::Shader> blockShaders;
+        for (unsigned int i = 0; i < count; i++) {
+            uniformShaders.emplace_back(UniformVertexShader, UniformFragmentShader, Charis::Shader::InCode);
+            blockShaders.emplace_back(BlockVertexShader, BlockFragmentShader, Charis::Shader::InCode);
+        }
+
+        const auto perShader = MillisecondsPerFrame(frames, []() { Charis::StartFrame(); }, [&]() {
+            for (const auto& shader : uniformShaders) {
+                shader.SetMat4("view", view.View);
+                shader.SetMat4("projection", view.Projection);
+                shader.SetVec3("cameraPos", view.CameraPosition);
+                shader.SetVec3("dirLight.direction", light.Direction);
+                shader.SetVec3("dirLight.ambient", light.Ambient);
+                shader.SetVec3("dirLight.diffuse", light.Diffuse);
+                shader.SetVec3("dirLight.specular", light.Specular);
+                shader.SetMat4("model", model);
+                shader.Draw(triangle);
+            }
+        });
+        const auto block = MillisecondsPerFrame(frames, [&]() { Charis::StartFrame(view, lights); }, [&]() {
+            for (const auto& shader : blockShaders) {
+                shader.SetMat4("model", model);
+                shader.Draw(triangle);
+            }
+        });
+        std::cout << "  " << count << " shaders: per shader uniforms " << perShader << ", frame constants " << block << std::endl;
+    }
+
+    Charis::CleanUp();
+}
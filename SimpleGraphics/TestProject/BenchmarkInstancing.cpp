@@ -0,0 +1,86 @@
+#include "BenchmarkInstancing.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <functional>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Model.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    // Runs the function once per frame for a number of frames and returns the average CPU time per frame in milliseconds.
+    double MillisecondsPerFrame(const Charis::FrameView& view, unsigned int frames, const std::function<void()>& function) {
+        double total = 0.0;
+        for (unsigned int i = 0; i < frames; i++) {
+            Charis::StartFrame(view);
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            const auto end = std::chrono::steady_clock::now();
+            Charis::EndFrame();
+            total += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        return total / frames;
+    }
+
+    // Places instances on a square grid in front of the camera.
+    std::vector<glm::mat4> GridTransforms(unsigned int count) {
+        std::vector<glm::mat4> transforms;
+        transforms.reserve(count);
+        const auto side = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(count))));
+        for (unsigned int i = 0; i < count; i++) {
+            const auto x = static_cast<float>(i % side) - 0.5f * side;
+            const auto y = static_cast<float>(i / side) - 0.5f * side;
+            const auto position = glm::translate(glm::mat4(1.0f), { 3.0f * x, 3.0f * y, -10.0f - side });
+            transforms.push_back(glm::scale(position, glm::vec3(0.5f)));
+        }
+        return transforms;
+    }
+
+}
+
+// Draws 1 to 1M backpacks, once with one draw per backpack and once with one instanced draw per component.
+// Runs headless like CharisBench, so the sweep also runs on machines without a display.
+void BenchmarkInstancing() {
+    Charis::Initialize(800, 600, "Benchmark Instancing", Charis::HeadlessEGL);
+
+    const auto backpackModel = Charis::Model("Models/backpack/backpack.obj");
+    const auto shader = Charis::Shader("Shaders/hello_backpack.vert", "Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1);
+    const auto instancedShader = Charis::Shader("Shaders/hello_backpack_instanced.vert", "Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1);
+    const auto view = Charis::FrameView{ glm::mat4(1.0f), glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 10000.0f) };
+    const auto modelUniform = shader.GetUniform("model");
+
+    const unsigned int frames = 10;
+    // Drawing one backpack at a time is not worth waiting for beyond this count
+    const unsigned int maxPerObjectCount = 10'000;
+
+    std::cout << "Backpack draw cost (CPU ms per frame)\n";
+    for (unsigned int count = 1; count <= 1'000'000; count *= 10) {
+        const auto transforms = GridTransforms(count);
+
+        const auto instanced = MillisecondsPerFrame(view, frames, [&]() { instancedShader.DrawInstanced(backpackModel, transforms); });
+        std::cout << "  " << count << " instances: instanced " << instanced;
+
+        if (count <= maxPerObjectCount) {
+            const auto perObject = MillisecondsPerFrame(view, frames, [&]() {
+                for (const auto& transform : transforms) {
+                    shader.SetMat4(modelUniform, transform);
+                    shader.Draw(backpackModel);
+                }
+            });
+            std::cout << ", per object " << perObject;
+        }
+        std::cout << std::endl;
+    }
+
+    Charis::CleanUp();
+}
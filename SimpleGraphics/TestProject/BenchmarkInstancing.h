@@ -0,0 +1,3 @@
+#pragma once
+
+void BenchmarkInstancing();
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "BenchmarkLod.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Model.h"
+#include "Charis/FrameConstants.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    struct FrameResult {
+        double Milliseconds{};
+        Charis::Utility::FrameStatistics Statistics{};
+    };
+
+    // Draws a row of backpacks going away from the camera, with or without levels of detail, and returns the average CPU time and the counts of the last frame.
+    FrameResult DrawRow(const Charis::Shader& shader, const Charis::Model& model, const std::vector<glm::mat4>& transforms, bool useLevels, unsigned int frames) {
+        std::vector<std::vector<unsigned int>> levels(transforms.size());
+        auto view = Charis::FrameView{};
+        view.CameraPosition = { 0.0f, 0.0f, 5.0f };
+        view.View = glm::lookAt(view.CameraPosition, glm::vec3(0.0f, 0.0f, -100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        view.Projection = glm::perspective(glm::radians(45.0f), 1280.0f / 720.0f, 0.1f, 1000.0f);
+
+        double total = 0.0;
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            const auto start = std::chrono::steady_clock::now();
+            Charis::StartFrame(view, {});
+            for (size_t i = 0; i < transforms.size(); i++) {
+                shader.SetMat4("model", transforms[i]);
+                if (useLevels)
+                    shader.Draw(model, transforms[i], levels[i]);
+                else
+                    shader.Draw(model);
+            }
+            Charis::EndFrame();
+            total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        return { total / frames, Charis::Utility::GetFrameStatistics() };
+    }
+
+}
+
+// Generates levels of detail for the backpack model, prints the triangles and error of every level, then draws a row of backpacks with and without them.
+void BenchmarkLod() {
+    Charis::Initialize(1280, 720, "Benchmark Level of Detail");
+
+    const std::string path = "Models/backpack/backpack.obj";
+    auto start = std::chrono::steady_clock::now();
+    const auto full = Charis::Model(path);
+    const auto fullLoad = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    const auto model = Charis::Model(path, { .Lods = Charis::Model::LodSettings{ 4, 0.5f, 0.05f } });
+    const auto lodLoad = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Backpack load time (ms): without levels " << fullLoad << ", with levels " << lodLoad << "\n";
+    for (size_t c = 0; c < model.Components.size(); c++) {
+        const auto& component = model.Components[c];
+        std::cout << "  Component " << c << ":";
+        for (unsigned int level = 0; level < component.LevelsOfDetail(); level++)
+            std::cout << " [" << level << "] " << component.Triangles(level) << " triangles, error " << component.LevelError(level);
+        std::cout << "\n";
+    }
+
+    const auto shader = Charis::Shader("Shaders/hello_backpack.vert", "Shaders/hello_backpack.frag", Charis::Shader::Filepath, 1);
+    std::vector<glm::mat4> transforms;
+    for (int i = 0; i < 200; i++)
+        transforms.push_back(glm::translate(glm::mat4(1.0f), glm::vec3((i % 2 == 0) ? -3.0f : 3.0f, 0.0f, -4.0f * i)));
+
+    const unsigned int frames = 100;
+    const auto without = DrawRow(shader, model, transforms, false, frames);
+    std::cout << "Row of " << transforms.size() << " backpacks (CPU ms per frame)\n";
+    std::cout << "  Full components: " << without.Milliseconds << "\n";
+    for (float pixelError : { 0.5f, 1.0f, 2.0f, 4.0f }) {
+        Charis::Utility::SetLevelOfDetailSelection(pixelError);
+        const auto with = DrawRow(shader, model, transforms, true, frames);
+        std::cout << "  Levels at " << pixelError << " pixel error: " << with.Milliseconds << ", " << with.Statistics.LodTrianglesDrawn << " triangles drawn, "
+            << with.Statistics.LodTrianglesSaved << " saved per frame" << std::endl;
+    }
+
+    Charis::CleanUp();
+}
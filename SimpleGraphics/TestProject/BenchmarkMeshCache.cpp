@@ -0,0 +1,41 @@
+#include "BenchmarkMeshCache.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <filesystem>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Model.h"
+
+namespace {
+
+    // Loads the model and returns the time it took in milliseconds, textures included.
+    double MillisecondsToLoad(const std::string& path) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto model = Charis::Model(path);
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+}
+
+// Compares loading the backpack model through assimp (cold, which also writes the mesh cache) against loading it from the mesh cache (warm).
+void BenchmarkMeshCache() {
+    Charis::Initialize(800, 600, "Benchmark Mesh Cache");
+
+    const std::string path = "Models/backpack/backpack.obj";
+    std::filesystem::remove(path + ".charismesh");
+
+    const auto cold = MillisecondsToLoad(path);
+    const unsigned int warmLoads = 5;
+    double warm = 0.0;
+    for (unsigned int i = 0; i < warmLoads; i++)
+        warm += MillisecondsToLoad(path) / warmLoads;
+
+    std::cout << "Backpack model load time (ms, textures included)\n";
+    std::cout << "  Cold, parsed by assimp:     " << cold << "\n";
+    std::cout << "  Warm, mapped from cache:    " << warm << " (average of " << warmLoads << ")" << std::endl;
+
+    Charis::CleanUp();
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void BenchmarkMeshCache();
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "BenchmarkMeshlets.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Component.h"
+#include "Charis/Meshlets.h"
+#include "Charis/FrameConstants.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    const std::string VertexShader = std::string("#version 330 core\n") + Charis::FrameConstants::ShaderSource + R"(
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+uniform mat4 model;
+out vec3 normal;
+void main()
+{
+    gl_Position = viewProjection * model * vec4(inVertex, 1.0);
+    normal = mat3(model) * inNormal;
+}
+)";
+    const std::string FragmentShader = std::string("#version 330 core\n") + Charis::FrameConstants::ShaderSource + R"(
+in vec3 normal;
+out vec4 fragColor;
+void main()
+{
+    vec3 light = dirLight.ambient + dirLight.diffuse * max(dot(normalize(normal), -dirLight.direction), 0.0);
+    fragColor = vec4(light, 1.0);
+}
+)";
+
+    // Bumpy unit sphere of 2 * rings * segments triangles, counter-clockwise from the outside, as position and normal per vertex.
+    void BumpySphere(unsigned int rings, unsigned int segments, std::vector<float>& vertices, std::vector<unsigned int>& indices) {
+        const auto pi = glm::pi<float>();
+        for (unsigned int i = 0; i <= rings; i++) {
+            for (unsigned int j = 0; j <= segments; j++) {
+                const auto theta = pi * i / rings;
+                const auto phi = 2.0f * pi * j / segments;
+                const auto normal = glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                const auto position = normal * (1.0f + 0.01f * std::sin(40.0f * theta) * std::sin(40.0f * phi));
+                vertices.insert(vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z });
+            }
+        }
+        for (unsigned int i = 0; i < rings; i++) {
+            for (unsigned int j = 0; j < segments; j++) {
+                const auto v00 = i * (segments + 1) + j;
+                const auto v01 = v00 + 1;
+                const auto v10 = v00 + segments + 1;
+                const auto v11 = v10 + 1;
+                indices.insert(indices.end(), { v00, v01, v10, v10, v01, v11 });
+            }
+        }
+    }
+
+    struct View {
+        const char* Name;
+        glm::vec3 Position;
+        glm::vec3 Target;
+    };
+
+    struct FrameResult {
+        double Milliseconds{};
+        Charis::Utility::FrameStatistics Statistics{};
+    };
+
+    // Draws the component from a view for a number of frames, whole or by meshlets, and returns the average CPU time and the counts of the last frame.
+    FrameResult DrawView(const Charis::Shader& shader, const Charis::Component& component, const View& view, bool meshlets, bool cullBackFacing, unsigned int frames) {
+        auto frameView = Charis::FrameView{};
+        frameView.CameraPosition = view.Position;
+        frameView.View = glm::lookAt(view.Position, view.Target, glm::vec3(0.0f, 1.0f, 0.0f));
+        frameView.Projection = glm::perspective(glm::radians(45.0f), 1280.0f / 720.0f, 0.01f, 100.0f);
+        auto lights = Charis::FrameLights{};
+        lights.Directional.Direction = { -0.5f, -1.0f, -0.3f };
+        lights.Directional.Ambient = glm::vec3(0.1f);
+        lights.Directional.Diffuse = glm::vec3(0.8f);
+        const auto model = glm::mat4(1.0f);
+
+        Charis::Utility::SetBackFaceCulling(cullBackFacing);
+        double total = 0.0;
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            const auto start = std::chrono::steady_clock::now();
+            Charis::StartFrame(frameView, lights);
+            shader.SetMat4("model", model);
+            if (meshlets)
+                shader.DrawMeshlets(component, model, cullBackFacing);
+            else
+                shader.Draw(component);
+            Charis::EndFrame();
+            total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        Charis::Utility::SetBackFaceCulling(false);
+        return { total / frames, Charis::Utility::GetFrameStatistics() };
+    }
+
+}
+
+// Splits a sphere of about 5 million triangles into meshlets, then draws it from a few views whole and by meshlets, with and without back facing culling.
+void BenchmarkMeshlets() {
+    Charis::Initialize(1280, 720, "Benchmark Meshlets");
+
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    BumpySphere(1584, 1584, vertices, indices);
+    const auto vertexCount = static_cast<unsigned int>(vertices.size() / 6);
+    const auto triangles = static_cast<unsigned int>(indices.size() / 3);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto meshlets = Charis::BuildMeshlets(vertices.data(), 6, vertexCount, indices);
+    const auto build = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << triangles << " triangles split into " << meshlets.size() << " meshlets, " << static_cast<double>(triangles) / meshlets.size()
+        << " triangles per meshlet, in " << build << " ms\n";
+
+    auto component = Charis::Component(vertices.data(), static_cast<unsigned int>(vertices.size()), indices.data(), static_cast<unsigned int>(indices.size()), { 3, 3 });
+    component.SetMeshlets(std::move(meshlets));
+    const auto shader = Charis::Shader(VertexShader, FragmentShader, Charis::Shader::InCode);
+
+    const View views[] = {
+        { "Whole sphere", { 0.0f, 0.0f, 4.0f }, { 0.0f, 0.0f, 0.0f } },
+        { "Close up", { 0.0f, 0.3f, 1.6f }, { 0.0f, 0.3f, 0.0f } },
+        { "Along the surface", { 0.0f, 0.0f, 1.1f }, { 1.0f, 0.0f, 1.1f } },
+    };
+    const unsigned int frames = 100;
+    std::cout << "Triangles submitted and CPU ms per frame\n";
+    for (const auto& view : views) {
+        const auto whole = DrawView(shader, component, view, false, false, frames);
+        const auto frustum = DrawView(shader, component, view, true, false, frames);
+        const auto backFacing = DrawView(shader, component, view, true, true, frames);
+        std::cout << "  " << view.Name << ": whole " << triangles << " (" << whole.Milliseconds << " ms)"
+            << ", frustum culled " << triangles - frustum.Statistics.MeshletTrianglesCulled << " (" << frustum.Milliseconds << " ms)"
+            << ", also back facing " << triangles - backFacing.Statistics.MeshletTrianglesCulled << " (" << backFacing.Milliseconds << " ms), "
+            << backFacing.Statistics.MeshletsVisible << " of " << component.Meshlets().size() << " meshlets drawn in " << backFacing.Statistics.DrawCalls << " draw calls" << std::endl;
+    }
+
+    Charis::CleanUp();
+}
@@ -0,0 +1,106 @@
+#include "BenchmarkOcclusion.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <cstdint>
+
+// Charis
+#include "Charis/Occlusion.h"
+#include "Charis/Culling.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    // A town of blocks, each a few walls with small objects between them, like the props of a city seen from the street.
+    struct Town {
+        std::vector<Charis::OcclusionCuller::Instance> Walls;
+        std::vector<Charis::BoundingBox> Objects;
+    };
+
+    Town BuildTown(unsigned int blocksPerSide, unsigned int objectsPerBlock, unsigned int wall) {
+        auto random = std::mt19937(blocksPerSide);
+        std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+        std::uniform_real_distribution<float> height(0.0f, 3.0f);
+        auto town = Town{};
+        const auto spacing = 12.0f;
+        const auto half = 0.5f * spacing * blocksPerSide;
+        for (unsigned int x = 0; x < blocksPerSide; x++) {
+            for (unsigned int z = 0; z < blocksPerSide; z++) {
+                const auto center = glm::vec3(x * spacing - half, 0.0f, -(z * spacing + 5.0f));
+                // Four walls around the block, 8 wide and 6 high
+                for (int side = 0; side < 4; side++) {
+                    const auto angle = glm::half_pi<float>() * side;
+                    auto transform = glm::translate(glm::mat4(1.0f), center);
+                    transform = glm::rotate(transform, angle, glm::vec3(0.0f, 1.0f, 0.0f));
+                    transform = glm::translate(transform, glm::vec3(0.0f, 3.0f, 4.5f));
+                    town.Walls.push_back({ wall, glm::scale(transform, glm::vec3(4.0f, 3.0f, 0.2f)) });
+                }
+                for (unsigned int i = 0; i < objectsPerBlock; i++) {
+                    const auto position = center + glm::vec3(offset(random), height(random), offset(random));
+                    town.Objects.push_back({ position - 0.5f, position + 0.5f });
+                }
+            }
+        }
+        return town;
+    }
+
+    // Hash of the bits of the depth buffer, equal for equal buffers.
+    uint64_t HashDepths(const Charis::OcclusionCuller& culler) {
+        uint64_t hash = 14695981039346656037ull;
+        for (auto depth : culler.Depths()) {
+            uint32_t bits{};
+            std::memcpy(&bits, &depth, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+}
+
+// Rasterizes the walls of a town, seen from one of its streets, into the occlusion buffer at a few sizes, and culls the objects of the town by frustum and then by occlusion.
+// Runs on the CPU only, so it needs no window, and checks that repeated runs give the same depth buffer.
+void BenchmarkOcclusion() {
+    const auto camera = glm::lookAt(glm::vec3(6.0f, 1.7f, 2.0f), glm::vec3(4.0f, 1.7f, -10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const auto viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) * camera;
+
+    const unsigned int sizes[][2] = { { 128, 64 }, { 256, 128 }, { 512, 256 } };
+    std::cout << "Occlusion culling cost (ms)\n";
+    for (const auto& size : sizes) {
+        auto culler = Charis::OcclusionCuller(size[0], size[1]);
+        const auto wall = culler.AddOccluder(Charis::BoundingBox{ glm::vec3(-1.0f), glm::vec3(1.0f) });
+        const auto town = BuildTown(30, 50, wall);
+
+        auto frustumCuller = Charis::FrustumCuller();
+        for (const auto& box : town.Objects)
+            frustumCuller.Add(box, glm::mat4(1.0f));
+        const auto inFrustum = frustumCuller.Cull(Charis::Frustum(viewProjection));
+
+        const unsigned int frames = 100;
+        double rasterize = 0.0;
+        double test = 0.0;
+        size_t visible = 0;
+        culler.Rasterize(viewProjection, town.Walls);
+        const auto hash = HashDepths(culler);
+        auto deterministic = true;
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            culler.Rasterize(viewProjection, town.Walls);
+            rasterize += culler.LastCounts().RasterizeMilliseconds;
+            deterministic = deterministic && HashDepths(culler) == hash;
+
+            const auto start = std::chrono::steady_clock::now();
+            visible = culler.Cull(town.Objects, inFrustum).size();
+            test += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::cout << "  " << size[0] << "x" << size[1] << ": rasterize " << culler.LastCounts().Triangles << " triangles " << rasterize / frames
+            << ", test " << inFrustum.size() << " boxes " << test / frames << ", " << visible << " of " << town.Objects.size() << " objects drawn ("
+            << town.Objects.size() - inFrustum.size() << " outside the frustum, " << inFrustum.size() - visible << " occluded)"
+            << (deterministic ? "" : ", DEPTH BUFFER DIFFERS BETWEEN RUNS") << std::endl;
+    }
+}
@@ -0,0 +1,134 @@
+#include "BenchmarkParallelShaders.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+
+namespace {
+
+    const char* VertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+uniform mat4 model;
+uniform mat4 viewProjection;
+out vec3 position;
+out vec3 normal;
+void main()
+{
+    position = vec3(model * vec4(inVertex, 1.0));
+    normal = mat3(model) * inNormal;
+    gl_Position = viewProjection * vec4(position, 1.0);
+}
+)";
+    const char* FragmentShader = R"(
+#version 330 core
+in vec3 position;
+in vec3 normal;
+out vec4 fragColor;
+uniform vec3 lightPositions[LIGHTS];
+uniform vec3 lightColors[LIGHTS];
+uniform vec3 cameraPosition;
+#ifdef FOG
+uniform vec3 fogColor;
+uniform float fogDensity;
+#endif
+void main()
+{
+    vec3 n = normalize(normal);
+    vec3 toCamera = normalize(cameraPosition - position);
+    vec3 color = vec3(0.05);
+    for (int i = 0; i < LIGHTS; i++) {
+        vec3 l = normalize(lightPositions[i] - position);
+        float diffuse = max(dot(n, l), 0.0);
+#ifdef SPECULAR
+        diffuse += pow(max(dot(n, normalize(l + toCamera)), 0.0), 32.0);
+#endif
+        color += diffuse * lightColors[i];
+    }
+#ifdef FOG
+    color = mix(fogColor, color, exp(-fogDensity * length(cameraPosition - position)));
+#endif
+    fragColor = vec4(color, 1.0);
+}
+)";
+
+    // 200 different variants: 1 to 50 lights, with and without specular and fog.
+    std::vector<Charis::Shader::Source> Variants() {
+        std::vector<Charis::Shader::Source> variants;
+        for (int lights = 1; lights <= 50; lights++) {
+            for (bool specular : { false, true }) {
+                for (bool fog : { false, true }) {
+                    auto source = Charis::Shader::Source{
+                        .VertexShader = VertexShader,
+                        .FragmentShader = FragmentShader,
+                        .Type = Charis::Shader::InCode,
+                        .NumberOfDrawableTextures = 0,
+                        .Defines = { "LIGHTS " + std::to_string(lights) }
+                    };
+                    if (specular)
+                        source.Defines.push_back("SPECULAR");
+                    if (fog)
+                        source.Defines.push_back("FOG");
+                    variants.push_back(source);
+                }
+            }
+        }
+        return variants;
+    }
+
+    double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+// Builds 200 shader variants with the program cache off, once by constructing them one after another within a single frame,
+// and once with CompileMany while frames keep running and IsReady is polled. The longest frame shows how long the window freezes.
+void BenchmarkParallelShaders() {
+    Charis::Initialize(800, 600, "Benchmark Parallel Shaders");
+    Charis::Utility::SetProgramCacheDirectory("");
+    const auto variants = Variants();
+
+    std::cout << "Building " << variants.size() << " shader variants (ms)\n";
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Charis::StartFrame();
+        std::vector<Charis::Shader> shaders;
+        for (const auto& source : variants)
+            shaders.push_back(Charis::Shader(source.VertexShader, source.FragmentShader, source.Type, source.NumberOfDrawableTextures, source.Defines));
+        Charis::EndFrame();
+        // everything happens within the one frame, so it is also the longest
+        const auto total = MillisecondsSince(start);
+        std::cout << "  One by one:      total " << total << ", longest frame " << total << "\n";
+    }
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto frameStart = start;
+        Charis::StartFrame();
+        const auto shaders = Charis::Shader::CompileMany(variants);
+        Charis::EndFrame();
+        auto longestFrame = MillisecondsSince(frameStart);
+        unsigned int frames = 1;
+        size_t ready = 0;
+        while (ready < shaders.size()) {
+            frameStart = std::chrono::steady_clock::now();
+            Charis::StartFrame();
+            ready = std::count_if(shaders.begin(), shaders.end(), [](const Charis::Shader& shader) { return shader.IsReady(); });
+            Charis::EndFrame();
+            longestFrame = std::max(longestFrame, MillisecondsSince(frameStart));
+            frames++;
+        }
+        std::cout << "  CompileMany:     total " << MillisecondsSince(start) << ", longest frame " << longestFrame << ", over " << frames << " frames\n";
+    }
+    std::cout << std::flush;
+
+    Charis::Utility::SetProgramCacheDirectory("CharisProgramCache");
+    Charis::CleanUp();
+}
@@ -0,0 +1,134 @@
+#include "BenchmarkProgramCache.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+
+namespace {
+
+    const char* VertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+uniform mat4 model;
+uniform mat4 viewProjection;
+out vec3 position;
+out vec3 normal;
+void main()
+{
+    position = vec3(model * vec4(inVertex, 1.0));
+    normal = mat3(model) * inNormal;
+    gl_Position = viewProjection * vec4(position, 1.0);
+}
+)";
+    // Enough branches and loops that the variants differ and the driver has some work to do
+    const char* FragmentShader = R"(
+#version 330 core
+in vec3 position;
+in vec3 normal;
+out vec4 fragColor;
+struct PointLight {
+    vec3 position;
+    vec3 color;
+    float range;
+};
+uniform PointLight lights[LIGHTS];
+uniform vec3 cameraPosition;
+#ifdef SHADOWS
+uniform sampler2D shadowMap;
+uniform mat4 lightViewProjection;
+#endif
+#ifdef FOG
+uniform vec3 fogColor;
+uniform float fogDensity;
+#endif
+void main()
+{
+    vec3 n = normalize(normal);
+    vec3 toCamera = normalize(cameraPosition - position);
+    vec3 color = vec3(0.05);
+    for (int i = 0; i < LIGHTS; i++) {
+        vec3 toLight = lights[i].position - position;
+        float distance = length(toLight);
+        vec3 l = toLight / distance;
+        float attenuation = clamp(1.0 - distance / lights[i].range, 0.0, 1.0);
+        float diffuse = max(dot(n, l), 0.0);
+        float specular = pow(max(dot(n, normalize(l + toCamera)), 0.0), 32.0);
+        color += attenuation * (diffuse + specular) * lights[i].color;
+    }
+#ifdef SHADOWS
+    vec4 shadowPosition = lightViewProjection * vec4(position, 1.0);
+    vec3 shadowCoordinates = shadowPosition.xyz / shadowPosition.w * 0.5 + 0.5;
+    float lit = 0.0;
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++)
+            lit += shadowCoordinates.z - 0.005 > texture(shadowMap, shadowCoordinates.xy + vec2(x, y) / 2048.0).r ? 0.0 : 1.0;
+    }
+    color *= lit / 9.0;
+#endif
+#ifdef FOG
+    color = mix(fogColor, color, exp(-fogDensity * length(cameraPosition - position)));
+#endif
+    fragColor = vec4(color, 1.0);
+}
+)";
+
+    // Every combination of light count, shadows and fog.
+    std::vector<std::vector<std::string>> Variants() {
+        std::vector<std::vector<std::string>> variants;
+        for (int lights : { 1, 2, 4, 8 }) {
+            for (bool shadows : { false, true }) {
+                for (bool fog : { false, true }) {
+                    auto defines = std::vector<std::string>{ "LIGHTS " + std::to_string(lights) };
+                    if (shadows)
+                        defines.push_back("SHADOWS");
+                    if (fog)
+                        defines.push_back("FOG");
+                    variants.push_back(defines);
+                }
+            }
+        }
+        return variants;
+    }
+
+    // Builds every variant, prints the build times of each and returns their total in milliseconds.
+    float BuildVariants(const char* title) {
+        std::cout << title << "\n";
+        float total = 0.0f;
+        for (const auto& defines : Variants()) {
+            const auto shader = Charis::Shader(VertexShader, FragmentShader, Charis::Shader::InCode, 0, defines);
+            const auto times = shader.GetBuildTimes();
+            std::string name;
+            for (const auto& define : defines)
+                name += define + " ";
+            std::cout << "    " << name << "compile " << times.CompileMilliseconds << ", link " << times.LinkMilliseconds
+                << ", cache " << times.CacheMilliseconds << (times.FromCache ? " (from cache)" : "") << "\n";
+            total += times.CompileMilliseconds + times.LinkMilliseconds + times.CacheMilliseconds;
+        }
+        return total;
+    }
+
+}
+
+// Builds 16 variants of a lit shader with an empty program cache (cold, which also fills the cache) and again from the filled cache (warm).
+// Drivers may keep a cache of their own, so the cold numbers are only truly cold on the first run after a driver update or with the driver cache off.
+void BenchmarkProgramCache() {
+    Charis::Initialize(800, 600, "Benchmark Program Cache");
+
+    const std::string directory = "ProgramCacheBenchmark";
+    std::filesystem::remove_all(directory);
+    Charis::Utility::SetProgramCacheDirectory(directory);
+
+    std::cout << "Shader program build time (ms)\n";
+    const auto cold = BuildVariants("  Cold, compiled and linked:");
+    const auto warm = BuildVariants("  Warm, loaded from the program cache:");
+    std::cout << "  Total cold " << cold << ", warm " << warm << std::endl;
+
+    Charis::Utility::SetProgramCacheDirectory("CharisProgramCache");
+    Charis::CleanUp();
+}
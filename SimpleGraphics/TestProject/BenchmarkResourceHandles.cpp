@@ -0,0 +1,70 @@
+#include "BenchmarkResourceHandles.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <memory>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Model.h"
+#include "Charis/Texture.h"
+
+// Stands in for a component that shares its member and textures through std::shared_ptr, as components did before the resource pools.
+struct SharedComponent {
+    std::shared_ptr<int> Member;
+    std::vector<std::shared_ptr<int>> Textures;
+};
+
+// Measures copying the components of the backpack against copying as many std::shared_ptr members,
+// and destroying the copies on another thread and at the frame boundary that deletes them.
+void BenchmarkResourceHandles() {
+    Charis::Initialize(800, 600, "Benchmark Resource Handles");
+
+    const auto backpackModel = Charis::Model("Models/backpack/backpack.obj");
+    const unsigned int copies = 10'000;
+    size_t textures = 0;
+    for (const auto& component : backpackModel.Components)
+        textures += component.Textures.size();
+
+    // Every component copy also copies its texture list
+    std::vector<std::vector<Charis::Component>> copied;
+    copied.reserve(copies);
+    const auto copyStart = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < copies; i++)
+        copied.push_back(backpackModel.Components);
+    const auto copyEnd = std::chrono::steady_clock::now();
+    const auto handlesCopied = static_cast<double>(copies) * (backpackModel.Components.size() + textures);
+
+    // Baseline: the same number of members and textures, each held by a std::shared_ptr
+    std::vector<SharedComponent> sharedComponents;
+    for (const auto& component : backpackModel.Components) {
+        auto& shared = sharedComponents.emplace_back(SharedComponent{ std::make_shared<int>(), {} });
+        for (size_t i = 0; i < component.Textures.size(); i++)
+            shared.Textures.push_back(std::make_shared<int>());
+    }
+    std::vector<std::vector<SharedComponent>> sharedCopies;
+    sharedCopies.reserve(copies);
+    const auto sharedStart = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < copies; i++)
+        sharedCopies.push_back(sharedComponents);
+    const auto sharedEnd = std::chrono::steady_clock::now();
+    sharedCopies.clear();
+
+    // Releasing on a worker only queues the deletes, the frame boundary performs them on the thread of the context
+    const auto releaseStart = std::chrono::steady_clock::now();
+    std::thread([copied = std::move(copied)]() mutable { copied.clear(); }).join();
+    const auto releaseEnd = std::chrono::steady_clock::now();
+    Charis::StartFrame();
+    const auto frameStart = std::chrono::steady_clock::now();
+    Charis::EndFrame();
+    const auto frameEnd = std::chrono::steady_clock::now();
+
+    std::cout << "Resource handles, " << copies << " copies of " << backpackModel.Components.size() << " components with " << textures << " textures\n";
+    std::cout << "  Copy:                " << std::chrono::duration<double, std::nano>(copyEnd - copyStart).count() / handlesCopied << " ns per handle\n";
+    std::cout << "  Copy shared_ptr:     " << std::chrono::duration<double, std::nano>(sharedEnd - sharedStart).count() / handlesCopied << " ns per pointer\n";
+    std::cout << "  Release on worker:   " << std::chrono::duration<double, std::milli>(releaseEnd - releaseStart).count() << " ms\n";
+    std::cout << "  EndFrame afterwards: " << std::chrono::duration<double, std::milli>(frameEnd - frameStart).count() << " ms" << std::endl;
+
+    Charis::CleanUp();
+}
@@ -0,0 +1,92 @@
+#include "BenchmarkSceneIndex.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <functional>
+
+// Charis
+#include "Charis/SceneIndex.h"
+#include "Charis/Culling.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    // Runs the function a number of times and returns the average time per run in milliseconds.
+    double MillisecondsPerRun(unsigned int runs, const std::function<void()>& function) {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < runs; i++)
+            function();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+    }
+
+    // Unit sized boxes spread over a flat world, with the same density at every count, like objects placed in a large open level.
+    std::vector<Charis::BoundingBox> ScatteredBoxes(unsigned int count, std::mt19937& random) {
+        const auto halfSize = 2.0f * glm::sqrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> ground(-halfSize, halfSize);
+        std::uniform_real_distribution<float> height(0.0f, 10.0f);
+        std::vector<Charis::BoundingBox> boxes;
+        boxes.reserve(count);
+        for (unsigned int i = 0; i < count; i++) {
+            const auto center = glm::vec3(ground(random), height(random), ground(random));
+            boxes.push_back({ center - 0.5f, center + 0.5f });
+        }
+        return boxes;
+    }
+
+}
+
+// Builds, refits and queries a scene index of 10k to 1M objects, and compares its frustum query to testing every box with FrustumCuller.
+void BenchmarkSceneIndex() {
+    const auto camera = glm::lookAt(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(1.0f, 5.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const auto frustum = Charis::Frustum(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 200.0f) * camera);
+
+    std::cout << "Scene index cost (ms)\n";
+    for (unsigned int count = 10'000; count <= 1'000'000; count *= 10) {
+        auto random = std::mt19937(count);
+        const auto boxes = ScatteredBoxes(count, random);
+
+        auto index = Charis::SceneIndex();
+        std::vector<Charis::SceneIndex::ObjectId> ids;
+        const auto insert = MillisecondsPerRun(1, [&]() {
+            for (const auto& box : boxes)
+                ids.push_back(index.Insert(box));
+        });
+        const auto build = MillisecondsPerRun(1, [&]() { index.Rebuild(); });
+
+        // A few objects moving every frame, and all of them moving at once
+        const auto moved = count / 100;
+        const auto move = MillisecondsPerRun(1, [&]() {
+            for (unsigned int i = 0; i < moved; i++) {
+                const auto& box = boxes[i];
+                index.Move(ids[i], { box.Min + 0.25f, box.Max + 0.25f });
+            }
+        });
+        const auto refit = MillisecondsPerRun(1, [&]() {
+            for (unsigned int i = 0; i < count; i++)
+                index.SetBounds(ids[i], boxes[i]);
+            index.Refit();
+        });
+
+        const unsigned int queries = 100;
+        std::vector<Charis::SceneIndex::ObjectId> found;
+        const auto frustumQuery = MillisecondsPerRun(queries, [&]() { index.QueryFrustum(frustum, found); });
+        const auto visible = found.size();
+        const auto sphereQuery = MillisecondsPerRun(queries, [&]() { index.QueryOverlap(Charis::BoundingSphere{ glm::vec3(0.0f, 5.0f, 0.0f), 20.0f }, found); });
+        std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+        const auto raycast = MillisecondsPerRun(queries, [&]() { index.Raycast(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(direction(random), -0.1f, direction(random))); });
+
+        auto culler = Charis::FrustumCuller();
+        for (const auto& box : boxes)
+            culler.Add(box, glm::mat4(1.0f));
+        const auto linearQuery = MillisecondsPerRun(queries, [&]() { culler.Cull(frustum); });
+
+        std::cout << "  " << count << " objects: insert " << insert << ", build " << build << ", move " << moved << " " << move << ", refit all " << refit << "\n";
+        std::cout << "    frustum " << frustumQuery << " (" << visible << " visible, linear culler " << linearQuery << "), sphere " << sphereQuery << ", ray " << raycast << std::endl;
+    }
+}
@@ -0,0 +1,118 @@
+#include "BenchmarkStreaming.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <span>
+#include <functional>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+#include "Charis/Component.h"
+#include "Charis/DynamicComponent.h"
+
+// Libraries
+#include <glm/glm.hpp>
+
+namespace {
+
+    const char* VertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+void main()
+{
+    gl_Position = vec4(inVertex.xy, 0.5 + 0.1 * inVertex.z, 1.0);
+}
+)";
+    const char* FragmentShader = R"(
+#version 330 core
+out vec4 fragColor;
+void main()
+{
+    fragColor = vec4(0.8, 0.5, 0.2, 1.0);
+}
+)";
+
+    // Vertices per frame, a multiple of 3 since they are drawn as separate triangles
+    const unsigned int Vertices = 999'999;
+
+    // Writes a waving sheet of small triangles, as cloth simulated on the CPU would.
+    void WriteCloth(std::span<glm::vec3> positions, float time) {
+        const auto side = static_cast<unsigned int>(std::sqrt(static_cast<double>(positions.size() / 3)));
+        const auto cell = 2.0f / side;
+        for (size_t triangle = 0; 3 * triangle + 2 < positions.size(); triangle++) {
+            const auto x = -1.0f + cell * (triangle % side);
+            const auto y = -1.0f + cell * (triangle / side);
+            const auto z = std::sin(4.0f * x + time) * std::cos(4.0f * y + time);
+            positions[3 * triangle] = { x, y, z };
+            positions[3 * triangle + 1] = { x + cell, y, z };
+            positions[3 * triangle + 2] = { x, y + cell, z };
+        }
+    }
+
+    struct FrameTimes {
+        double UpdateMilliseconds{};
+        double FrameMilliseconds{};
+        double GpuWaitMilliseconds{};
+    };
+
+    // Runs a number of frames, timing the update and draw, and the whole frame including the wait for the GPU.
+    FrameTimes MeasureFrames(unsigned int frames, const std::function<void(unsigned int frame)>& updateAndDraw) {
+        auto times = FrameTimes{};
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            const auto frameStart = std::chrono::steady_clock::now();
+            Charis::StartFrame();
+            const auto updateStart = std::chrono::steady_clock::now();
+            updateAndDraw(frame);
+            const auto updateEnd = std::chrono::steady_clock::now();
+            Charis::EndFrame();
+            const auto frameEnd = std::chrono::steady_clock::now();
+            times.UpdateMilliseconds += std::chrono::duration<double, std::milli>(updateEnd - updateStart).count() / frames;
+            times.FrameMilliseconds += std::chrono::duration<double, std::milli>(frameEnd - frameStart).count() / frames;
+            times.GpuWaitMilliseconds += Charis::Utility::GetFrameStatistics().GpuWaitMilliseconds / frames;
+        }
+        return times;
+    }
+
+    void Print(const char* name, const FrameTimes& times) {
+        std::cout << "  " << name << ": update and draw " << times.UpdateMilliseconds << ", frame " << times.FrameMilliseconds << ", GPU wait " << times.GpuWaitMilliseconds << std::endl;
+    }
+
+}
+
+// Streams 1M animated vertices every frame, through a persistently mapped DynamicComponent, through one that orphans its buffer with glBufferData, 
+// and by creating a new Component every frame as was needed before DynamicComponent.
+void BenchmarkStreaming() {
+    Charis::Initialize(800, 600, "Benchmark Streaming");
+    // Presenting right away, so the frame times are not rounded up to the refresh rate
+    Charis::SetFramePacing({});
+
+    const auto shader = Charis::Shader(VertexShader, FragmentShader, Charis::Shader::InCode);
+    const unsigned int frames = 100;
+    const auto time = [](unsigned int frame) { return 0.05f * frame; };
+
+    std::cout << "Streaming " << Vertices << " vertices per frame (ms per frame)\n";
+    for (auto method : { Charis::StreamBuffer::PersistentMapping, Charis::StreamBuffer::Orphaning }) {
+        auto cloth = Charis::DynamicComponent(std::vector<unsigned int>{ 3 }, Vertices, 0, method);
+        const auto times = MeasureFrames(frames, [&](unsigned int frame) {
+            auto update = cloth.BeginUpdate(Vertices);
+            WriteCloth(update.VerticesAs<glm::vec3>(), time(frame));
+            update.Finish();
+            shader.Draw(cloth);
+        });
+        const bool persistent = cloth.UsedMethod() == Charis::StreamBuffer::PersistentMapping;
+        Print(method == Charis::StreamBuffer::Orphaning ? "orphaning" : persistent ? "persistent mapping" : "persistent mapping (unsupported, orphaning)", times);
+    }
+
+    std::vector<glm::vec3> positions(Vertices);
+    const auto recreated = MeasureFrames(frames, [&](unsigned int frame) {
+        WriteCloth(positions, time(frame));
+        const auto cloth = Charis::Component(&positions[0].x, 3 * Vertices, { 3 });
+        shader.Draw(cloth);
+    });
+    Print("new component every frame", recreated);
+
+    Charis::CleanUp();
+}
@@ -0,0 +1,87 @@
+#include "BenchmarkUniforms.h"
+#include <iostream>
+#include <chrono>
+#include <functional>
+
+// Charis
+#include "Charis/Initialize.h"
+#include "Charis/Utility.h"
+#include "Charis/Shader.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+namespace {
+
+    // Plain uniforms only, so every setter call goes to the driver
+    const char* VertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 inVertex;
+uniform mat4 model;
+void main()
+{
+    gl_Position = model * vec4(inVertex, 1.0);
+}
+)";
+    const char* FragmentShader = R"(
+#version 330 core
+out vec4 fragColor;
+struct DirectionalLight {
+    vec3 ambient;
+};
+uniform DirectionalLight dirLight;
+void main()
+{
+    fragColor = vec4(dirLight.ambient, 1.0);
+}
+)";
+
+    // Runs the function a number of times and returns the average time per call in nanoseconds.
+    double NanosecondsPerCall(unsigned int calls, const std::function<void(unsigned int i)>& function) {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < calls; i++)
+            function(i);
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+    }
+
+}
+
+// Compares setting uniforms by name against setting them through Shader::Uniform handles.
+void BenchmarkUniforms() {
+    Charis::Initialize(800, 600, "Benchmark Uniforms");
+
+    const auto shader = Charis::Shader(VertexShader, FragmentShader, Charis::Shader::InCode);
+    const auto modelUniform = shader.GetUniform("model");
+    const auto ambientUniform = shader.GetUniform("dirLight.ambient");
+
+    const unsigned int calls = 1'000'000;
+    auto matrix = glm::mat4(1.0f);
+    auto color = glm::vec3(0.4f);
+
+    const auto mat4ByName = NanosecondsPerCall(calls, [&](unsigned int i) {
+        matrix[3][0] = static_cast<float>(i);
+        shader.SetMat4("model", matrix);
+    });
+    const auto mat4ByHandle = NanosecondsPerCall(calls, [&](unsigned int i) {
+        matrix[3][0] = static_cast<float>(i);
+        shader.SetMat4(modelUniform, matrix);
+    });
+    const auto vec3ByName = NanosecondsPerCall(calls, [&](unsigned int i) {
+        color.x = static_cast<float>(i);
+        shader.SetVec3("dirLight.ambient", color);
+    });
+    const auto vec3ByHandle = NanosecondsPerCall(calls, [&](unsigned int i) {
+        color.x = static_cast<float>(i);
+        shader.SetVec3(ambientUniform, color);
+    });
+
+    std::cout << "Uniform setter cost over " << calls << " calls (ns per call)\n";
+    std::cout << "  SetMat4 by name:   " << mat4ByName << "\n";
+    std::cout << "  SetMat4 by handle: " << mat4ByHandle << "\n";
+    std::cout << "  SetVec3 by name:   " << vec3ByName << "\n";
+    std::cout << "  SetVec3 by handle: " << vec3ByHandle << std::endl;
+
+    Charis::CleanUp();
+}
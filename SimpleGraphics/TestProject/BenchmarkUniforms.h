@@ -0,0 +1,3 @@
+#pragma once
+
+void BenchmarkUniforms();
\ No newline at end of file
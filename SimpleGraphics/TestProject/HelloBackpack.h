@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 void HelloBackpack();
\ No newline at end of file
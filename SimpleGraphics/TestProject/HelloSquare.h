@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 void HelloSquare();
\ No newline at end of file
@@ -1,13 +1,43 @@
-#include "HelloTriangle.h"
-#include "HelloSquare.h"
-#include "HelloBackpack.h"
-
-
-int main()
-{
-    // HelloTriangle();
-    // HelloSquare();
-    HelloBackpack();
-
-    return 0;
-}
+#include "HelloTriangle.h"
+#include "HelloSquare.h"
+#include "HelloBackpack.h"
+#include "BenchmarkUniforms.h"
+#include "BenchmarkDraw.h"
+#include "BenchmarkInstancing.h"
+#include "BenchmarkMeshCache.h"
+#include "BenchmarkFrameConstants.h"
+#include "BenchmarkSceneIndex.h"
+#include "BenchmarkLod.h"
+#include "BenchmarkMeshlets.h"
+#include "BenchmarkOcclusion.h"
+#include "BenchmarkProgramCache.h"
+#include "BenchmarkParallelShaders.h"
+#include "BenchmarkCheckLevels.h"
+#include "BenchmarkStreaming.h"
+#include "BenchmarkResourceHandles.h"
+#include "TestCulling.h"
+
+
+int main()
+{
+    // HelloTriangle();
+    // HelloSquare();
+    HelloBackpack();
+    // BenchmarkUniforms();
+    // BenchmarkDraw();
+    // BenchmarkInstancing();
+    // BenchmarkMeshCache();
+    // BenchmarkFrameConstants();
+    // BenchmarkSceneIndex();
+    // BenchmarkLod();
+    // BenchmarkMeshlets();
+    // BenchmarkOcclusion();
+    // BenchmarkProgramCache();
+    // BenchmarkParallelShaders();
+    // BenchmarkCheckLevels();
+    // BenchmarkStreaming();
+    // BenchmarkResourceHandles();
+    // TestCulling();
+
+    return 0;
+}
@@ -1,25 +1,51 @@
-#version 450 core
-
-// Input
-layout (location = 0) in vec3 inVertex;
-layout (location = 1) in vec3 inNormal;
-layout (location = 2) in vec2 inTexCoords;
-layout (location = 3) in vec3 inTangent;
-layout (location = 4) in vec3 inBitangent;
-// Output
-layout (location = 0) out vec3 outWorldVertex;
-layout (location = 1) out vec3 outWorldNormal;
-layout (location = 2) out vec2 outTexCoords;
-
-// Uniforms
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    gl_Position = projection * view * model * vec4(inVertex.x, inVertex.y, inVertex.z, 1.0);
-    outWorldVertex = vec3(model * vec4(inVertex, 1.0));
-    outWorldNormal = mat3(transpose(inverse(model))) * inNormal;
-    outTexCoords = inTexCoords;
+#version 450 core
+
+// Input
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inTexCoords;
+layout (location = 3) in vec3 inTangent;
+layout (location = 4) in vec3 inBitangent;
+// Output
+layout (location = 0) out vec3 outWorldVertex;
+layout (location = 1) out vec3 outWorldNormal;
+layout (location = 2) out vec2 outTexCoords;
+
+// Uniforms
+uniform mat4 model;
+
+// Uniforms - per frame, filled by Charis::StartFrame, see Charis::FrameConstants::ShaderSource
+struct DirectionalLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+struct PointLight {
+    vec3 position;
+    float constant;
+    vec3 ambient;
+    float linear;
+    vec3 diffuse;
+    float quadratic;
+    vec3 specular;
+};
+layout (std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 cameraPos;
+    float time;
+    vec2 viewport;
+    int pointLightCount;
+    DirectionalLight dirLight;
+    PointLight pointLights[16];
+};
+
+void main()
+{
+    gl_Position = viewProjection * model * vec4(inVertex.x, inVertex.y, inVertex.z, 1.0);
+    outWorldVertex = vec3(model * vec4(inVertex, 1.0));
+    outWorldNormal = mat3(transpose(inverse(model))) * inNormal;
+    outTexCoords = inTexCoords;
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#version 450 core
+
+// Input, see Charis::Model::CompactFileAttributes
+layout (location = 0) in vec4 inVertex;
+layout (location = 1) in vec2 inNormal;
+layout (location = 2) in vec2 inTexCoords;
+layout (location = 3) in vec2 inTangent;
+// Output
+layout (location = 0) out vec3 outWorldVertex;
+layout (location = 1) out vec3 outWorldNormal;
+layout (location = 2) out vec2 outTexCoords;
+
+// Uniforms
+uniform mat4 model;
+uniform mat4 PositionDequantization;
+
+// Uniforms - per frame, filled by Charis::StartFrame, see Charis::FrameConstants::ShaderSource
+struct DirectionalLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+struct PointLight {
+    vec3 position;
+    float constant;
+    vec3 ambient;
+    float linear;
+    vec3 diffuse;
+    float quadratic;
+    vec3 specular;
+};
+layout (std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 cameraPos;
+    float time;
+    vec2 viewport;
+    int pointLightCount;
+    DirectionalLight dirLight;
+    PointLight pointLights[16];
+};
+
+vec3 OctahedralDecode(vec2 encoded)
+{
+    vec3 v = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = max(-v.z, 0.0);
+    v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+    return normalize(v);
+}
+
+void main()
+{
+    vec4 position = PositionDequantization * vec4(inVertex.xyz, 1.0);
+    vec3 normal = OctahedralDecode(inNormal);
+    vec3 tangent = OctahedralDecode(inTangent);
+    vec3 bitangent = cross(normal, tangent) * inVertex.w;
+
+    gl_Position = viewProjection * model * position;
+    outWorldVertex = vec3(model * position);
+    outWorldNormal = mat3(transpose(inverse(model))) * normal;
+    outTexCoords = inTexCoords;
+}
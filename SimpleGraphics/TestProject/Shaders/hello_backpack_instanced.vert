@@ -0,0 +1,52 @@
+#version 450 core
+
+// Input - per vertex
+layout (location = 0) in vec3 inVertex;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inTexCoords;
+layout (location = 3) in vec3 inTangent;
+layout (location = 4) in vec3 inBitangent;
+// Input - per instance
+layout (location = 5) in mat4 inModel;
+layout (location = 9) in mat3 inNormalMatrix;
+// Output
+layout (location = 0) out vec3 outWorldVertex;
+layout (location = 1) out vec3 outWorldNormal;
+layout (location = 2) out vec2 outTexCoords;
+
+// Uniforms - per frame, filled by Charis::StartFrame, see Charis::FrameConstants::ShaderSource
+struct DirectionalLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+struct PointLight {
+    vec3 position;
+    float constant;
+    vec3 ambient;
+    float linear;
+    vec3 diffuse;
+    float quadratic;
+    vec3 specular;
+};
+layout (std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 cameraPos;
+    float time;
+    vec2 viewport;
+    int pointLightCount;
+    DirectionalLight dirLight;
+    PointLight pointLights[16];
+};
+
+void main()
+{
+    vec4 worldVertex = inModel * vec4(inVertex, 1.0);
+    gl_Position = viewProjection * worldVertex;
+    outWorldVertex = vec3(worldVertex);
+    outWorldNormal = inNormalMatrix * inNormal;
+    outTexCoords = inTexCoords;
+}
\ No newline at end of file
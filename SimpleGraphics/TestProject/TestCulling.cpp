@@ -0,0 +1,61 @@
+#include "TestCulling.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// Charis
+#include "Charis/Culling.h"
+
+// Libraries
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace {
+
+    // Culls the boxes with a FrustumCuller and checks it keeps exactly the boxes Frustum::Intersects keeps, whichever lanes they land in.
+    bool CullerMatchesFrustum(const Charis::Frustum& frustum, const std::vector<Charis::BoundingBox>& boxes) {
+        auto culler = Charis::FrustumCuller();
+        for (const auto& box : boxes)
+            culler.Add(box, glm::mat4(1.0f));
+        const auto& visible = culler.Cull(frustum);
+
+        for (unsigned int i = 0; i < boxes.size(); i++) {
+            const bool culled = std::find(visible.begin(), visible.end(), i) == visible.end();
+            if (culled == frustum.Intersects(boxes[i])) {
+                std::cout << "  box " << i << " of " << boxes.size() << (culled ? " was culled but is inside the frustum\n" : " was kept but is outside the frustum\n");
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+// Checks FrustumCuller against Frustum::Intersects, with empty boxes in the SIMD lanes and in the scalar tail, which must never be visible.
+void TestCulling() {
+    const auto camera = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const auto frustum = Charis::Frustum(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f) * camera);
+
+    auto random = std::mt19937(14);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+    bool passed = true;
+    // 1 to 19 boxes covers a tail of every length for 4 and 8 lanes, and boxes before it in the SIMD loop
+    for (unsigned int count = 1; count < 20; count++) {
+        for (unsigned int empty = 0; empty < count; empty++) {
+            std::vector<Charis::BoundingBox> boxes;
+            for (unsigned int i = 0; i < count; i++) {
+                const auto center = glm::vec3(position(random), position(random), position(random));
+                boxes.push_back({ center - size(random), center + size(random) });
+            }
+            // An empty box at the origin, which is inside the frustum were it a point
+            boxes[empty] = Charis::BoundingBox{};
+            passed = passed && CullerMatchesFrustum(frustum, boxes);
+        }
+    }
+
+    std::cout << "Frustum culling: " << (passed ? "passed" : "FAILED") << std::endl;
+}